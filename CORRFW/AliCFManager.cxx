@@ -34,7 +34,12 @@ AliCFManager::AliCFManager() :
   fEvtContainer(0x0),
   fPartContainer(0x0),
   fEvtCutList(0x0),
-  fPartCutList(0x0)
+  fPartCutList(0x0),
+  fSelStep(),
+  fSelCuts(),
+  fSelList(),
+  fSelNEntries(),
+  fSelActive()
 { 
   //
   // ctor
@@ -48,7 +53,12 @@ AliCFManager::AliCFManager(const Char_t* name, const Char_t* title) :
   fEvtContainer(0x0),
   fPartContainer(0x0),
   fEvtCutList(0x0),
-  fPartCutList(0x0)
+  fPartCutList(0x0),
+  fSelStep(),
+  fSelCuts(),
+  fSelList(),
+  fSelNEntries(),
+  fSelActive()
 { 
    //
    // ctor
@@ -62,7 +72,12 @@ AliCFManager::AliCFManager(const AliCFManager& c) :
   fEvtContainer(c.fEvtContainer),
   fPartContainer(c.fPartContainer),
   fEvtCutList(c.fEvtCutList),
-  fPartCutList(c.fPartCutList)
+  fPartCutList(c.fPartCutList),
+  fSelStep(),
+  fSelCuts(),
+  fSelList(),
+  fSelNEntries(),
+  fSelActive()
 { 
    //
    //copy ctor
@@ -84,6 +99,7 @@ AliCFManager& AliCFManager::operator=(const AliCFManager& c)
   this->fPartContainer=c.fPartContainer;
   this->fEvtCutList=c.fEvtCutList;
   this->fPartCutList=c.fPartCutList;
+  ClearCompiledSelections();
   return *this ;
 }
 
@@ -105,12 +121,9 @@ Bool_t AliCFManager::CheckParticleCuts(Int_t isel, TObject *obj, const TString
     return kTRUE;
   }
   if(!fPartCutList[isel])return kTRUE;
-  TObjArrayIter iter(fPartCutList[isel]);
-  AliCFCutBase *cut = 0;
-  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
-    if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
+  const std::vector<AliCFCutBase*> &cuts = GetActiveCuts(isel,fPartCutList[isel],selcuts);
+  for (UInt_t icut=0; icut<cuts.size(); icut++) {
+    if(!cuts[icut]->IsSelected(obj)) return kFALSE;   
   }
   return kTRUE;
 }
@@ -126,12 +139,9 @@ Bool_t AliCFManager::CheckEventCuts(Int_t isel, TObject *obj, const TString  &se
       return kTRUE;
   }
   if(!fEvtCutList[isel])return kTRUE;
-  TObjArrayIter iter(fEvtCutList[isel]);
-  AliCFCutBase *cut = 0;
-  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
-    TString cutName=cut->GetName();
-    Bool_t checkCut=CompareStrings(cutName,selcuts);
-    if(checkCut && !cut->IsSelected(obj)) return kFALSE;   
+  const std::vector<AliCFCutBase*> &cuts = GetActiveCuts(-1-isel,fEvtCutList[isel],selcuts);
+  for (UInt_t icut=0; icut<cuts.size(); icut++) {
+    if(!cuts[icut]->IsSelected(obj)) return kFALSE;   
   }
   return kTRUE;
 }
@@ -221,6 +231,50 @@ Bool_t AliCFManager::CompareStrings(const TString  &cutname,const TString  &selc
   return kFALSE;
 }
 
+//_____________________________________________________________________________
+const std::vector<AliCFCutBase*>& AliCFManager::GetActiveCuts(Int_t step, const TObjArray* list, const TString &selcuts) const {
+  //
+  // returns the cuts of list which are selected by selcuts (see CompareStrings),
+  // the selection is resolved once per step and selection string and
+  // compiled again only if the cut list is replaced or its size changes
+  //
+
+  UInt_t isel = 0;
+  while (isel<fSelStep.size() && (fSelStep[isel]!=step || fSelCuts[isel]!=selcuts)) isel++;
+  if (isel<fSelStep.size() && fSelList[isel]==list && fSelNEntries[isel]==list->GetEntriesFast()) return fSelActive[isel];
+
+  if (isel==fSelStep.size()) {
+    fSelStep.push_back(step);
+    fSelCuts.push_back(selcuts);
+    fSelList.push_back(list);
+    fSelNEntries.push_back(0);
+    fSelActive.push_back(std::vector<AliCFCutBase*>());
+  }
+  fSelList[isel] = list;
+  fSelNEntries[isel] = list->GetEntriesFast();
+  std::vector<AliCFCutBase*> &cuts = fSelActive[isel];
+  cuts.clear();
+  TObjArrayIter iter(list);
+  AliCFCutBase *cut = 0;
+  while ( (cut = (AliCFCutBase*)iter.Next()) ) {
+    if (CompareStrings(cut->GetName(),selcuts)) cuts.push_back(cut);
+  }
+  return cuts;
+}
+
+//_____________________________________________________________________________
+void AliCFManager::ClearCompiledSelections() const {
+  //
+  // forget the compiled cut selections, e.g. when a cut list is set
+  //
+
+  fSelStep.clear();
+  fSelCuts.clear();
+  fSelList.clear();
+  fSelNEntries.clear();
+  fSelActive.clear();
+}
+
 
 //_____________________________________________________________________________
 void AliCFManager::SetEventCutsList(Int_t isel, TObjArray* array) {
@@ -243,6 +297,7 @@ void AliCFManager::SetEventCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fEvtCutList[isel] = array;
+  ClearCompiledSelections();
 }
 
 //_____________________________________________________________________________
@@ -267,4 +322,5 @@ void AliCFManager::SetParticleCutsList(Int_t isel, TObjArray* array) {
     return;
   }
   fPartCutList[isel] = array;
+  ClearCompiledSelections();
 }
@@ -24,10 +24,13 @@
 // now the number of steps are fixed by the particle/event containers themselves.
 //
 
+#include <vector>
 #include "TNamed.h"
 #include "AliCFContainer.h"
 #include "AliLog.h"
 
+class AliCFCutBase;
+
 //____________________________________________________________________________
 class AliCFManager : public TNamed 
 {
@@ -130,9 +133,19 @@ class AliCFManager : public TNamed
   //Particle-level selections
   TObjArray **fPartCutList ; //[fNStepPart] arrays of cuts for each particle-selection level
 
+  //Cut selections compiled on first use: the cuts of the list of a given
+  //selection step which are active for a given selection string
+  mutable std::vector<Int_t>                        fSelStep;     //! selection step (isel for particle, -1-isel for event cuts)
+  mutable std::vector<TString>                      fSelCuts;     //! selection string
+  mutable std::vector<const TObjArray*>             fSelList;     //! cut list the selection was compiled from
+  mutable std::vector<Int_t>                        fSelNEntries; //! number of entries of the cut list when compiled
+  mutable std::vector<std::vector<AliCFCutBase*> >  fSelActive;   //! active cuts, in the order of the list
+
   Bool_t CompareStrings(const TString  &cutname,const TString  &selcuts) const;
+  const std::vector<AliCFCutBase*>& GetActiveCuts(Int_t step, const TObjArray* list, const TString &selcuts) const;
+  void ClearCompiledSelections() const;
 
-  ClassDef(AliCFManager,2);
+  ClassDef(AliCFManager,3);
 };
 
 
@@ -57,6 +57,12 @@
 // found in AliCFUnfolding::CalculateCorrelatedErrors()                //
 // Author: marta.verweij@cern.ch                                       //
 //                                                                     //
+// The randomized unfoldings of the error calculation each use their   //
+// own random generator, seeded with (random seed + iteration). When   //
+// the bayes iterations run on dense arrays (see UnfoldDense) they are //
+// distributed over several threads (::SetNThreads), the result does   //
+// not depend on the number of threads.                                //
+//                                                                     //
 // An optional possibility is to smooth the unfolded spectrum at the   //
 // end of each iteration, either using a fit function                  //
 // (only if #dimensions <=3)                                           //
@@ -84,6 +90,7 @@
 //---------------------------------------------------------------------//
 
 
+#include <thread>
 #include "AliCFUnfolding.h"
 #include "TMath.h"
 #include "TAxis.h"
@@ -92,12 +99,48 @@
 #include "TH2D.h"
 #include "TH3D.h"
 #include "TRandom3.h"
+#include "TROOT.h"
+#include "THnSparse.h"
 
 
 ClassImp(AliCFUnfolding)
 
 //______________________________________________________________
 
+// Arrays of the bayes iterations on dense arrays (see AliCFUnfolding::UnfoldDense)
+struct AliCFUnfoldingDense {
+  std::vector<Double_t> conditional;       // bins of the conditional matrix
+  std::vector<Double_t> inverse;           // bins of the inverse response matrix
+  std::vector<Bool_t>   inverseSet;        // bins of the inverse response matrix set in the iterations
+  std::vector<Double_t> efficiency;        // efficiency, by true cell
+  std::vector<Double_t> measured;          // measured spectrum, by measured cell
+  std::vector<Double_t> prior;             // prior, by true cell
+  std::vector<Long64_t> priorOrder;        // true cells of the filled bins of the prior
+  std::vector<Double_t> priorTimesEff;     // prior times efficiency, by true cell
+  std::vector<Double_t> estMeasured;       // measured estimate, by measured cell
+  std::vector<Bool_t>   estMeasuredFilled; // filled cells of the measured estimate
+  std::vector<Long64_t> estMeasuredOrder;  // filled cells of the measured estimate, in the order of the THnSparse bins
+  std::vector<Double_t> unfolded;          // unfolded spectrum, by true cell
+  std::vector<Bool_t>   unfoldedFilled;    // filled cells of the unfolded spectrum
+  std::vector<Long64_t> unfoldedOrder;     // filled cells of the unfolded spectrum, in the order of the THnSparse bins
+  Bool_t                priorUpdated;      // prior updated in the iterations
+};
+
+// Original spectra randomized in the error calculation (see AliCFUnfolding::CreateRandomizedDist)
+struct AliCFUnfoldingRandomDist {
+  std::vector<Double_t> responseValue;     // bin contents of the original response matrix
+  std::vector<Double_t> responseError;     // bin errors of the original response matrix
+  std::vector<Double_t> efficiencyValue;   // bin contents of the original efficiency
+  std::vector<Double_t> efficiencyError;   // bin errors of the original efficiency
+  std::vector<Long64_t> efficiencyCell;    // true cells of the bins of the original efficiency
+  std::vector<Double_t> measuredValue;     // bin contents of the original measured spectrum
+  std::vector<Double_t> measuredError;     // bin errors of the original measured spectrum
+  std::vector<Long64_t> measuredCell;      // measured cells of the bins of the original measured spectrum
+  std::vector<Long64_t> unfoldedFinalCell; // true cells of the bins of the final unfolded spectrum
+};
+
+//______________________________________________________________
+
 AliCFUnfolding::AliCFUnfolding() :
   TNamed(),
   fResponseOrig(0x0),
@@ -130,7 +173,14 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fUseDenseKernel(kTRUE),
+  fNThreads(1),
+  fDenseStatus(0),
+  fDenseNM(0),
+  fDenseNT(0),
+  fDenseM(),
+  fDenseT()
 {
   //
   // default constructor
@@ -174,7 +224,14 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fUseDenseKernel(kTRUE),
+  fNThreads(1),
+  fDenseStatus(0),
+  fDenseNM(0),
+  fDenseNT(0),
+  fDenseM(),
+  fDenseT()
 {
   //
   // named constructor
@@ -353,7 +410,8 @@ void AliCFUnfolding::Unfold() {
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
-  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+  if (fUseDenseKernel && !fUseSmoothing && InitDenseKernel()) UnfoldDense(iIterBayes,convergence);
+  else for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
 
     CreateEstMeasured(); // create measured estimate from prior
     CreateInvResponse(); // create inverse response  from prior
@@ -443,6 +501,294 @@ void AliCFUnfolding::CreateUnfolded() {
 
 //______________________________________________________________
 
+Bool_t AliCFUnfolding::InitDenseKernel() {
+  //
+  // Checks if the bayes iterations can be done on dense arrays in the measured and true spaces
+  // (same binning of all spectra, not too many cells, same bins in the conditional and 
+  // inverse response matrices) and creates the cell index tables of the conditional matrix.
+  // The check is done only once, the binning doesn't change during the error calculation.
+  //
+
+  if (fDenseStatus != 0) return fDenseStatus > 0;
+  fDenseStatus = -1;
+
+  fDenseNM = 1;
+  fDenseNT = 1;
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    Int_t nM = fConditional->GetAxis(iVar)->GetNbins();
+    Int_t nT = fConditional->GetAxis(iVar+fNVariables)->GetNbins();
+    if (fMeasured        ->GetAxis(iVar)->GetNbins() != nM || 
+	fMeasuredEstimate->GetAxis(iVar)->GetNbins() != nM ||
+	fEfficiency      ->GetAxis(iVar)->GetNbins() != nT ||
+	fPrior           ->GetAxis(iVar)->GetNbins() != nT ||
+	fUnfolded        ->GetAxis(iVar)->GetNbins() != nT ) {
+      AliInfo("Spectra with different binning, the dense kernel is not used");
+      return kFALSE;
+    }
+    fDenseNM *= nM+2;
+    fDenseNT *= nT+2;
+    if (fDenseNM > fgkMaxDenseCells || fDenseNT > fgkMaxDenseCells) {
+      AliInfo("Too many bins, the dense kernel is not used");
+      return kFALSE;
+    }
+  }
+
+  if (fConditional->GetNbins() != fInverseResponse->GetNbins()) return kFALSE;
+  fDenseM.resize(fConditional->GetNbins());
+  fDenseT.resize(fConditional->GetNbins());
+  for (Long_t iBin=0; iBin<fConditional->GetNbins(); iBin++) {
+    fConditional->GetBinContent(iBin,fCoordinates2N);
+    if (fInverseResponse->GetBin(fCoordinates2N,kFALSE) != iBin) {
+      fDenseM.clear();
+      fDenseT.clear();
+      return kFALSE;
+    }
+    GetCoordinates();
+    fDenseM[iBin] = GetDenseCell(fCoordinatesN_M,0);
+    fDenseT[iBin] = GetDenseCell(fCoordinatesN_T,fNVariables);
+  }
+
+  fDenseStatus = 1;
+  return kTRUE;
+}
+
+//______________________________________________________________
+
+Long64_t AliCFUnfolding::GetDenseCell(const Int_t* coord, Int_t offset) const {
+  //
+  // returns the cell of the bin with the N coordinates coord in measured (offset=0) 
+  // or true (offset=N) space
+  //
+
+  Long64_t cell = 0;
+  for (Int_t iVar=fNVariables-1; iVar>=0; iVar--) {
+    cell = cell * (fConditional->GetAxis(iVar+offset)->GetNbins()+2) + coord[iVar];
+  }
+  return cell;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::GetDenseCoordinates(Long64_t cell, Int_t offset, Int_t* coord) const {
+  //
+  // returns the N coordinates of a cell in measured (offset=0) or true (offset=N) space
+  //
+
+  for (Int_t iVar=0; iVar<fNVariables; iVar++) {
+    Int_t nCells = fConditional->GetAxis(iVar+offset)->GetNbins()+2;
+    coord[iVar] = cell % nCells;
+    cell /= nCells;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::FillDense(const THnSparse* hist, Int_t offset, std::vector<Double_t> &dense, std::vector<Long64_t>* order) {
+  //
+  // copies the content of hist (in measured (offset=0) or true (offset=N) space) into the dense array,
+  // the cells of the filled bins are added to order (if given) in the order of the bins of hist
+  //
+
+  Long64_t nCells = (offset==0 ? fDenseNM : fDenseNT);
+  dense.assign(nCells,0.);
+  Int_t* coord = (offset==0 ? fCoordinatesN_M : fCoordinatesN_T);
+  for (Long_t iBin=0; iBin<hist->GetNbins(); iBin++) {
+    Double_t content = hist->GetBinContent(iBin,coord);
+    Long64_t cell = GetDenseCell(coord,offset);
+    dense[cell] = content;
+    if (order) order->push_back(cell);
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldDense(Int_t &iIterBayes, Double_t &convergence) {
+  //
+  // Bayes iterations of Unfold() (without smoothing) on dense arrays in measured and true spaces.
+  // The response-related matrices are kept as lists of the (sparse) bins of the conditional matrix
+  // with the cells they correspond to in measured and true spaces.
+  // The operations are the ones of CreateEstMeasured(), CreateInvResponse(), CreateUnfolded() 
+  // and GetConvergence(), performed in the same order, so that the results are identical to 
+  // the ones obtained with the THnSparse. The THnSparse (measured estimate, inverse response, 
+  // unfolded and prior spectra) are updated at the end of the iterations.
+  //
+
+  AliCFUnfoldingDense dense;
+  InitDense(dense);
+  if (IterateDense(dense,iIterBayes,convergence)) {
+    fNRandomIterations = iIterBayes;
+    AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+  }
+
+  if (fMaxNumIterations <= 0) return;
+
+  // update the THnSparse
+  fMeasuredEstimate->Reset();
+  for (UInt_t i=0; i<dense.estMeasuredOrder.size(); i++) {
+    GetDenseCoordinates(dense.estMeasuredOrder[i],0,fCoordinatesN_M);
+    fMeasuredEstimate->AddBinContent(fCoordinatesN_M,dense.estMeasured[dense.estMeasuredOrder[i]]);
+    fMeasuredEstimate->SetBinError(fCoordinatesN_M,0.);
+  }
+
+  for (Long_t iBin=0; iBin<(Long_t)dense.inverse.size(); iBin++) {
+    if (!dense.inverseSet[iBin]) continue;
+    fInverseResponse->SetBinContent(iBin,dense.inverse[iBin]);
+    fInverseResponse->SetBinError  (iBin,0.);
+  }
+
+  fUnfolded->Reset();
+  for (UInt_t i=0; i<dense.unfoldedOrder.size(); i++) {
+    GetDenseCoordinates(dense.unfoldedOrder[i],fNVariables,fCoordinatesN_T);
+    fUnfolded->SetBinError  (fCoordinatesN_T,0.);
+    fUnfolded->AddBinContent(fCoordinatesN_T,dense.unfolded[dense.unfoldedOrder[i]]);
+  }
+
+  if (dense.priorUpdated) {
+    if (fPrior) delete fPrior ;
+    fPrior = (THnSparse*)fUnfolded->Clone() ;
+    fPrior->SetTitle("Prior");
+    fPrior->Reset();
+    for (UInt_t i=0; i<dense.priorOrder.size(); i++) {
+      GetDenseCoordinates(dense.priorOrder[i],fNVariables,fCoordinatesN_T);
+      fPrior->SetBinError  (fCoordinatesN_T,0.);
+      fPrior->AddBinContent(fCoordinatesN_T,dense.prior[dense.priorOrder[i]]);
+    }
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::InitDense(AliCFUnfoldingDense &dense) {
+  //
+  // copies the conditional and inverse response matrices and the efficiency, measured and prior
+  // spectra into dense arrays, the other arrays are created empty
+  //
+
+  const Long_t nBins = fDenseM.size();
+  dense.conditional.resize(nBins);
+  dense.inverse    .resize(nBins);
+  dense.inverseSet .assign(nBins,kFALSE);
+  for (Long_t iBin=0; iBin<nBins; iBin++) {
+    dense.conditional[iBin] = fConditional    ->GetBinContent(iBin);
+    dense.inverse    [iBin] = fInverseResponse->GetBinContent(iBin);
+  }
+
+  dense.priorOrder.clear();
+  FillDense(fEfficiency,fNVariables,dense.efficiency);
+  FillDense(fMeasured  ,0          ,dense.measured);
+  FillDense(fPrior     ,fNVariables,dense.prior,&dense.priorOrder);
+
+  // cells of the filled bins of the measured estimate and unfolded spectra, in the order they are created in the THnSparse
+  dense.priorTimesEff    .assign(fDenseNT,0.);
+  dense.estMeasured      .assign(fDenseNM,0.);
+  dense.estMeasuredFilled.assign(fDenseNM,kFALSE);
+  dense.estMeasuredOrder .clear();
+  dense.unfolded         .assign(fDenseNT,0.);
+  dense.unfoldedFilled   .assign(fDenseNT,kFALSE);
+  dense.unfoldedOrder    .clear();
+  dense.priorUpdated = kFALSE;
+}
+
+//______________________________________________________________
+
+Bool_t AliCFUnfolding::IterateDense(AliCFUnfoldingDense &dense, Int_t &iIterBayes, Double_t &convergence, Int_t* nWarnings) const {
+  //
+  // bayes iterations on the dense arrays, returns kTRUE if the convergence criterion is met
+  // (only checked before the error calculation)
+  // if nWarnings is given, nothing is printed and the prior bins <= 0 are counted in nWarnings,
+  // to be used from several threads
+  //
+
+  const Long_t nBins = fDenseM.size();
+  std::vector<Double_t> &conditional = dense.conditional, &inverse = dense.inverse, &efficiency = dense.efficiency;
+  std::vector<Double_t> &measured = dense.measured, &prior = dense.prior, &priorTimesEff = dense.priorTimesEff;
+  std::vector<Double_t> &estMeasured = dense.estMeasured, &unfolded = dense.unfolded;
+  std::vector<Long64_t> &priorOrder = dense.priorOrder, &estMeasuredOrder = dense.estMeasuredOrder, &unfoldedOrder = dense.unfoldedOrder;
+
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    // prior times efficiency, non-zero only for the bins of the prior (see THnSparse::Multiply)
+    for (UInt_t i=0; i<priorOrder.size(); i++) priorTimesEff[priorOrder[i]] = prior[priorOrder[i]] * efficiency[priorOrder[i]];
+
+    // measured estimate (CreateEstMeasured)
+    for (UInt_t i=0; i<estMeasuredOrder.size(); i++) {
+      estMeasured            [estMeasuredOrder[i]] = 0.;
+      dense.estMeasuredFilled[estMeasuredOrder[i]] = kFALSE;
+    }
+    estMeasuredOrder.clear();
+    for (Long_t iBin=0; iBin<nBins; iBin++) {
+      Double_t fill = conditional[iBin] * priorTimesEff[fDenseT[iBin]] ;
+      if (fill>0.) {
+	Long64_t cell = fDenseM[iBin];
+	if (!dense.estMeasuredFilled[cell]) {
+	  dense.estMeasuredFilled[cell] = kTRUE;
+	  estMeasuredOrder.push_back(cell);
+	}
+	estMeasured[cell] += fill;
+      }
+    }
+
+    // inverse response (CreateInvResponse)
+    for (Long_t iBin=0; iBin<nBins; iBin++) {
+      Double_t estMeasuredValue = estMeasured[fDenseM[iBin]];
+      Double_t fill = (estMeasuredValue>0. ? conditional[iBin] * priorTimesEff[fDenseT[iBin]] / estMeasuredValue : 0. ) ;
+      if (fill>0. || inverse[iBin]>0.) {
+	inverse         [iBin] = fill;
+	dense.inverseSet[iBin] = kTRUE;
+      }
+    }
+
+    // unfolded spectrum (CreateUnfolded)
+    for (UInt_t i=0; i<unfoldedOrder.size(); i++) {
+      unfolded            [unfoldedOrder[i]] = 0.;
+      dense.unfoldedFilled[unfoldedOrder[i]] = kFALSE;
+    }
+    unfoldedOrder.clear();
+    for (Long_t iBin=0; iBin<nBins; iBin++) {
+      Double_t effValue = efficiency[fDenseT[iBin]];
+      Double_t fill = (effValue>0. ? inverse[iBin] * measured[fDenseM[iBin]] / effValue : 0.) ;
+      if (fill>0.) {
+	Long64_t cell = fDenseT[iBin];
+	if (!dense.unfoldedFilled[cell]) {
+	  dense.unfoldedFilled[cell] = kTRUE;
+	  unfoldedOrder.push_back(cell);
+	}
+	unfolded[cell] += fill;
+      }
+    }
+
+    // convergence (GetConvergence)
+    convergence = 0.;
+    for (UInt_t i=0; i<priorOrder.size(); i++) {
+      Double_t priorValue   = prior[priorOrder[i]];
+      Double_t currentValue = unfolded[priorOrder[i]];
+      if (priorValue > 0.)
+	convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+      else if (nWarnings)
+	(*nWarnings)++;
+      else
+	AliWarning(Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue)); 
+    }
+    if (!nWarnings) AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (fMaxConvergence>0. && convergence<fMaxConvergence && fNCalcCorrErrors == 0) return kTRUE;
+
+    // update the prior distribution
+    for (UInt_t i=0; i<priorOrder.size(); i++) {
+      prior        [priorOrder[i]] = 0.;
+      priorTimesEff[priorOrder[i]] = 0.;
+    }
+    priorOrder = unfoldedOrder;
+    for (UInt_t i=0; i<priorOrder.size(); i++) prior[priorOrder[i]] = unfolded[priorOrder[i]];
+    dense.priorUpdated = kTRUE;
+
+  } // end bayes iteration
+
+  return kFALSE;
+}
+
+//______________________________________________________________
+
 void AliCFUnfolding::CalculateCorrelatedErrors() {
 
   // Step 1: Create randomized distribution (fRandomXXXX) of each bin of 
@@ -454,11 +800,36 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
   //         -> fDeltaUnfoldedP (TProfile with option "S")
   // Step 4: Repeat Step 1-3 several times (fNRandomIterations)
   // Step 5: The spread of fDeltaUnfoldedP for each bin is the error on the unfolded spectrum of that specific bin
+  //
+  // Each randomized unfolding i uses its own random sequence, seeded with fRandomSeed+i (or with 
+  // seeds drawn from fRandom3 if fRandomSeed=0), and starts from the same inverse response matrix, 
+  // so that it doesn't depend on the other ones. With the dense kernel all but the last randomized 
+  // unfolding are done in parallel (see UnfoldRandomDense), the last one is done here to leave the 
+  // spectra and matrices in the same state as before.
+
+  std::vector<UInt_t> seeds(fNRandomIterations>0 ? fNRandomIterations : 0);
+  for (UInt_t i=0; i<seeds.size(); i++) {
+    seeds[i] = fRandomSeed + i;
+    if (fRandomSeed == 0 || seeds[i] == 0) seeds[i] = fRandom3->Integer(kMaxUInt) + 1;
+  }
 
+  THnSparse* inverseResponse = (THnSparse*) fInverseResponse->Clone();
+
+  Int_t iFirst = 0;
+  if (fNRandomIterations > 1 && fMaxNumIterations > 0 && fUseDenseKernel && !fUseSmoothing && InitDenseKernel()) {
+    iFirst = fNRandomIterations - 1;
+    UnfoldRandomDense(seeds,iFirst);
+  }
 
   //Do fNRandomIterations = bayes iterations performed
-  for (int i=0; i<fNRandomIterations; i++) {
+  for (int i=iFirst; i<fNRandomIterations; i++) {
     
+    fRandom3->SetSeed(seeds[i]);
+
+    // reset inverse response to the one of the unfolding
+    if (fInverseResponse) delete fInverseResponse ;
+    fInverseResponse = (THnSparse*) inverseResponse->Clone();
+
     // reset prior to original one
     if (fPrior) delete fPrior ;
     fPrior = (THnSparse*) fPriorOrig->Clone();
@@ -482,6 +853,7 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
     Unfold();
     FillDeltaUnfoldedProfile();
   }
+  delete inverseResponse;
 
   // Get statistical errors for final unfolded spectrum
   // ie. spread of each pt bin in fDeltaUnfoldedP
@@ -512,8 +884,8 @@ void AliCFUnfolding::CreateRandomizedDist() {
   //
 
   for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
-    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinatesN_M); //used as mean
-    Double_t err = fResponseOrig->GetBinError(fCoordinatesN_M);        //used as sigma
+    Double_t val = fResponseOrig->GetBinContent(iBin,fCoordinates2N); //used as mean
+    Double_t err = fResponseOrig->GetBinError(fCoordinates2N);        //used as sigma
     Double_t ran = fRandom3->Gaus(val,err);
     // random        = fRandom3->PoissonD(measuredValue); //doesn't work for normalized spectra, use Gaus (assuming raw counts in bin is large >10)
     fRandomResponse->SetBinContent(iBin,ran);
@@ -535,7 +907,7 @@ void AliCFUnfolding::CreateRandomizedDist() {
 }
 
 //______________________________________________________________
-void AliCFUnfolding::FillDeltaUnfoldedProfile() {
+void AliCFUnfolding::FillDeltaUnfoldedProfile(const std::vector<Double_t>* unfolded) {
   //
   // Store difference of unfolded spectrum from measured distribution and unfolded spectrum from randomized distribution
   // The delta profile has been set to a THnSparse to handle N dimension
@@ -544,9 +916,12 @@ void AliCFUnfolding::FillDeltaUnfoldedProfile() {
   // The relation between iterations (n+1) and n is as follows :
   //  mean_{n+1} = (n*mean_n + value_{n+1}) / (n+1)
   // sigma_{n+1} = sqrt { 1/(n+1) * [ n*sigma_n^2 + (n^2+n)*(mean_{n+1}-mean_n)^2 ] }    (can this be optimized?)
+  // If given, unfolded holds the randomized unfolded spectrum for each bin of fUnfoldedFinal, 
+  // otherwise fUnfolded is used
 
   for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
-    Double_t deltaInBin   = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M) - fUnfolded->GetBinContent(fCoordinatesN_M);
+    Double_t finalInBin   = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M);
+    Double_t deltaInBin   = finalInBin - (unfolded ? (*unfolded)[iBin] : fUnfolded->GetBinContent(fCoordinatesN_M));
     Double_t entriesInBin = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_M);
     //AliDebug(2,Form("%e %e ==> delta = %e\n",fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_M),fUnfolded->GetBinContent(iBin),deltaInBin));
 
@@ -575,6 +950,103 @@ void AliCFUnfolding::FillDeltaUnfoldedProfile() {
 
 //______________________________________________________________
 
+void AliCFUnfolding::UnfoldRandomDense(const std::vector<UInt_t> &seeds, Int_t nIterations) {
+  //
+  // Does the randomized unfoldings 0 to nIterations-1 of the error calculation on dense arrays, 
+  // distributed over fNThreads threads, and fills the fDeltaUnfoldedP profile with them. 
+  // The unfoldings only use copies of the arrays, the profile is filled afterwards in the 
+  // order of the unfoldings: the result doesn't depend on the number of threads and is 
+  // identical to the one of sequential unfoldings with the same seeds.
+  //
+
+  AliCFUnfoldingDense init;
+  if (fPrior) delete fPrior ;
+  fPrior = (THnSparse*) fPriorOrig->Clone();
+  InitDense(init);
+  init.efficiency.assign(fDenseNT,0.);
+  init.measured  .assign(fDenseNM,0.);
+
+  AliCFUnfoldingRandomDist dist;
+  for (Long_t iBin=0; iBin<fResponseOrig->GetNbins(); iBin++) {
+    dist.responseValue.push_back(fResponseOrig->GetBinContent(iBin));
+    dist.responseError.push_back(fResponseOrig->GetBinError(iBin));
+  }
+  for (Long_t iBin=0; iBin<fEfficiencyOrig->GetNbins(); iBin++) {
+    dist.efficiencyValue.push_back(fEfficiencyOrig->GetBinContent(iBin,fCoordinatesN_T));
+    dist.efficiencyError.push_back(fEfficiencyOrig->GetBinError(iBin));
+    dist.efficiencyCell .push_back(GetDenseCell(fCoordinatesN_T,fNVariables));
+  }
+  for (Long_t iBin=0; iBin<fMeasuredOrig->GetNbins(); iBin++) {
+    dist.measuredValue.push_back(fMeasuredOrig->GetBinContent(iBin,fCoordinatesN_M));
+    dist.measuredError.push_back(fMeasuredOrig->GetBinError(iBin));
+    dist.measuredCell .push_back(GetDenseCell(fCoordinatesN_M,0));
+  }
+  for (Long_t iBin=0; iBin<fUnfoldedFinal->GetNbins(); iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    dist.unfoldedFinalCell.push_back(GetDenseCell(fCoordinatesN_T,fNVariables));
+  }
+
+  Int_t nThreads = (fNThreads > 0 ? fNThreads : (Int_t)std::thread::hardware_concurrency());
+  nThreads = TMath::Max(1,TMath::Min(nThreads,nIterations));
+  AliInfo(Form("%d randomized unfoldings in %d thread(s)",nIterations,nThreads));
+
+  std::vector<std::vector<Double_t> > unfolded(nIterations);
+  std::vector<Int_t> nWarnings(nIterations,0);
+  if (nThreads == 1) {
+    for (Int_t i=0; i<nIterations; i++) UnfoldRandomDense(seeds[i],init,dist,unfolded[i],nWarnings[i]);
+  }
+  else {
+    ROOT::EnableThreadSafety();
+    std::vector<std::thread> threads;
+    for (Int_t iThread=0; iThread<nThreads; iThread++) {
+      threads.push_back(std::thread([&,iThread]() {
+	    for (Int_t i=iThread; i<nIterations; i+=nThreads) UnfoldRandomDense(seeds[i],init,dist,unfolded[i],nWarnings[i]);
+	  }));
+    }
+    for (UInt_t iThread=0; iThread<threads.size(); iThread++) threads[iThread].join();
+  }
+
+  Int_t nWarningsTotal = 0;
+  for (Int_t i=0; i<nIterations; i++) {
+    FillDeltaUnfoldedProfile(&unfolded[i]);
+    nWarningsTotal += nWarnings[i];
+  }
+  if (nWarningsTotal > 0) 
+    AliWarning(Form("priorValue <= 0 found %d times in the randomized unfoldings. Adding 0 to convergence criterion.",nWarningsTotal));
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldRandomDense(UInt_t seed, const AliCFUnfoldingDense &init, const AliCFUnfoldingRandomDist &dist, 
+				       std::vector<Double_t> &unfolded, Int_t &nWarnings) const {
+  //
+  // One randomized unfolding of the error calculation: randomizes the spectra as CreateRandomizedDist() 
+  // with a random generator seeded with seed and does the bayes iterations on a copy of the dense 
+  // arrays init. Returns the unfolded spectrum for each bin of fUnfoldedFinal.
+  // Doesn't modify the object and doesn't access the THnSparse, can be called from several threads.
+  //
+
+  AliCFUnfoldingDense dense(init);
+  TRandom3 random(seed);
+
+  // the randomized response matrix is not used by the iterations (the conditional matrix is created
+  // once from the original one), the numbers are drawn to keep the random sequence of CreateRandomizedDist()
+  for (UInt_t i=0; i<dist.responseValue.size(); i++) random.Gaus(dist.responseValue[i],dist.responseError[i]);
+  for (UInt_t i=0; i<dist.efficiencyValue.size(); i++) 
+    dense.efficiency[dist.efficiencyCell[i]] = random.Gaus(dist.efficiencyValue[i],dist.efficiencyError[i]);
+  for (UInt_t i=0; i<dist.measuredValue.size(); i++) 
+    dense.measured[dist.measuredCell[i]] = random.Gaus(dist.measuredValue[i],dist.measuredError[i]);
+
+  Int_t iIterBayes = 0;
+  Double_t convergence = 0.;
+  IterateDense(dense,iIterBayes,convergence,&nWarnings);
+
+  unfolded.resize(dist.unfoldedFinalCell.size());
+  for (UInt_t i=0; i<unfolded.size(); i++) unfolded[i] = dense.unfolded[dist.unfoldedFinalCell[i]];
+}
+
+//______________________________________________________________
+
 void AliCFUnfolding::GetCoordinates() {
   //
   // assign coordinates in Measured and True spaces (dim=N) from coordinates in global space (dim=2N)
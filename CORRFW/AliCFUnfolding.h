@@ -10,12 +10,15 @@
 // Author : renaud.vernet@cern.ch                                     //
 //--------------------------------------------------------------------//
 
+#include <vector>
 #include "TNamed.h"
 #include "THnSparse.h"
 #include "AliLog.h"
 
 class TF1;
 class TRandom3;
+struct AliCFUnfoldingDense;
+struct AliCFUnfoldingRandomDist;
 
 class AliCFUnfolding : public TNamed {
 
@@ -36,6 +39,9 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void SetUseDenseKernel(Bool_t b = kTRUE) {fUseDenseKernel = b;}; // bayes iterations on dense arrays when possible (default), see UnfoldDense()
+  void SetNThreads(Int_t n = 0) {fNThreads = n;};                  // threads for the randomized unfoldings of the error calculation (default 1, 0: number of cores)
+                                                                   // more than one thread calls ROOT::EnableThreadSafety(), which applies to the whole process
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -112,6 +118,17 @@ class AliCFUnfolding : public TNamed {
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
 
+  /* bayes iterations on dense arrays */
+  Bool_t                 fUseDenseKernel; // Use the dense-array implementation of the bayes iterations if possible
+  Int_t                  fNThreads;       // Number of threads for the randomized unfoldings on dense arrays (default 1, 0: number of cores)
+  Int_t                  fDenseStatus;    //! 0: not yet checked, 1: dense kernel usable, -1: not usable
+  Long64_t               fDenseNM;        //! Number of cells (including under/overflow) in measured space
+  Long64_t               fDenseNT;        //! Number of cells (including under/overflow) in true space
+  std::vector<Long64_t>  fDenseM;         //! Measured cell of each bin of the conditional matrix
+  std::vector<Long64_t>  fDenseT;         //! True cell of each bin of the conditional matrix
+
+  static const Long64_t  fgkMaxDenseCells = 2000000; // Maximum number of cells in measured or true space for the dense kernel
+
 
   // functions
   void     Init();                  // initialisation of the internal settings
@@ -125,14 +142,26 @@ class AliCFUnfolding : public TNamed {
   Short_t  Smooth();                // function calling smoothing methods
   Short_t  SmoothUsingFunction();   // smoothes the unfolded spectrum using a fit function
 
+  /* bayes iterations on dense arrays */
+  Bool_t   InitDenseKernel();                                         // checks if the dense kernel can be used, creates the cell index tables
+  void     UnfoldDense(Int_t &iIterBayes, Double_t &convergence);     // bayes iterations of Unfold() on dense arrays
+  Long64_t GetDenseCell(const Int_t* coord, Int_t offset) const;      // cell of a bin in measured (offset=0) or true (offset=N) space
+  void     GetDenseCoordinates(Long64_t cell, Int_t offset, Int_t* coord) const; // inverse of GetDenseCell
+  void     FillDense(const THnSparse* hist, Int_t offset, std::vector<Double_t> &dense, std::vector<Long64_t>* order=0x0); // copies a histogram into a dense array
+  void     InitDense(AliCFUnfoldingDense &dense);                     // copies the spectra and matrices into dense arrays
+  Bool_t   IterateDense(AliCFUnfoldingDense &dense, Int_t &iIterBayes, Double_t &convergence, Int_t* nWarnings=0x0) const; // bayes iterations on dense arrays, kTRUE if converged
+
   /* correlated error calculation */
   Double_t GetConvergence();            // Returns convergence criterion
   void     CalculateCorrelatedErrors(); // Calculates correlated errors for the final unfolded spectrum
   void     CreateRandomizedDist();      // Create randomized dist from measured distribution
-  void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
+  void     FillDeltaUnfoldedProfile(const std::vector<Double_t>* unfolded=0x0); // Fills the fDeltaUnfoldedP profile
+  void     UnfoldRandomDense(const std::vector<UInt_t> &seeds, Int_t nIterations); // randomized unfoldings on dense arrays, in parallel
+  void     UnfoldRandomDense(UInt_t seed, const AliCFUnfoldingDense &init, const AliCFUnfoldingRandomDist &dist, 
+			     std::vector<Double_t> &unfolded, Int_t &nWarnings) const; // one randomized unfolding, thread-safe
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  ClassDef(AliCFUnfolding,3);
 };
 
 #endif
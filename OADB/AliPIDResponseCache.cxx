@@ -0,0 +1,160 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Per-event cache of the PID n-sigma values, shared by all tasks
+//-------------------------------------------------------------------------
+
+#include <TMath.h>
+
+#include "AliAnalysisManager.h"
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVEventHandler.h"
+#include "AliVTrack.h"
+#include "AliPIDResponseCache.h"
+
+AliPIDResponseCache* AliPIDResponseCache::fgInstance = 0;
+
+//______________________________________________________________________________
+AliPIDResponseCache::AliPIDResponseCache() :
+  fEnabled(kFALSE),
+  fEntry(-1),
+  fEvent(0),
+  fNTracks(-1),
+  fStamp(1),
+  fSlotStamp(),
+  fSlotTrack(),
+  fSlotP(),
+  fSlotPID(),
+  fSlotValid(),
+  fSlotNSigma(),
+  fNHits(0),
+  fNMisses(0),
+  fNUncached(0)
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+AliPIDResponseCache* AliPIDResponseCache::Instance()
+{
+  // returns the instance shared by all tasks
+
+  if (!fgInstance) fgInstance = new AliPIDResponseCache;
+  return fgInstance;
+}
+
+//______________________________________________________________________________
+Float_t AliPIDResponseCache::NumberOfSigmas(const AliPIDResponse* pid, AliPIDResponse::EDetector detector, const AliVParticle* track, AliPID::EParticleType type)
+{
+  // returns pid->NumberOfSigmas(detector, track, type), computed once per track and event
+
+  Int_t idet = -1;
+  if (detector == AliPIDResponse::kITS) idet = 0;
+  else if (detector == AliPIDResponse::kTPC) idet = 1;
+  else if (detector == AliPIDResponse::kTOF) idet = 2;
+
+  const AliVTrack* vtrack = fEnabled ? dynamic_cast<const AliVTrack*>(track) : 0;
+  if (!vtrack || idet < 0 || type < 0 || type >= kNSpecies || !CheckEvent()) {
+    fNUncached++;
+    return pid->NumberOfSigmas(detector, track, type);
+  }
+
+  const Int_t slot = Slot(vtrack);
+  const Double_t p = track->P();
+  if (fSlotStamp[slot] != fStamp || fSlotTrack[slot] != track || fSlotP[slot] != p || fSlotPID[slot] != pid) {
+    fSlotStamp[slot] = fStamp;
+    fSlotTrack[slot] = track;
+    fSlotP[slot] = p;
+    fSlotPID[slot] = pid;
+    fSlotValid[slot] = 0;
+  }
+
+  const Int_t ivalue = kNSpecies * idet + type;
+  Float_t& nsigma = fSlotNSigma[slot * kNDetectors * kNSpecies + ivalue];
+  if (fSlotValid[slot] & (1ULL << ivalue)) {
+    fNHits++;
+    return nsigma;
+  }
+  fNMisses++;
+  nsigma = pid->NumberOfSigmas(detector, track, type);
+  fSlotValid[slot] |= 1ULL << ivalue;
+  return nsigma;
+}
+
+//______________________________________________________________________________
+void AliPIDResponseCache::NewEvent()
+{
+  // forgets all values
+
+  fStamp++;
+  if (fStamp == 0) {
+    // wrapped around: the slots of 2^32 events ago would look valid
+    fSlotStamp.assign(fSlotStamp.size(), 0);
+    fStamp = 1;
+  }
+}
+
+//______________________________________________________________________________
+Bool_t AliPIDResponseCache::CheckEvent()
+{
+  // clears the cache if the event changed, returns kFALSE if the event is not known
+
+  AliAnalysisManager* mgr = AliAnalysisManager::GetAnalysisManager();
+  AliVEventHandler* handler = mgr ? mgr->GetInputEventHandler() : 0;
+  const AliVEvent* event = handler ? handler->GetEvent() : 0;
+  if (!event) return kFALSE;
+
+  const Long64_t entry = mgr->GetCurrentEntry();
+  const Int_t ntracks = event->GetNumberOfTracks();
+  if (entry != fEntry || event != fEvent || ntracks != fNTracks) {
+    fEntry = entry;
+    fEvent = event;
+    fNTracks = ntracks;
+    NewEvent();
+  }
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+Int_t AliPIDResponseCache::Slot(const AliVTrack* track)
+{
+  // returns the slot of the track ID (even for positive, odd for negative IDs)
+
+  const Int_t id = track->GetID();
+  const Int_t slot = (id >= 0 ? 2 * id : -2 * id - 1);
+  if (slot >= (Int_t)fSlotStamp.size()) {
+    const Int_t size = TMath::Max(slot + 1, 2 * (Int_t)fSlotStamp.size());
+    fSlotStamp.resize(size, 0);
+    fSlotTrack.resize(size, 0);
+    fSlotP.resize(size, 0.);
+    fSlotPID.resize(size, 0);
+    fSlotValid.resize(size, 0);
+    fSlotNSigma.resize(size * kNDetectors * kNSpecies, 0.);
+  }
+  return slot;
+}
+
+//______________________________________________________________________________
+void AliPIDResponseCache::Print() const
+{
+  // prints the counters
+
+  const Long64_t nCached = fNHits + fNMisses;
+  AliInfo(Form("n-sigma values: %lld from the cache, %lld computed and stored, %lld not cached; %.1f%% hits",
+               fNHits, fNMisses, fNUncached, (nCached ? 100. * fNHits / nCached : 0.)));
+}
@@ -0,0 +1,99 @@
+#ifndef ALIPIDRESPONSECACHE_H
+#define ALIPIDRESPONSECACHE_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Per-event cache of the PID n-sigma values, shared by all tasks
+//-------------------------------------------------------------------------
+
+#include <vector>
+#include <Rtypes.h>
+
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+
+class AliVEvent;
+class AliVParticle;
+class AliVTrack;
+
+/**
+ * @class AliPIDResponseCache
+ * @brief ITS, TPC and TOF n-sigma values computed once per track and event
+ *
+ * The PID helpers of the different wagons of a train ask the PID response for
+ * the same n-sigma values of the same tracks. Asking the cache instead computes
+ * each value once per track, species, detector and event:
+ * ~~~{.cxx}
+ * AliPIDResponseCache *cache = AliPIDResponseCache::Instance();
+ * Float_t nsigma = cache->NumberOfSigmasTPC(fPIDResponse, track, AliPID::kKaon);
+ * ~~~
+ * The values are identical to AliPIDResponse::NumberOfSigmas. They are stored
+ * by track ID and only reused for the same track object, with the same
+ * momentum, asked with the same PID response object; any other track with the
+ * same ID (e.g. a TPC-only copy) replaces them. The cache is cleared when the
+ * entry of the analysis manager or the input event changes; outside of the
+ * analysis manager it is not used.
+ *
+ * The cache is disabled by default: the PID response can be changed within
+ * the event (e.g. the TOF start time with AliPIDResponse::SetTOFResponse), which
+ * the cache cannot detect. Tasks which change the PID response of the input
+ * handler call NewEvent() afterwards; a train whose wagons all do so enables it:
+ * ~~~{.cxx}
+ * AliPIDResponseCache::Instance()->SetEnabled();
+ * ~~~
+ * The numbers of hits and misses are counted, Print() shows them.
+ */
+class AliPIDResponseCache {
+ public:
+  static AliPIDResponseCache* Instance();
+  virtual ~AliPIDResponseCache() {}
+  virtual const char* ClassName() const { return "AliPIDResponseCache"; }
+
+  Float_t      NumberOfSigmas(const AliPIDResponse* pid, AliPIDResponse::EDetector detector, const AliVParticle* track, AliPID::EParticleType type);
+  Float_t      NumberOfSigmasITS(const AliPIDResponse* pid, const AliVParticle* track, AliPID::EParticleType type) { return NumberOfSigmas(pid, AliPIDResponse::kITS, track, type); }
+  Float_t      NumberOfSigmasTPC(const AliPIDResponse* pid, const AliVParticle* track, AliPID::EParticleType type) { return NumberOfSigmas(pid, AliPIDResponse::kTPC, track, type); }
+  Float_t      NumberOfSigmasTOF(const AliPIDResponse* pid, const AliVParticle* track, AliPID::EParticleType type) { return NumberOfSigmas(pid, AliPIDResponse::kTOF, track, type); }
+
+  void         NewEvent();
+  void         SetEnabled(Bool_t enabled = kTRUE) { fEnabled = enabled; NewEvent(); }
+  Bool_t       IsEnabled()                    const { return fEnabled; }
+
+  Long64_t     GetNHits()                     const { return fNHits; }
+  Long64_t     GetNMisses()                   const { return fNMisses; }
+  Long64_t     GetNUncached()                 const { return fNUncached; }
+  void         ResetCounters()                      { fNHits = fNMisses = fNUncached = 0; }
+  void         Print() const;
+
+  static const Int_t kNDetectors = 3;                 ///< Cached detectors: ITS, TPC, TOF
+  static const Int_t kNSpecies   = AliPID::kSPECIESC; ///< Cached species
+
+ protected:
+  AliPIDResponseCache();
+
+  Bool_t       CheckEvent();
+  Int_t        Slot(const AliVTrack* track);
+
+  Bool_t                             fEnabled;     ///< Use the cache
+  Long64_t                           fEntry;       //!<! Entry of the analysis manager of the cached values
+  const AliVEvent                   *fEvent;       //!<! Input event of the cached values
+  Int_t                              fNTracks;     //!<! Number of tracks of the input event
+  UInt_t                             fStamp;       //!<! Current event, slots of other events are empty
+  std::vector<UInt_t>                fSlotStamp;   //!<! Event of the values of each slot
+  std::vector<const AliVParticle*>   fSlotTrack;   //!<! Track of each slot
+  std::vector<Double_t>              fSlotP;       //!<! Momentum of the track of each slot
+  std::vector<const AliPIDResponse*> fSlotPID;     //!<! PID response of each slot
+  std::vector<ULong64_t>             fSlotValid;   //!<! Computed values of each slot (bit kNSpecies*detector+species)
+  std::vector<Float_t>               fSlotNSigma;  //!<! Values, kNDetectors*kNSpecies per slot
+  Long64_t                           fNHits;       //!<! Values taken from the cache
+  Long64_t                           fNMisses;     //!<! Values computed and stored
+  Long64_t                           fNUncached;   //!<! Values computed and not stored (other detectors, no tracks, no analysis manager, disabled)
+
+  static AliPIDResponseCache        *fgInstance;   ///< Singleton object
+
+ private:
+  AliPIDResponseCache(const AliPIDResponseCache&);
+  AliPIDResponseCache& operator=(const AliPIDResponseCache&);
+};
+
+#endif
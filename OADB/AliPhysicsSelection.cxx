@@ -98,6 +98,7 @@
 #include "AliOADBPhysicsSelection.h"
 #include "AliOADBFillingScheme.h"
 #include "AliOADBTriggerAnalysis.h"
+#include "AliTriggerClassMap.h"
 #include "AliInputEventHandler.h"
 #include "AliAnalysisManager.h"
 #include "AliCDBManager.h"
@@ -128,7 +129,11 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
-fCashedTokens(NULL)
+fCashedTokens(NULL),
+fCompiledTriggers(),
+fCompiledTriggerClauses(),
+fCompiledTriggerReturnCode(),
+fCompiledTriggerLogic()
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -158,7 +163,11 @@ fCashedTokens(NULL)
  fFillOADB(0),
  fTriggerOADB(0),
  fRegexp(new TPRegexp("([[:alpha:]]\\w*)")),
- fCashedTokens(NULL)
+ fCashedTokens(NULL),
+ fCompiledTriggers(),
+ fCompiledTriggerClauses(),
+ fCompiledTriggerReturnCode(),
+ fCompiledTriggerLogic()
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -177,23 +186,22 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   delete fCashedTokens;
 }
 
-UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
-  // checks if the given trigger class(es) are found for the current event
-  // format of trigger: +TRIGGER1,TRIGGER1b,TRIGGER1c -TRIGGER2 [#XXX] [&YY] [*ZZ]
-  //   requires one out of TRIGGER1,TRIGGER1b,TRIGGER1c and rejects TRIGGER2
-  //   in bunch crossing XXX
-  //   if successful, YY is returned (for association between entry in fCollTrigClasses and AliVEvent::EOfflineTriggerTypes)
-  //   triggerLogic is filled with ZZ, defaults to 0
+Int_t AliPhysicsSelection::CompileTriggerClass(const char* trigger) const {
+  // compiles the trigger class definition (see CheckTriggerClass), returns its index in fCompiledTriggers
+  // the requirements are stored as a sequence of
+  //   kRequire/kReject, number of classes n, n pattern indices of AliTriggerClassMap
+  //   kBC, bunch crossing number
   
-  TString classes = event->GetFiredTriggerClasses();
+  enum { kRequire = 0, kReject = 1, kBC = 2 };
   
-  Bool_t foundBCRequirement = kFALSE;
-  Bool_t foundCorrectBC = kFALSE;
+  for (UInt_t i=0; i < fCompiledTriggers.size(); i++)
+    if (fCompiledTriggers[i] == trigger)
+      return i;
   
+  AliTriggerClassMap* classMap = AliTriggerClassMap::Instance();
+  std::vector<Int_t> clauses;
   UInt_t returnCode = AliVEvent::kUserDefined;
-  triggerLogic = 0;
-  
-  AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", event->GetFiredTriggerClasses().Data()));
+  Int_t triggerLogic = 0;
   
   TString str(trigger);
   TObjArray* tokens = str.Tokenize(" ");
@@ -201,36 +209,61 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
   for (Int_t i=0; i < tokens->GetEntries(); i++) {
     TString str2(((TObjString*) tokens->At(i))->String());
     if (str2[0] == '+' || str2[0] == '-') {
-      Bool_t flag = (str2[0] == '+');
+      clauses.push_back((str2[0] == '+') ? kRequire : kReject);
       str2.Remove(0, 1);
       TObjArray* tokens2 = str2.Tokenize(",");
-      Bool_t foundTriggerClass = kFALSE;
-      for (Int_t j=0; j < tokens2->GetEntries(); j++) {
-        TString str3(((TObjString*) tokens2->At(j))->String());
-        if (flag && classes.Contains(str3)) foundTriggerClass = kTRUE;
-        if (!flag && classes.Contains(str3)) {
-          AliDebug(AliLog::kDebug+1, Form("Rejecting event because trigger class %s is present", str3.Data()));
-          delete tokens2;
-          delete tokens;
-          return kFALSE;
-        }
-      }
-      
+      clauses.push_back(tokens2->GetEntries());
+      for (Int_t j=0; j < tokens2->GetEntries(); j++)
+        clauses.push_back(classMap->CompilePattern(((TObjString*) tokens2->At(j))->String()));
       delete tokens2;
-      
-      if (flag && !foundTriggerClass) {
-        AliDebug(AliLog::kDebug+1, Form("Rejecting event because (none of the) trigger class(es) %s is present", str2.Data()));
-        delete tokens;
-        return kFALSE;
-      }
     }
-    else if (str2[0] == '#')
-    {
-      foundBCRequirement = kTRUE;
-      
+    else if (str2[0] == '#') {
       str2.Remove(0, 1);
+      clauses.push_back(kBC);
+      clauses.push_back(str2.Atoi());
+    }
+    else if (str2[0] == '&') { str2.Remove(0, 1); returnCode = str2.Atoll();  }
+    else if (str2[0] == '*') { str2.Remove(0, 1); triggerLogic = str2.Atoi(); }
+    else AliFatal(Form("Invalid trigger syntax: %s", trigger));
+  }
+  
+  delete tokens;
+  
+  fCompiledTriggers.push_back(trigger);
+  fCompiledTriggerClauses.push_back(clauses);
+  fCompiledTriggerReturnCode.push_back(returnCode);
+  fCompiledTriggerLogic.push_back(triggerLogic);
+  return fCompiledTriggers.size() - 1;
+}
+
+UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
+  // checks if the given trigger class(es) are found for the current event
+  // format of trigger: +TRIGGER1,TRIGGER1b,TRIGGER1c -TRIGGER2 [#XXX] [&YY] [*ZZ]
+  //   requires one out of TRIGGER1,TRIGGER1b,TRIGGER1c and rejects TRIGGER2
+  //   in bunch crossing XXX
+  //   if successful, YY is returned (for association between entry in fCollTrigClasses and AliVEvent::EOfflineTriggerTypes)
+  //   triggerLogic is filled with ZZ, defaults to 0
+  // the definition is compiled once, the fired classes are tested with AliTriggerClassMap
+  
+  enum { kRequire = 0, kReject = 1, kBC = 2 };
+  
+  const Int_t index = CompileTriggerClass(trigger);
+  const std::vector<Int_t>& clauses = fCompiledTriggerClauses[index];
+  
+  AliTriggerClassMap* classMap = AliTriggerClassMap::Instance();
+  classMap->Update(event);
+  
+  Bool_t foundBCRequirement = kFALSE;
+  Bool_t foundCorrectBC = kFALSE;
+  
+  triggerLogic = fCompiledTriggerLogic[index];
+  
+  UInt_t i = 0;
+  while (i < clauses.size()) {
+    if (clauses[i] == kBC) {
+      foundBCRequirement = kTRUE;
       
-      Int_t bcNumber = str2.Atoi();
+      Int_t bcNumber = clauses[i+1];
       AliDebug(AliLog::kDebug+1, Form("Checking for bunch crossing number %d", bcNumber));
       
       if (event->GetBunchCrossNumber() == bcNumber)
@@ -238,17 +271,33 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
         foundCorrectBC = kTRUE;
         AliDebug(AliLog::kDebug+1, Form("Found correct bunch crossing %d", bcNumber));
       }
+      i += 2;
+      continue;
     }
-    else if (str2[0] == '&') { str2.Remove(0, 1); returnCode = str2.Atoll();  }
-    else if (str2[0] == '*') { str2.Remove(0, 1); triggerLogic = str2.Atoi(); }
-    else AliFatal(Form("Invalid trigger syntax: %s", trigger));
+    
+    Bool_t flag = (clauses[i] == kRequire);
+    Int_t nClasses = clauses[i+1];
+    Bool_t foundTriggerClass = kFALSE;
+    for (Int_t j=0; j < nClasses; j++) {
+      if (classMap->IsFired(clauses[i+2+j])) {
+        foundTriggerClass = kTRUE;
+        break;
+      }
+    }
+    if (!flag && foundTriggerClass) {
+      AliDebug(AliLog::kDebug+1, Form("Rejecting event because a trigger class of %s is present", trigger));
+      return kFALSE;
+    }
+    if (flag && !foundTriggerClass) {
+      AliDebug(AliLog::kDebug+1, Form("Rejecting event because none of the required trigger classes of %s is present", trigger));
+      return kFALSE;
+    }
+    i += 2 + nClasses;
   }
   
-  delete tokens;
-  
   if (foundBCRequirement && !foundCorrectBC) return kFALSE;
   
-  return returnCode;
+  return fCompiledTriggerReturnCode[index];
 }
 
 //______________________________________________________________________________
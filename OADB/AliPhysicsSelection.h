@@ -16,6 +16,7 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 
+#include <vector>
 #include <AliAnalysisCuts.h>
 #include <TList.h>
 #include "TObjString.h"
@@ -87,6 +88,7 @@ public:
   Bool_t IsMC() const { return fMC; }
 protected:
   UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
+  Int_t CompileTriggerClass(const char* trigger) const;
   Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
   const char * GetTriggerString(TObjString * obj);
 
@@ -111,7 +113,12 @@ protected:
   TPRegexp* fRegexp;        //! regular expression for trigger tokens
   TList* fCashedTokens;     //! trigger token lookup list
 
-  ClassDef(AliPhysicsSelection, 22)
+  mutable std::vector<TString> fCompiledTriggers;                   //! trigger class definitions compiled by CompileTriggerClass
+  mutable std::vector<std::vector<Int_t> > fCompiledTriggerClauses; //! compiled requirements (see CompileTriggerClass)
+  mutable std::vector<UInt_t> fCompiledTriggerReturnCode;           //! return code of the compiled trigger class definitions
+  mutable std::vector<Int_t> fCompiledTriggerLogic;                 //! trigger logic of the compiled trigger class definitions
+
+  ClassDef(AliPhysicsSelection, 23)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
@@ -0,0 +1,215 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//-------------------------------------------------------------------------
+//     Run-level map of trigger class names to indices, providing the
+//     fired trigger classes of an event as bitmask
+//-------------------------------------------------------------------------
+
+#include <TObjArray.h>
+#include <TObjString.h>
+
+#include "AliAODHeader.h"
+#include "AliESDHeader.h"
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliTriggerClassMap.h"
+
+ClassImp(AliTriggerClassMap)
+
+AliTriggerClassMap* AliTriggerClassMap::fgInstance = 0;
+
+//______________________________________________________________________________
+AliTriggerClassMap::AliTriggerClassMap() :
+  fRunNumber(-1),
+  fClassNames(),
+  fPatterns(),
+  fPatternBits(),
+  fFiredBits(),
+  fFiredOrder(),
+  fDecoded(),
+  fUnmaskedFired(),
+  fUnmaskedIndex(-1),
+  fCurrent(-1)
+{
+  // constructor
+}
+
+//______________________________________________________________________________
+AliTriggerClassMap* AliTriggerClassMap::Instance()
+{
+  // returns the instance shared by all tasks
+
+  if (!fgInstance) fgInstance = new AliTriggerClassMap;
+  return fgInstance;
+}
+
+//______________________________________________________________________________
+Int_t AliTriggerClassMap::CompilePattern(const char* pattern)
+{
+  // returns the index of the pattern, to be used in IsFired()
+
+  for (UInt_t i = 0; i < fPatterns.size(); i++) {
+    if (fPatterns[i] == pattern) return i;
+  }
+
+  TString str(pattern);
+  if (str.First(' ') >= 0) AliWarning(Form("Pattern '%s' contains a space, it is matched to single trigger classes only", pattern));
+
+  fPatterns.push_back(str);
+  fPatternBits.push_back(0);
+  fPatternBits.push_back(0);
+  const Int_t ipattern = fPatterns.size() - 1;
+  for (UInt_t iclass = 0; iclass < fClassNames.size(); iclass++) {
+    if (fClassNames[iclass].Contains(str)) fPatternBits[2 * ipattern + iclass / 64] |= 1ULL << (iclass % 64);
+  }
+  return ipattern;
+}
+
+//______________________________________________________________________________
+void AliTriggerClassMap::Reset(Int_t run)
+{
+  // forgets the trigger classes of the previous run, the patterns are kept
+
+  fRunNumber = run;
+  fClassNames.clear();
+  fPatternBits.assign(2 * fPatterns.size(), 0);
+  ClearDecoded();
+}
+
+//______________________________________________________________________________
+void AliTriggerClassMap::ClearDecoded()
+{
+  // forgets the decoded trigger masks, the trigger classes are kept
+
+  fFiredBits.clear();
+  fFiredOrder.clear();
+  fDecoded.clear();
+  fUnmaskedFired = "";
+  fUnmaskedIndex = -1;
+  fCurrent = -1;
+}
+
+//______________________________________________________________________________
+Int_t AliTriggerClassMap::AddClass(const TString& name)
+{
+  // returns the index of the trigger class, adding it if seen for the first time in this run
+
+  for (UInt_t i = 0; i < fClassNames.size(); i++) {
+    if (fClassNames[i] == name) return i;
+  }
+  if (fClassNames.size() >= (UInt_t)kMaxClasses) {
+    AliError(Form("More than %d trigger classes in run %d, class %s ignored", kMaxClasses, fRunNumber, name.Data()));
+    return -1;
+  }
+
+  fClassNames.push_back(name);
+  const Int_t iclass = fClassNames.size() - 1;
+  for (UInt_t ipattern = 0; ipattern < fPatterns.size(); ipattern++) {
+    if (name.Contains(fPatterns[ipattern])) fPatternBits[2 * ipattern + iclass / 64] |= 1ULL << (iclass % 64);
+  }
+  return iclass;
+}
+
+//______________________________________________________________________________
+Int_t AliTriggerClassMap::Decode(const TString& fired, Int_t index)
+{
+  // decodes a fired-classes string, returns the index in fFiredBits / fFiredOrder
+  // a new entry is added if index < 0, otherwise the entry index is overwritten
+
+  if (index < 0) {
+    index = fFiredOrder.size();
+    fFiredBits.push_back(0);
+    fFiredBits.push_back(0);
+    fFiredOrder.push_back(std::vector<Int_t>());
+  }
+  else {
+    fFiredBits[2 * index] = 0;
+    fFiredBits[2 * index + 1] = 0;
+    fFiredOrder[index].clear();
+  }
+
+  TObjArray* tokens = fired.Tokenize(" ");
+  for (Int_t i = 0; i < tokens->GetEntriesFast(); i++) {
+    Int_t iclass = AddClass(static_cast<TObjString*>(tokens->At(i))->String());
+    if (iclass < 0) continue;
+    fFiredBits[2 * index + iclass / 64] |= 1ULL << (iclass % 64);
+    fFiredOrder[index].push_back(iclass);
+  }
+  delete tokens;
+
+  return index;
+}
+
+//______________________________________________________________________________
+void AliTriggerClassMap::Update(const AliVEvent* event)
+{
+  // determines the fired trigger classes of the event
+  // the fired-classes string is only decoded for trigger masks not yet seen in the run
+
+  if (!event) {
+    fCurrent = -1;
+    return;
+  }
+  if (event->GetRunNumber() != fRunNumber) Reset(event->GetRunNumber());
+
+  ULong64_t mask = event->GetTriggerMask(), maskNext50 = 0;
+  const AliESDHeader* esdHeader = dynamic_cast<const AliESDHeader*>(event->GetHeader());
+  if (esdHeader) {
+    maskNext50 = esdHeader->GetTriggerMaskNext50();
+  }
+  else {
+    const AliAODHeader* aodHeader = dynamic_cast<const AliAODHeader*>(event->GetHeader());
+    if (aodHeader) maskNext50 = aodHeader->GetTriggerMaskNext50();
+  }
+
+  if (mask == 0 && maskNext50 == 0) {
+    // no trigger mask: compare the fired classes with the previous event
+    TString fired(event->GetFiredTriggerClasses());
+    if (fUnmaskedIndex < 0 || fired != fUnmaskedFired) {
+      fUnmaskedFired = fired;
+      fUnmaskedIndex = Decode(fired, fUnmaskedIndex);
+    }
+    fCurrent = fUnmaskedIndex;
+    return;
+  }
+
+  std::pair<ULong64_t, ULong64_t> key(mask, maskNext50);
+  std::map<std::pair<ULong64_t, ULong64_t>, Int_t>::const_iterator it = fDecoded.find(key);
+  if (it != fDecoded.end()) {
+    fCurrent = it->second;
+    return;
+  }
+  if (fDecoded.size() >= (UInt_t)kMaxDecoded) {
+    AliWarning(Form("More than %d trigger masks in run %d, decoded masks cleared", kMaxDecoded, fRunNumber));
+    ClearDecoded();
+  }
+  fCurrent = Decode(event->GetFiredTriggerClasses());
+  fDecoded[key] = fCurrent;
+}
+
+//______________________________________________________________________________
+Bool_t AliTriggerClassMap::IsFired(Int_t pattern) const
+{
+  // returns true if the pattern is contained in one of the fired trigger classes of the current event
+
+  if (pattern < 0 || pattern >= (Int_t)fPatterns.size()) {
+    AliError(Form("Pattern %d not compiled", pattern));
+    return kFALSE;
+  }
+  if (fPatterns[pattern].IsNull()) return kTRUE;
+  if (fCurrent < 0) return kFALSE;
+  return (fFiredBits[2 * fCurrent] & fPatternBits[2 * pattern]) || (fFiredBits[2 * fCurrent + 1] & fPatternBits[2 * pattern + 1]);
+}
@@ -0,0 +1,98 @@
+#ifndef ALITRIGGERCLASSMAP_H
+#define ALITRIGGERCLASSMAP_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+//-------------------------------------------------------------------------
+//     Run-level map of trigger class names to indices, providing the
+//     fired trigger classes of an event as bitmask
+//-------------------------------------------------------------------------
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <Rtypes.h>
+#include <TString.h>
+
+class AliVEvent;
+
+/**
+ * @class AliTriggerClassMap
+ * @brief Fired trigger classes as bitmask, shared by all tasks of a train
+ *
+ * The trigger classes of the current run are mapped to indices, and the fired
+ * trigger classes of an event are decoded into a bitmask once per distinct
+ * trigger mask (i.e. only a few times per run) instead of tokenizing the
+ * fired-classes string in every task and every event. Tasks compile their
+ * patterns once and test them per event:
+ * ~~~{.cxx}
+ * // initialization
+ * fINT7 = AliTriggerClassMap::Instance()->CompilePattern("CINT7-B-");
+ * // per event
+ * AliTriggerClassMap *classes = AliTriggerClassMap::Instance();
+ * classes->Update(InputEvent());
+ * if (!classes->IsFired(fINT7)) return;
+ * ~~~
+ * A pattern is fired if it is contained in the name of one of the fired
+ * classes, i.e. the same as GetFiredTriggerClasses().Contains(pattern) for
+ * patterns without whitespace. The map is reset when the run changes; the
+ * compiled patterns stay valid.
+ *
+ * Events without trigger mask (e.g. MC) are decoded from the fired-classes
+ * string, which is only tokenized again if it differs from the previous one;
+ * the result is kept in a single slot which is overwritten. At most
+ * kMaxDecoded trigger masks are kept per run, the decoded masks are
+ * forgotten (not the class names) when the limit is reached.
+ */
+class AliTriggerClassMap {
+ public:
+  static AliTriggerClassMap* Instance();
+  virtual ~AliTriggerClassMap() {}
+  virtual const char* ClassName() const { return "AliTriggerClassMap"; }
+
+  Int_t        CompilePattern(const char* pattern);
+  void         Update(const AliVEvent* event);
+  Bool_t       IsFired(Int_t pattern) const;
+  Bool_t       IsFired(const AliVEvent* event, Int_t pattern) { Update(event); return IsFired(pattern); }
+
+  Int_t        GetRunNumber()                 const { return fRunNumber; }
+  Int_t        GetNClasses()                  const { return fClassNames.size(); }
+  const char*  GetTriggerClassName(Int_t i)   const { return fClassNames[i].Data(); }
+  Int_t        GetNPatterns()                 const { return fPatterns.size(); }
+  const char*  GetPattern(Int_t i)            const { return fPatterns[i].Data(); }
+  Int_t        GetNFiredClasses()             const { return fCurrent < 0 ? 0 : fFiredOrder[fCurrent].size(); }
+  Int_t        GetFiredClass(Int_t i)         const { return fFiredOrder[fCurrent][i]; }
+  const char*  GetFiredClassName(Int_t i)     const { return fClassNames[GetFiredClass(i)].Data(); }
+
+  static const Int_t kMaxClasses = 128;       ///< Maximum number of trigger classes per run (100 in the CTP)
+  static const Int_t kMaxDecoded = 1024;      ///< Maximum number of decoded trigger masks kept per run
+
+ protected:
+  AliTriggerClassMap();
+
+  void         Reset(Int_t run);
+  Int_t        AddClass(const TString& name);
+  Int_t        Decode(const TString& fired, Int_t index = -1);
+  void         ClearDecoded();
+
+  Int_t                                          fRunNumber;      //!<! Run for which the classes are mapped
+  std::vector<TString>                           fClassNames;     //!<! Trigger class names, by index
+  std::vector<TString>                           fPatterns;       //!<! Compiled patterns
+  std::vector<ULong64_t>                         fPatternBits;    //!<! Classes matching each pattern (2 words per pattern)
+  std::vector<ULong64_t>                         fFiredBits;      //!<! Fired classes for each decoded trigger mask (2 words per mask)
+  std::vector<std::vector<Int_t> >               fFiredOrder;     //!<! Fired classes for each decoded trigger mask, in order of the fired-classes string
+  std::map<std::pair<ULong64_t, ULong64_t>, Int_t> fDecoded;      //!<! Decoded trigger masks
+  TString                                        fUnmaskedFired;  //!<! Last fired-classes string of an event without trigger mask
+  Int_t                                          fUnmaskedIndex;  //!<! Decoded fired classes for fUnmaskedFired
+  Int_t                                          fCurrent;        //!<! Decoded fired classes of the current event
+
+  static AliTriggerClassMap                     *fgInstance;      ///< Singleton object
+
+ private:
+  AliTriggerClassMap(const AliTriggerClassMap&);
+  AliTriggerClassMap& operator=(const AliTriggerClassMap&);
+
+  ClassDef(AliTriggerClassMap, 1) // fired trigger classes as bitmask
+};
+
+#endif
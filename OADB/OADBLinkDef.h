@@ -20,6 +20,8 @@
 #pragma link C++ class AliPhysicsSelection+;
 #pragma link C++ class AliPhysicsSelectionTask+;
 #pragma link C++ class AliTriggerAnalysis+;
+#pragma link C++ class AliTriggerClassMap+;
+#pragma link C++ class AliPIDResponseCache+;
 #pragma link C++ class AliCollisionNormalization+;
 #pragma link C++ class AliCollisionNormalizationTask+;
 #pragma link C++ class AliEventCuts+;
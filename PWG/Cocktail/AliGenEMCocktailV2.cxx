@@ -48,6 +48,7 @@
 #include "AliGenEMlibV2.h"
 #include "AliGenBox.h"
 #include "AliGenParam.h"
+#include "AliGenEMParam.h"
 #include "AliMC.h"
 #include "AliRun.h"
 #include "AliStack.h"
@@ -71,9 +72,11 @@ AliGenEMCocktailV2::AliGenEMCocktailV2():AliGenCocktail(),
   fUseYWeighting(kFALSE),
   fDynPtRange(kFALSE),
   fForceConv(kFALSE),
-  fSelectedParticles(kGenHadrons)
+  fSelectedParticles(kGenHadrons),
+  fUseSampler(kFALSE)
 {
   // Constructor
+  fgNInstances++;
 }
 
 // initialize static member
@@ -81,11 +84,18 @@ TF1*  AliGenEMCocktailV2::fPtParametrization[]    = {0x0};
 TF1*  AliGenEMCocktailV2::fParametrizationProton  = NULL;
 TH1D* AliGenEMCocktailV2::fMtScalingFactorHisto   = NULL;
 TH2F* AliGenEMCocktailV2::fPtYDistribution[]      = {0x0};
+std::vector<AliGenEMPtSampler*> AliGenEMCocktailV2::fPtSamplers;
+Int_t AliGenEMCocktailV2::fgNInstances = 0;
 
 //_________________________________________________________________________
 AliGenEMCocktailV2::~AliGenEMCocktailV2()
 {
   // Destructor
+  // the pt samplers are shared by all cocktails and deleted with the last one;
+  // the sources only delete them after this, without using them
+  if (--fgNInstances > 0) return;
+  for (UInt_t i=0; i<fPtSamplers.size(); i++) delete fPtSamplers[i];
+  fPtSamplers.clear();
 }
 
 //_________________________________________________________________________
@@ -123,6 +133,31 @@ TH2F* AliGenEMCocktailV2::GetPtYDistribution(Int_t np) {
     return NULL;
 }
 
+//_________________________________________________________________________
+AliGenEMPtSampler* AliGenEMCocktailV2::GetPtSampler(Int_t np, Double_t ptMin, Double_t ptMax) {
+
+  // tabulated inverse CDF of the pt parametrization np in [ptMin, ptMax]
+  // it is built at the first request and reused as long as the parametrization is unchanged;
+  // request all samplers before sharing them between generators running in parallel.
+  // The samplers are kept when the parametrizations are set again, since AliGenEMParam
+  // sources may still use them (the new parametrizations get new samplers); they are
+  // deleted with the last AliGenEMCocktailV2, sources used outside of a cocktail must
+  // not outlive it
+  TF1* fct = GetPtParametrization(np);
+  if (!fct) return NULL;
+
+  for (UInt_t i=0; i<fPtSamplers.size(); i++)
+    if (fPtSamplers[i]->Matches(fct, ptMin, ptMax)) return fPtSamplers[i];
+
+  AliGenEMPtSampler* sampler = new AliGenEMPtSampler(fct, ptMin, ptMax);
+  if (!sampler->IsValid()) {
+    delete sampler;
+    return NULL;
+  }
+  fPtSamplers.push_back(sampler);
+  return sampler;
+}
+
 //_________________________________________________________________________
 void AliGenEMCocktailV2::GetPtRange(Double_t &ptMin, Double_t &ptMax) {
   ptMin = fPtMin;
@@ -213,7 +248,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     // NOTE Friederike: the additional factors here cannot be fixed numbers, if you need them
     // 					generate a setting which puts them for you but never do it hardcoded - electrons are not the only ones
     //					using the cocktail
-    genpizero = new AliGenParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kPizero, "DUMMY");
+    genpizero = new AliGenEMParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kPizero, "DUMMY");
     genpizero->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(namePizero,genpizero);
@@ -234,7 +269,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameEta[10];
     snprintf(nameEta,10,"Eta");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    geneta = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kEta, "DUMMY");
+    geneta = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kEta, "DUMMY");
     geneta->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameEta,geneta,maxPtStretchFactor);
@@ -255,7 +290,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameRho[10];
     snprintf(nameRho,10,"Rho");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genrho = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kRho0, "DUMMY");
+    genrho = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kRho0, "DUMMY");
     genrho->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameRho,genrho,maxPtStretchFactor);
@@ -276,7 +311,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameOmega[10];
     snprintf(nameOmega,10,"Omega");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genomega = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kOmega, "DUMMY");
+    genomega = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kOmega, "DUMMY");
     genomega->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameOmega,genomega,maxPtStretchFactor);
@@ -297,7 +332,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameEtaprime[10];
     snprintf(nameEtaprime,10,"Etaprime");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genetaprime = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kEtaprime, "DUMMY");
+    genetaprime = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kEtaprime, "DUMMY");
     genetaprime->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameEtaprime,genetaprime,maxPtStretchFactor);
@@ -318,7 +353,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t namePhi[10];
     snprintf(namePhi,10,"Phi");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genphi = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kPhi, "DUMMY");
+    genphi = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kPhi, "DUMMY");
     genphi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(namePhi,genphi,maxPtStretchFactor);
@@ -339,7 +374,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameJpsi[10];
     snprintf(nameJpsi,10,"Jpsi");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genjpsi = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kJpsi, "DUMMY");
+    genjpsi = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kJpsi, "DUMMY");
     genjpsi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameJpsi,genjpsi,maxPtStretchFactor);
@@ -359,7 +394,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * gensigma=0;
     Char_t nameSigma[10];
     snprintf(nameSigma,10, "Sigma0");
-    gensigma = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kSigma0, "DUMMY");
+    gensigma = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kSigma0, "DUMMY");
     gensigma->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameSigma,gensigma,maxPtStretchFactor);
@@ -379,7 +414,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkzeroshort=0;
     Char_t nameK0short[10];
     snprintf(nameK0short, 10, "K0short");
-    genkzeroshort = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kK0s, "DUMMY");
+    genkzeroshort = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kK0s, "DUMMY");
     genkzeroshort->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameK0short,genkzeroshort,maxPtStretchFactor);
@@ -399,7 +434,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkzerolong=0;
     Char_t nameK0long[10];
     snprintf(nameK0long, 10, "K0long");
-    genkzerolong = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kK0l, "DUMMY");
+    genkzerolong = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kK0l, "DUMMY");
     genkzerolong->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameK0long,genkzerolong,maxPtStretchFactor);
@@ -419,7 +454,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genLambda=0;
     Char_t nameLambda[10];
     snprintf(nameLambda, 10, "Lambda");
-    genLambda = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kLambda, "DUMMY");
+    genLambda = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kLambda, "DUMMY");
     genLambda->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameLambda,genLambda,maxPtStretchFactor);
@@ -439,7 +474,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkdeltaPlPl=0;
     Char_t nameDeltaPlPl[10];
     snprintf(nameDeltaPlPl, 10, "DeltaPlPl");
-    genkdeltaPlPl = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaPlPl, "DUMMY");
+    genkdeltaPlPl = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaPlPl, "DUMMY");
     genkdeltaPlPl->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameDeltaPlPl,genkdeltaPlPl,maxPtStretchFactor);
@@ -459,7 +494,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkdeltaPl=0;
     Char_t nameDeltaPl[10];
     snprintf(nameDeltaPl, 10, "DeltaPl");
-    genkdeltaPl = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaPl, "DUMMY");
+    genkdeltaPl = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaPl, "DUMMY");
     genkdeltaPl->SetYRange(fYMin, fYMax);
     AddSource2Generator(nameDeltaPl,genkdeltaPl,maxPtStretchFactor);
     TF1 *fPtDeltaPl = genkdeltaPl->GetPt();
@@ -478,7 +513,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkdeltaMi=0;
     Char_t nameDeltaMi[10];
     snprintf(nameDeltaMi, 10, "DeltaMi");
-    genkdeltaMi = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaMi, "DUMMY");
+    genkdeltaMi = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaMi, "DUMMY");
     genkdeltaMi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameDeltaMi,genkdeltaMi,maxPtStretchFactor);
@@ -498,7 +533,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkdeltaZero=0;
     Char_t nameDeltaZero[10];
     snprintf(nameDeltaZero, 10, "DeltaZero");
-    genkdeltaZero = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaZero, "DUMMY");
+    genkdeltaZero = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kDeltaZero, "DUMMY");
     genkdeltaZero->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameDeltaZero,genkdeltaZero,maxPtStretchFactor);
@@ -518,7 +553,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkrhoPl=0;
     Char_t nameRhoPl[10];
     snprintf(nameRhoPl, 10, "RhoPl");
-    genkrhoPl = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kRhoPl, "DUMMY");
+    genkrhoPl = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kRhoPl, "DUMMY");
     genkrhoPl->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameRhoPl,genkrhoPl,maxPtStretchFactor);
@@ -538,7 +573,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkrhoMi=0;
     Char_t nameRhoMi[10];
     snprintf(nameRhoMi, 10, "RhoMi");
-    genkrhoMi = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kRhoMi, "DUMMY");
+    genkrhoMi = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kRhoMi, "DUMMY");
     genkrhoMi->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameRhoMi,genkrhoMi,maxPtStretchFactor);
@@ -558,7 +593,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     AliGenParam * genkK0star=0;
     Char_t nameK0star[10];
     snprintf(nameK0star, 10, "K0star");
-    genkK0star = new AliGenParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kK0star, "DUMMY");
+    genkK0star = new AliGenEMParam((Int_t)(maxPtStretchFactor*fNPart), new AliGenEMlibV2(), AliGenEMlibV2::kK0star, "DUMMY");
     genkK0star->SetYRange(fYMin, fYMax);
 
     AddSource2Generator(nameK0star,genkK0star,maxPtStretchFactor);
@@ -585,7 +620,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameDirectRealG[10];
     snprintf(nameDirectRealG,10,"DirectRealGamma");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genDirectRealG = new AliGenParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kDirectRealGamma, "DUMMY");
+    genDirectRealG = new AliGenEMParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kDirectRealGamma, "DUMMY");
     genDirectRealG->SetYRange(fYMin, fYMax);
     AddSource2Generator(nameDirectRealG,genDirectRealG);
     TF1 *fPtDirectRealG = genDirectRealG->GetPt();
@@ -602,7 +637,7 @@ void AliGenEMCocktailV2::CreateCocktail()
     Char_t nameDirectVirtG[10];
     snprintf(nameDirectVirtG,10,"DirectVirtGamma");
     // NOTE: the additional factors are set back to one as they are not the same for photons and electrons
-    genDirectVirtG = new AliGenParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kDirectVirtGamma, "DUMMY");
+    genDirectVirtG = new AliGenEMParam(fNPart, new AliGenEMlibV2(), AliGenEMlibV2::kDirectVirtGamma, "DUMMY");
     genDirectVirtG->SetYRange(fYMin, fYMax);
     AddSource2Generator(nameDirectVirtG,genDirectVirtG);
     TF1 *fPtDirectVirtG = genDirectVirtG->GetPt();
@@ -627,6 +662,8 @@ void AliGenEMCocktailV2::AddSource2Generator(Char_t* nameSource,
   genSource->SetPhiRange(phiMin, phiMax);
   genSource->SetWeighting(fWeightingMode);
   genSource->SetForceGammaConversion(fForceConv);
+  AliGenEMParam* emSource = dynamic_cast<AliGenEMParam*>(genSource);
+  if (emSource) emSource->SetUseSampler(fUseSampler);
   if (!TVirtualMC::GetMC()) genSource->SetDecayer(fDecayer);
   genSource->Init();
 		
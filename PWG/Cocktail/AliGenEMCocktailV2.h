@@ -22,6 +22,7 @@
 #include "AliGenEMlibV2.h"
 #include "AliDecayer.h"
 #include "AliGenParam.h"
+#include "AliGenEMPtSampler.h"
 #include "TF1.h"
 #include "TH1D.h"
 #include "TH2F.h"
@@ -62,6 +63,7 @@ public:
   void    SetV2Systematic(AliGenEMlibV2::v2Sys_t v2sys)               { fV2Systematic = v2sys;            }
   void    SetForceGammaConversion(Bool_t force=kTRUE)                 { fForceConv=force;                 }
   void    SetHeaviestHadron(ParticleGenerator_t part);
+  void    SetUseSampler(Bool_t use=kTRUE)                             { fUseSampler = use;                } // tabulated pt/y sampling with an own TRandom3 per source, see AliGenEMParam
   static  Bool_t  SetPtParametrizations();
   static  void    SetMtScalingFactors();
   static  Bool_t  SetPtYDistributions();
@@ -69,6 +71,7 @@ public:
   // getters
   Bool_t    GetDynamicalPtRangeOption()       const                   { return fDynPtRange;               }
   Bool_t    GetYWeightOption()                const                   { return fUseYWeighting;            }
+  Bool_t    GetUseSampler()                   const                   { return fUseSampler;               }
   Float_t   GetDecayMode()                    const                   { return fDecayMode;                }
   Float_t   GetWeightingMode()                const                   { return fWeightingMode;            }
   AliGenEMlibV2::CollisionSystem_t  GetCollisionSystem()  const       { return fCollisionSystem;          }
@@ -83,6 +86,7 @@ public:
   static    TF1*    GetPtParametrization(Int_t np);
   static    TH1D*   GetMtScalingFactors();
   static    TH2F*   GetPtYDistribution(Int_t np);
+  static    AliGenEMPtSampler* GetPtSampler(Int_t np, Double_t ptMin, Double_t ptMax);
   
   //***********************************************************************************************
   // This function allows to select the particle which should be procude based on 1 Integer value
@@ -121,6 +125,8 @@ private:
   static TF1*     fParametrizationProton;               //
   static TH1D*    fMtScalingFactorHisto;                // mt scaling factors
   static TH2F*    fPtYDistribution[18];                 // pt-y distribution
+  static std::vector<AliGenEMPtSampler*> fPtSamplers;   // tabulated pt parametrizations, one per parametrization and range
+  static Int_t    fgNInstances;                         // number of cocktails, the samplers are deleted with the last one
   
   AliGenEMlibV2::CollisionSystem_t  fCollisionSystem;   // selected collision system
   AliGenEMlibV2::Centrality_t       fCentrality;        // selected centrality
@@ -130,8 +136,9 @@ private:
   Bool_t        fDynPtRange;                            // select if the pt range for the generation should be adapted to different mother particle weights dynamically
   Bool_t        fForceConv;                             // select whether you want to force all gammas to convert imidediately
   UInt_t        fSelectedParticles;                     // which particles to simulate, allows to switch on and off 32 different particles
+  Bool_t        fUseSampler;                            // sample pt and y of the sources from tables (AliGenEMParam::SetUseSampler)
   
-  ClassDef(AliGenEMCocktailV2,7)                        // cocktail for EM physics
+  ClassDef(AliGenEMCocktailV2,8)                        // cocktail for EM physics
 };
 
 #endif
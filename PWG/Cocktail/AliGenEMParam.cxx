@@ -0,0 +1,123 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// AliGenParam for the EM cocktail, sampling pt and y from tabulated       //
+// parametrizations with its own random generator                          //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include <TF1.h>
+#include <TRandom3.h>
+
+#include "AliLog.h"
+#include "AliGenEMCocktailV2.h"
+#include "AliGenEMPtSampler.h"
+#include "AliGenEMSampledFunction.h"
+#include "AliGenEMParam.h"
+
+ClassImp(AliGenEMParam)
+
+//________________________________________________________________________
+AliGenEMParam::AliGenEMParam():
+  AliGenParam(),
+  fUseSampler(kFALSE),
+  fGenRandom(0),
+  fPtSampler(0),
+  fOwnPtSampler(kFALSE),
+  fYSampler(0)
+{
+  // Constructor
+}
+
+//________________________________________________________________________
+AliGenEMParam::AliGenEMParam(Int_t npart, const AliGenLib* library, Int_t param, const char* tname):
+  AliGenParam(npart, library, param, tname),
+  fUseSampler(kFALSE),
+  fGenRandom(0),
+  fPtSampler(0),
+  fOwnPtSampler(kFALSE),
+  fYSampler(0)
+{
+  // Constructor, see AliGenParam
+}
+
+//________________________________________________________________________
+AliGenEMParam::~AliGenEMParam()
+{
+  // Destructor
+  ClearSamplers();
+  if (GetRandom() == fGenRandom) SetRandom();
+  delete fGenRandom;
+}
+
+//________________________________________________________________________
+void AliGenEMParam::ClearSamplers()
+{
+  // delete the own tables
+  if (fOwnPtSampler) delete fPtSampler;
+  fPtSampler    = 0;
+  fOwnPtSampler = kFALSE;
+  delete fYSampler;
+  fYSampler     = 0;
+}
+
+//________________________________________________________________________
+void AliGenEMParam::SetRandomSeed(UInt_t seed)
+{
+  // seed of the random generator of this source (0: seeded by TRandom3 from a UUID)
+  if (!fGenRandom) fGenRandom = new TRandom3(seed);
+  else fGenRandom->SetSeed(seed);
+}
+
+//________________________________________________________________________
+void AliGenEMParam::Init()
+{
+  // AliGenParam::Init(), then replaces the pt and y parametrizations by tabulated copies
+  // if SetUseSampler() was called. Without SetUseSampler() and SetRandomSeed() the
+  // generator is identical to AliGenParam, with gRandom
+  AliGenParam::Init();
+  ClearSamplers();
+  if (!fUseSampler && !fGenRandom) return;
+
+  if (!fGenRandom) SetRandomSeed(gRandom->Integer(kMaxUInt) + 1);
+  SetRandom(fGenRandom);
+  if (!fUseSampler) return;
+
+  // pt: table shared by the cocktail if the source has a parametrization there, own table otherwise
+  if (fParam >= 0 && fParam < 18) fPtSampler = AliGenEMCocktailV2::GetPtSampler(fParam, fPtMin, fPtMax);
+  if (!fPtSampler && fPtPara) {
+    fPtSampler    = new AliGenEMPtSampler(fPtPara, fPtMin, fPtMax);
+    fOwnPtSampler = kTRUE;
+  }
+  if (fPtSampler && fPtSampler->IsValid()) {
+    TF1* sampled = new AliGenEMSampledFunction(*fPtPara, fPtSampler, fGenRandom);
+    delete fPtPara;
+    fPtPara = sampled;
+  }
+  else AliWarning(Form("%s: pt parametrization cannot be tabulated, TF1::GetRandom() is used", GetName()));
+
+  // y
+  if (fYPara) {
+    fYSampler = new AliGenEMPtSampler(fYPara, fYMin, fYMax);
+    if (fYSampler->IsValid()) {
+      TF1* sampled = new AliGenEMSampledFunction(*fYPara, fYSampler, fGenRandom);
+      delete fYPara;
+      fYPara = sampled;
+    }
+    else AliWarning(Form("%s: y parametrization cannot be tabulated, TF1::GetRandom() is used", GetName()));
+  }
+}
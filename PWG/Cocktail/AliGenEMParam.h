@@ -0,0 +1,68 @@
+#ifndef AliGenEMParam_H
+#define AliGenEMParam_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// AliGenParam for the EM cocktail, sampling pt and y from tabulated       //
+// parametrizations with its own random generator                          //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+// By default the generator is identical to AliGenParam. With SetUseSampler(),
+// after AliGenParam::Init() the pt and y parametrizations are replaced by
+// AliGenEMSampledFunction copies, so that the pt (kAnalog weighting) and y
+// of the mother particles are drawn from AliGenEMPtSampler tables instead
+// of TF1::GetRandom(). For the sources with a parametrization in
+// AliGenEMCocktailV2 the pt table is the shared one of
+// AliGenEMCocktailV2::GetPtSampler(), for the others (direct photons) the
+// generator tabulates its own pt function.
+// With SetUseSampler() or SetRandomSeed(), the uniform numbers of AliGenParam
+// (phi, pt with kNonAnalog weighting) and the tabulated draws use a TRandom3
+// owned by the generator, seeded from gRandom at Init() unless SetRandomSeed()
+// was called, so that the sequence of a source does not depend on the other
+// sources. Otherwise gRandom is used, as in AliGenParam.
+// The decayer and the v2 modulation of phi (TF1::GetRandom() of
+// AliGenParam) keep using their own and the global generator.
+
+#include "AliGenParam.h"
+
+class TRandom;
+class AliGenEMPtSampler;
+
+class AliGenEMParam : public AliGenParam
+{
+public:
+
+  AliGenEMParam();
+  AliGenEMParam(Int_t npart, const AliGenLib* library, Int_t param, const char* tname=0);
+  virtual ~AliGenEMParam();
+  virtual void Init();
+
+  // setters
+  void      SetUseSampler(Bool_t use=kTRUE)                           { fUseSampler = use;                }
+  void      SetRandomSeed(UInt_t seed);
+
+  // getters
+  Bool_t    GetUseSampler()                   const                   { return fUseSampler;               }
+  TRandom*  GetGeneratorRandom()              const                   { return fGenRandom;                }
+  const AliGenEMPtSampler* GetPtSampler()     const                   { return fPtSampler;                }
+  const AliGenEMPtSampler* GetYSampler()      const                   { return fYSampler;                 }
+
+private:
+  AliGenEMParam(const AliGenEMParam&);
+  AliGenEMParam& operator=(const AliGenEMParam&);
+
+  void      ClearSamplers();
+
+  Bool_t             fUseSampler;                       // sample pt and y from the tables, TF1::GetRandom() otherwise (default)
+  TRandom*           fGenRandom;                        //! random generator of this source, owned
+  AliGenEMPtSampler* fPtSampler;                        //! pt table
+  Bool_t             fOwnPtSampler;                     //! pt table owned (not shared by AliGenEMCocktailV2)
+  AliGenEMPtSampler* fYSampler;                         //! y table, owned
+
+  ClassDef(AliGenEMParam,1)                             // AliGenParam with tabulated parametrizations
+};
+
+#endif
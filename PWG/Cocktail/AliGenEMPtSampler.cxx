@@ -0,0 +1,150 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// Tabulated inverse CDF of a pt parametrization for the EM cocktail       //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <TF1.h>
+#include <TMath.h>
+#include <TRandom.h>
+
+#include "AliLog.h"
+#include "AliGenEMPtSampler.h"
+
+ClassImp(AliGenEMPtSampler)
+
+//________________________________________________________________________
+AliGenEMPtSampler::AliGenEMPtSampler():
+  fFunction(0),
+  fParameters(),
+  fXmin(0.),
+  fXmax(0.),
+  fStep(0.),
+  fIntegral(0.),
+  fDensity(),
+  fCumulative()
+{
+  // Constructor
+}
+
+//________________________________________________________________________
+AliGenEMPtSampler::AliGenEMPtSampler(TF1* function, Double_t xMin, Double_t xMax, Int_t nPoints):
+  fFunction(0),
+  fParameters(),
+  fXmin(0.),
+  fXmax(0.),
+  fStep(0.),
+  fIntegral(0.),
+  fDensity(),
+  fCumulative()
+{
+  // Constructor, tabulating the function in [xMin, xMax]
+  Build(function, xMin, xMax, nPoints);
+}
+
+//________________________________________________________________________
+Bool_t AliGenEMPtSampler::Build(TF1* function, Double_t xMin, Double_t xMax, Int_t nPoints)
+{
+  // tabulate the function and its cumulative integral in [xMin, xMax]
+  fFunction = function;
+  fXmin     = xMin;
+  fXmax     = xMax;
+  fIntegral = 0.;
+  fDensity.clear();
+  fCumulative.clear();
+  fParameters.clear();
+  if (!function || !(xMax > xMin) || nPoints < 2) {
+    AliError(Form("Cannot tabulate %s in [%f, %f] with %d points", function ? function->GetName() : "no function", xMin, xMax, nPoints));
+    return kFALSE;
+  }
+  fParameters.assign(function->GetParameters(), function->GetParameters() + function->GetNpar());
+
+  fStep = (xMax - xMin) / (nPoints - 1);
+  fDensity.resize(nPoints);
+  fCumulative.resize(nPoints);
+  for (Int_t i=0; i<nPoints; i++) {
+    Double_t value = function->Eval(i<nPoints-1 ? xMin + i*fStep : xMax);
+    fDensity[i] = (TMath::Finite(value) && value > 0.) ? value : 0.;
+  }
+
+  // trapezoidal integral, exact for the piecewise linear density sampled below
+  fCumulative[0] = 0.;
+  for (Int_t i=1; i<nPoints; i++)
+    fCumulative[i] = fCumulative[i-1] + 0.5*fStep*(fDensity[i-1] + fDensity[i]);
+  fIntegral = fCumulative[nPoints-1];
+  if (!(fIntegral > 0.)) {
+    AliError(Form("Function %s has no positive integral in [%f, %f]", function->GetName(), xMin, xMax));
+    fIntegral = 0.;
+    return kFALSE;
+  }
+  for (Int_t i=1; i<nPoints; i++) fCumulative[i] /= fIntegral;
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliGenEMPtSampler::Matches(const TF1* function, Double_t xMin, Double_t xMax) const
+{
+  // true if the sampler was built for this function, with its current parameters, and range
+  if (!IsValid() || function != fFunction || xMin != fXmin || xMax != fXmax) return kFALSE;
+  if (function->GetNpar() != (Int_t)fParameters.size()) return kFALSE;
+  for (UInt_t i=0; i<fParameters.size(); i++)
+    if (function->GetParameter(i) != fParameters[i]) return kFALSE;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Double_t AliGenEMPtSampler::Quantile(Double_t u) const
+{
+  // x at which the normalised cumulative integral reaches u
+  if (!IsValid()) return 0.;
+  if (u <= 0.) return fXmin;
+  if (u >= 1.) return fXmax;
+
+  Int_t bin = std::upper_bound(fCumulative.begin(), fCumulative.end(), u) - fCumulative.begin() - 1;
+  if (bin > (Int_t)fCumulative.size() - 2) bin = fCumulative.size() - 2;
+
+  // solve f0*t + s*t^2/2 = area for the linear density f0 + s*t within the bin
+  Double_t area  = (u - fCumulative[bin]) * fIntegral;
+  Double_t f0    = fDensity[bin];
+  Double_t slope = (fDensity[bin+1] - f0) / fStep;
+  Double_t disc  = f0*f0 + 2.*slope*area;
+  Double_t denom = f0 + TMath::Sqrt(disc > 0. ? disc : 0.);
+  Double_t t     = denom > 0. ? 2.*area/denom : 0.;
+  if (t > fStep) t = fStep;
+
+  Double_t x = fXmin + bin*fStep + t;
+  return x < fXmax ? x : fXmax;
+}
+
+//________________________________________________________________________
+Double_t AliGenEMPtSampler::Sample(TRandom* rnd) const
+{
+  // one value distributed according to the function
+  return Quantile(rnd->Rndm());
+}
+
+//________________________________________________________________________
+void AliGenEMPtSampler::Sample(TRandom* rnd, Int_t n, Double_t* values) const
+{
+  // n values distributed according to the function
+  if (n <= 0) return;
+  rnd->RndmArray(n, values);
+  for (Int_t i=0; i<n; i++) values[i] = Quantile(values[i]);
+}
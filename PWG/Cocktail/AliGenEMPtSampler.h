@@ -0,0 +1,62 @@
+#ifndef AliGenEMPtSampler_H
+#define AliGenEMPtSampler_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// Tabulated inverse CDF of a pt parametrization for the EM cocktail       //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+// The function is evaluated once on a uniform grid of the requested range
+// and treated as piecewise linear between the grid points; its cumulative
+// integral is tabulated and inverted exactly for each random number.
+// After Build() the sampler is not modified anymore: several generators,
+// each with its own TRandom, can sample from the same object at the same
+// time, and batches of values are sampled with a single RndmArray() call.
+
+#include <vector>
+#include "Rtypes.h"
+
+class TF1;
+class TRandom;
+
+class AliGenEMPtSampler
+{
+public:
+
+  AliGenEMPtSampler();
+  AliGenEMPtSampler(TF1* function, Double_t xMin, Double_t xMax, Int_t nPoints=kDefaultNPoints);
+  virtual ~AliGenEMPtSampler() {}
+
+  Bool_t    Build(TF1* function, Double_t xMin, Double_t xMax, Int_t nPoints=kDefaultNPoints);
+  Bool_t    Matches(const TF1* function, Double_t xMin, Double_t xMax) const;
+  Double_t  Quantile(Double_t u) const;
+  Double_t  Sample(TRandom* rnd) const;
+  void      Sample(TRandom* rnd, Int_t n, Double_t* values) const;
+
+  // getters
+  Bool_t    IsValid()                         const                   { return fIntegral > 0.;            }
+  Double_t  GetXmin()                         const                   { return fXmin;                     }
+  Double_t  GetXmax()                         const                   { return fXmax;                     }
+  Double_t  GetIntegral()                     const                   { return fIntegral;                 }
+  Int_t     GetNPoints()                      const                   { return fDensity.size();           }
+
+  static const Int_t kDefaultNPoints = 10000;                         // grid points per range
+
+private:
+
+  const TF1*            fFunction;                      //! tabulated function, not owned, only used in Matches()
+  std::vector<Double_t> fParameters;                    // parameters of the function when tabulated
+  Double_t              fXmin;                          // lower edge of the range
+  Double_t              fXmax;                          // upper edge of the range
+  Double_t              fStep;                          // grid spacing
+  Double_t              fIntegral;                      // integral of the function in the range
+  std::vector<Double_t> fDensity;                       // function at the grid points, negative values set to 0
+  std::vector<Double_t> fCumulative;                    // integral up to each grid point, normalised to 1
+
+  ClassDef(AliGenEMPtSampler,1)                         // tabulated inverse CDF of a parametrization
+};
+
+#endif
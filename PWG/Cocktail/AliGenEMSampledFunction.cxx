@@ -0,0 +1,63 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// Parametrization of AliGenEMParam sampled with AliGenEMPtSampler         //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+#include <TROOT.h>
+
+#include "AliGenEMPtSampler.h"
+#include "AliGenEMSampledFunction.h"
+
+ClassImp(AliGenEMSampledFunction)
+
+//________________________________________________________________________
+AliGenEMSampledFunction::AliGenEMSampledFunction():
+  TF1(),
+  fSampler(0),
+  fRandom(0)
+{
+  // Constructor
+}
+
+//________________________________________________________________________
+AliGenEMSampledFunction::AliGenEMSampledFunction(const TF1& function, const AliGenEMPtSampler* sampler, TRandom* random):
+  TF1(function),
+  fSampler(sampler),
+  fRandom(random)
+{
+  // Constructor, copying the function
+  gROOT->GetListOfFunctions()->Remove(this);
+}
+
+//________________________________________________________________________
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+Double_t AliGenEMSampledFunction::GetRandom(TRandom* rng, Option_t* opt)
+{
+  // random value from the tabulated function, TF1::GetRandom() without table or generator
+  if (!fSampler || !fSampler->IsValid() || !fRandom) return TF1::GetRandom(rng, opt);
+  return fSampler->Sample(rng ? rng : fRandom);
+}
+#else
+Double_t AliGenEMSampledFunction::GetRandom()
+{
+  // random value from the tabulated function, TF1::GetRandom() without table or generator
+  if (!fSampler || !fSampler->IsValid() || !fRandom) return TF1::GetRandom();
+  return fSampler->Sample(fRandom);
+}
+#endif
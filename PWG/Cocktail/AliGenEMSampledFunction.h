@@ -0,0 +1,48 @@
+#ifndef AliGenEMSampledFunction_H
+#define AliGenEMSampledFunction_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// Parametrization of AliGenEMParam sampled with AliGenEMPtSampler         //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
+
+// Copy of a TF1 whose GetRandom() draws from a tabulated inverse CDF with
+// a given random generator instead of TF1::GetRandom() with gRandom; all
+// other methods (Eval, Integral, ...) are the ones of the copied function.
+
+#include "TF1.h"
+
+class TRandom;
+class AliGenEMPtSampler;
+
+class AliGenEMSampledFunction : public TF1
+{
+public:
+
+  AliGenEMSampledFunction();
+  AliGenEMSampledFunction(const TF1& function, const AliGenEMPtSampler* sampler, TRandom* random);
+  virtual ~AliGenEMSampledFunction() {}
+
+  using TF1::GetRandom;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+  virtual Double_t GetRandom(TRandom* rng=nullptr, Option_t* opt=nullptr);
+#else
+  virtual Double_t GetRandom();
+#endif
+
+  const AliGenEMPtSampler* GetSampler()       const                   { return fSampler;                  }
+
+private:
+  AliGenEMSampledFunction(const AliGenEMSampledFunction&);
+  AliGenEMSampledFunction& operator=(const AliGenEMSampledFunction&);
+
+  const AliGenEMPtSampler* fSampler;                    //! tabulated function, not owned
+  TRandom*                 fRandom;                     //! random generator, not owned
+
+  ClassDef(AliGenEMSampledFunction,1)                   // parametrization sampled from a table
+};
+
+#endif
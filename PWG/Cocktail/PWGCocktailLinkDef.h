@@ -8,4 +8,7 @@
 #pragma link C++ class AliGenEMCocktail+;
 #pragma link C++ class AliGenEMlibV2+;
 #pragma link C++ class AliGenEMCocktailV2+;
+#pragma link C++ class AliGenEMPtSampler+;
+#pragma link C++ class AliGenEMSampledFunction+;
+#pragma link C++ class AliGenEMParam+;
 #endif
@@ -51,6 +51,7 @@
 #include "AliMultiInputEventHandler.h"
 #include "AliMultSelection.h"
 #include "AliStack.h"
+#include "AliTriggerClassMap.h"
 #include "AliVCaloTrigger.h"
 #include "AliVCluster.h"
 #include "AliVEventHandler.h"
@@ -58,6 +59,13 @@
 
 Double_t AliAnalysisTaskEmcal::fgkEMCalDCalPhiDivide = 4.;
 
+namespace {
+  /// Fixed entries of AliAnalysisTaskEmcal::fTrigClassPatterns
+  enum { kTrigClassBeam = 0, kTrigClassJ1, kTrigClassJ2, kTrigClassG1, kTrigClassG2, kNTrigClassFixed };
+  /// Treatment of the classes of fTrigClass in case of overlapping EMCal triggers
+  enum { kTrigClassOther = 0, kTrigClassEmcal = 1, kTrigClassGamma = 2, kTrigClassLow = 4, kTrigClassHigh = 8 };
+}
+
 /// \cond CLASSIMP
 ClassImp(AliAnalysisTaskEmcal);
 /// \endcond
@@ -143,6 +151,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal() :
   fNTrials(0),
   fXsection(0),
   fPythiaInfo(nullptr),
+  fTrigClassPatterns(),
+  fMinBiasRefTriggerPattern(-1),
   fOutput(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
@@ -254,6 +264,8 @@ AliAnalysisTaskEmcal::AliAnalysisTaskEmcal(const char *name, Bool_t histo) :
   fNTrials(0),
   fXsection(0),
   fPythiaInfo(0),
+  fTrigClassPatterns(),
+  fMinBiasRefTriggerPattern(-1),
   fOutput(nullptr),
   fHistEventCount(nullptr),
   fHistTrialsAfterSel(nullptr),
@@ -537,17 +549,17 @@ Bool_t AliAnalysisTaskEmcal::FillGeneralHistograms()
     fHistEventPlane->Fill(fEPV0);
   }
 
-  std::unique_ptr<TObjArray> triggerClasses(InputEvent()->GetFiredTriggerClasses().Tokenize(" "));
-  TObjString* triggerClass(nullptr);
-  for(auto trg : *triggerClasses){
-    triggerClass = static_cast<TObjString*>(trg);
-    fHistTriggerClasses->Fill(triggerClass->GetString(), 1);
+  if (fTrigClassPatterns.empty()) CompileTriggerClassPatterns();
+  AliTriggerClassMap *triggerClasses = AliTriggerClassMap::Instance();
+  triggerClasses->Update(InputEvent());
+  for(Int_t itrg = 0; itrg < triggerClasses->GetNFiredClasses(); itrg++){
+    fHistTriggerClasses->Fill(triggerClasses->GetFiredClassName(itrg), 1);
   }
 
   if(fCountDownscaleCorrectedEvents){
     // downscale-corrected number of events are calculated based on the min. bias reference
     // Formula: N_corr = N_MB * d_Trg/d_{Min_Bias}
-    if(InputEvent()->GetFiredTriggerClasses().Contains(fMinBiasRefTrigger)){
+    if(triggerClasses->IsFired(fMinBiasRefTriggerPattern)){
       AliEmcalDownscaleFactorsOCDB *downscalefactors = AliEmcalDownscaleFactorsOCDB::Instance();
       Double_t downscaleref = downscalefactors->GetDownscaleFactorForTriggerClass(fMinBiasRefTrigger);
       for(auto t : downscalefactors->GetTriggerClasses()){
@@ -884,6 +896,8 @@ void AliAnalysisTaskEmcal::ExecOnce()
 
   LoadPythiaInfo(InputEvent());
 
+  CompileTriggerClassPatterns();
+
   if (fNeedEmcalGeom) {
     fGeom = AliEMCALGeometry::GetInstanceFromRunNumber(InputEvent()->GetRunNumber());
     if (!fGeom) {
@@ -959,6 +973,35 @@ void AliAnalysisTaskEmcal::ExecOnce()
   fLocalInitialized = kTRUE;
 }
 
+void AliAnalysisTaskEmcal::CompileTriggerClassPatterns()
+{
+  // Layout of fTrigClassPatterns: the fixed patterns (beam, J1, J2, G1, G2), followed
+  // by pairs of (pattern, EMCal trigger type) for each class of fTrigClass
+  AliTriggerClassMap *triggerClasses = AliTriggerClassMap::Instance();
+  fTrigClassPatterns.clear();
+  const char *fixed[kNTrigClassFixed] = {"-B-", "J1", "J2", "G1", "G2"};
+  for (Int_t i = 0; i < kNTrigClassFixed; i++) fTrigClassPatterns.push_back(triggerClasses->CompilePattern(fixed[i]));
+
+  std::unique_ptr<TObjArray> arr(fTrigClass.Tokenize("|"));
+  for (Int_t i = 0; i < arr->GetEntriesFast(); ++i) {
+    TObject *obj = arr->At(i);
+    if (!obj) continue;
+    TString objStr = obj->GetName();
+    Int_t type = kTrigClassOther;
+    if (objStr.Contains("J1") || objStr.Contains("J2") || objStr.Contains("G1") || objStr.Contains("G2")) {
+      Bool_t gamma = objStr.Contains("G");
+      type = kTrigClassEmcal;
+      if (gamma) type |= kTrigClassGamma;
+      if (objStr.Contains(gamma ? "G2" : "J2")) type |= kTrigClassLow;
+      if (objStr.Contains(gamma ? "G1" : "J1")) type |= kTrigClassHigh;
+    }
+    fTrigClassPatterns.push_back(triggerClasses->CompilePattern(objStr));
+    fTrigClassPatterns.push_back(type);
+  }
+
+  fMinBiasRefTriggerPattern = triggerClasses->CompilePattern(fMinBiasRefTrigger);
+}
+
 AliAnalysisTaskEmcal::BeamType AliAnalysisTaskEmcal::GetBeamType() const
 {
   if (fForceBeamType != kNA)
@@ -1065,49 +1108,35 @@ Bool_t AliAnalysisTaskEmcal::IsEventSelected()
   }
 
   if (!fTrigClass.IsNull()) {
-    TString fired;
-    const AliESDEvent *eev = dynamic_cast<const AliESDEvent*>(InputEvent());
-    if (eev) {
-      fired = eev->GetFiredTriggerClasses();
-    } else {
-      const AliAODEvent *aev = dynamic_cast<const AliAODEvent*>(InputEvent());
-      if (aev) {
-        fired = aev->GetFiredTriggerClasses();
-      }
-    }
-    if (!fired.Contains("-B-")) {
+    // IsEventSelected can be called before ExecOnce (e.g. by derived tasks)
+    if (fTrigClassPatterns.empty()) CompileTriggerClassPatterns();
+    AliTriggerClassMap *triggerClasses = AliTriggerClassMap::Instance();
+    Bool_t hasTriggerClasses = dynamic_cast<const AliESDEvent*>(InputEvent()) || dynamic_cast<const AliAODEvent*>(InputEvent());
+    if (hasTriggerClasses) triggerClasses->Update(InputEvent());
+    if (!hasTriggerClasses || !triggerClasses->IsFired(fTrigClassPatterns[kTrigClassBeam])) {
       if (fGeneralHistograms) fHistEventRejection->Fill("trigger",1);
       return kFALSE;
     }
 
-    std::unique_ptr<TObjArray> arr(fTrigClass.Tokenize("|"));
-    if (!arr) {
-      if (fGeneralHistograms) fHistEventRejection->Fill("trigger",1);
-      return kFALSE;
-    }
     Bool_t match = 0;
-    for (Int_t i=0;i<arr->GetEntriesFast();++i) {
-      TObject *obj = arr->At(i);
-      if (!obj)
-        continue;
+    for (UInt_t i = kNTrigClassFixed; i < fTrigClassPatterns.size(); i += 2) {
+      Int_t pattern = fTrigClassPatterns[i], type = fTrigClassPatterns[i+1];
 
       //Check if requested trigger was fired
-      TString objStr = obj->GetName();
-      if(fEMCalTriggerMode == kOverlapWithLowThreshold &&
-          (objStr.Contains("J1") || objStr.Contains("J2") || objStr.Contains("G1") || objStr.Contains("G2"))) {
+      if(fEMCalTriggerMode == kOverlapWithLowThreshold && type != kTrigClassOther) {
         // This is relevant for EMCal triggers with 2 thresholds
         // If the kOverlapWithLowThreshold was requested than the overlap between the two triggers goes with the lower threshold trigger
-        TString trigType1 = "J1";
-        TString trigType2 = "J2";
-        if(objStr.Contains("G")) {
-          trigType1 = "G1";
-          trigType2 = "G2";
+        Int_t trigType1 = fTrigClassPatterns[kTrigClassJ1];
+        Int_t trigType2 = fTrigClassPatterns[kTrigClassJ2];
+        if(type & kTrigClassGamma) {
+          trigType1 = fTrigClassPatterns[kTrigClassG1];
+          trigType2 = fTrigClassPatterns[kTrigClassG2];
         }
-        if(objStr.Contains(trigType2) && fired.Contains(trigType2.Data())) { //requesting low threshold + overlap
+        if((type & kTrigClassLow) && triggerClasses->IsFired(trigType2)) { //requesting low threshold + overlap
           match = 1;
           break;
-        } 
-        else if(objStr.Contains(trigType1) && fired.Contains(trigType1.Data()) && !fired.Contains(trigType2.Data())) { //high threshold only
+        }
+        else if((type & kTrigClassHigh) && triggerClasses->IsFired(trigType1) && !triggerClasses->IsFired(trigType2)) { //high threshold only
           match = 1;
           break;
         }
@@ -1115,7 +1144,7 @@ Bool_t AliAnalysisTaskEmcal::IsEventSelected()
       else {
         // If this is not an EMCal trigger, or no particular treatment of EMCal triggers was requested,
         // simply check that the trigger was fired
-        if (fired.Contains(obj->GetName())) {
+        if (triggerClasses->IsFired(pattern)) {
           match = 1;
           break;
         }
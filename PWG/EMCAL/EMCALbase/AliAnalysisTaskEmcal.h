@@ -23,6 +23,8 @@ class AliEmcalPythiaInfo;
 class AliAODInputHandler;
 class AliESDInputHandler;
 
+#include <vector>
+
 #include "Rtypes.h"
 #include "TArrayI.h"
 
@@ -308,8 +310,8 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
    */
   void                        SetTrackPtCut(Double_t cut, Int_t c=0);
 
-  void                        SetTrigClass(const char *n)                           { fTrigClass         = n                              ; }
-  void                        SetMinBiasTriggerClassName(const char *n)             { fMinBiasRefTrigger = n                              ; }
+  void                        SetTrigClass(const char *n)                           { fTrigClass         = n ; fTrigClassPatterns.clear()  ; }
+  void                        SetMinBiasTriggerClassName(const char *n)             { fMinBiasRefTrigger = n ; fTrigClassPatterns.clear()  ; }
   void                        SetTriggerTypeSel(TriggerType t)                      { fTriggerTypeSel    = t                              ; } 
   void                        SetUseAliAnaUtils(Bool_t b, Bool_t bRejPilup = kTRUE) { fUseAliAnaUtils    = b ; fRejectPileup = bRejPilup  ; }
   void                        SetVzRange(Double_t min, Double_t max)                { fMinVz             = min  ; fMaxVz   = max          ; }
@@ -638,6 +640,17 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
    */
   virtual void                ExecOnce();
 
+  /**
+   * @brief Compile the trigger classes used in the event selection.
+   *
+   * The trigger classes of fTrigClass and the min. bias reference trigger
+   * are compiled into patterns of AliTriggerClassMap, so that the fired
+   * trigger classes are not parsed again in every event. Called in ExecOnce,
+   * or at the first use if the trigger classes are needed earlier or were
+   * changed afterwards.
+   */
+  void                        CompileTriggerClassPatterns();
+
   /**
    * @brief Filling general histograms.
    *
@@ -891,6 +904,8 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   Int_t                       fNTrials;                    //!<!event trials
   Float_t                     fXsection;                   //!<!x-section from pythia header
   AliEmcalPythiaInfo         *fPythiaInfo;                 //!<!event parton info
+  std::vector<Int_t>          fTrigClassPatterns;          //!<!compiled trigger classes of fTrigClass (see CompileTriggerClassPatterns)
+  Int_t                       fMinBiasRefTriggerPattern;   //!<!compiled min. bias reference trigger
 
   // Output
   AliEmcalList               *fOutput;                     //!<!output list
@@ -917,7 +932,7 @@ class AliAnalysisTaskEmcal : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcal &operator=(const AliAnalysisTaskEmcal&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcal, 16) // EMCAL base analysis task
+  ClassDef(AliAnalysisTaskEmcal, 17) // EMCAL base analysis task
   /// \endcond
 };
 
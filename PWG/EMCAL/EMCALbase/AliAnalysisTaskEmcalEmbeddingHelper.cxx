@@ -32,6 +32,8 @@
 #include <TUUID.h>
 #include <TKey.h>
 #include <TProfile.h>
+#include <TChainElement.h>
+#include <TStopwatch.h>
 #include <TH1F.h>
 
 #include <AliLog.h>
@@ -61,6 +63,8 @@ AliAnalysisTaskEmcalEmbeddingHelper* AliAnalysisTaskEmcalEmbeddingHelper::fgInst
 AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   AliAnalysisTaskSE(),
   fCreateHisto(true),
+  fTreeCacheSize(-1),
+  fPrefetchNextFile(false),
   fTreeName(),
   fAnchorRun(169838),
   fPtHardBin(-1),
@@ -84,6 +88,10 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fOffset(0),
   fMaxNumberOfFiles(0),
   fFileNumber(0),
+  fPrefetchedFileNumber(-1),
+  fPrefetchHandle(nullptr),
+  fPrefetchXSecHandle(nullptr),
+  fIOWaitTime(0.),
   fInitializedConfiguration(false),
   fInitializedEmbedding(false),
   fInitializedNewFile(false),
@@ -117,6 +125,8 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
 AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const char *name) :
   AliAnalysisTaskSE(name),
   fCreateHisto(true),
+  fTreeCacheSize(-1),
+  fPrefetchNextFile(false),
   fTreeName("aodTree"),
   fAnchorRun(169838),
   fPtHardBin(-1),
@@ -140,6 +150,10 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fOffset(0),
   fMaxNumberOfFiles(0),
   fFileNumber(0),
+  fPrefetchedFileNumber(-1),
+  fPrefetchHandle(nullptr),
+  fPrefetchXSecHandle(nullptr),
+  fIOWaitTime(0.),
   fInitializedConfiguration(false),
   fInitializedEmbedding(false),
   fInitializedNewFile(false),
@@ -177,6 +191,7 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
 AliAnalysisTaskEmcalEmbeddingHelper::~AliAnalysisTaskEmcalEmbeddingHelper()
 {
   if (fgInstance == this) fgInstance = 0;
+  ReleasePrefetchedFiles(true);
   if (fExternalEvent) delete fExternalEvent;
   if (fExternalFile) {
     fExternalFile->Close();
@@ -411,6 +426,9 @@ void AliAnalysisTaskEmcalEmbeddingHelper::DetermineFirstFileToEmbed()
 Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 {
   Int_t attempts = -1;
+  // Time spent in I/O for this event, in seconds
+  Double_t ioWaitTime = fIOWaitTime;
+  TStopwatch ioTimer;
 
   do {
     // Reset to start of tree
@@ -436,7 +454,9 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
     // Load current event
     // Can be a simple less than, because fFileNumber counts from 0.
     if (fFileNumber < fMaxNumberOfFiles) {
+      ioTimer.Start();
       fChain->GetEntry(fCurrentEntry);
+      fIOWaitTime += ioTimer.RealTime();
     }
     else {
       AliError("====================================================================================================");
@@ -454,7 +474,9 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 
       // Access the relevant entry
       // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
+      ioTimer.Start();
       fChain->GetEntry(fCurrentEntry);
+      fIOWaitTime += ioTimer.RealTime();
     }
     AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
 
@@ -479,6 +501,8 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
   if (fCreateHisto) {
     fHistManager.FillTH1("fHistEventCount", "Accepted");
     fHistManager.FillTH1("fHistEmbeddedEventsAttempted", attempts);
+    ioWaitTime = fIOWaitTime - ioWaitTime;
+    fHistManager.FillTH1("fHistEmbeddedEventIOWaitTime", ioWaitTime * 1000.);
   }
 
   if (!fChain) return kFALSE;
@@ -737,6 +761,11 @@ void AliAnalysisTaskEmcalEmbeddingHelper::UserCreateOutputObjects()
   histTitle = "Number of embedded events rejected by event selection before success;Number of rejected events;Counts";
   fHistManager.CreateTH1(histName, histTitle, 200, 0, 200);
 
+  // Time spent waiting for the embedded input per accepted event
+  histName = "fHistEmbeddedEventIOWaitTime";
+  histTitle = "Time spent reading the embedded input per accepted event;t_{I/O} (ms);Counts";
+  fHistManager.CreateTH1(histName, histTitle, 500, 0, 500);
+
   // Number of files embedded
   histName = "fHistNumberOfFilesEmbedded";
   histTitle = "Number of files which contributed events to be embeeded";
@@ -867,6 +896,19 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::SetupInputFiles()
   Bool_t res = InitEvent();
   if (!res) return kFALSE;
 
+  // Read the embedded events through a tree cache, such that the baskets of consecutive
+  // entries are fetched in few large requests instead of one request per branch and event.
+  // The cache must be set up after the branch addresses were set in InitEvent().
+  // By default (negative size) the cache settings of ROOT are kept.
+  if (fTreeCacheSize > 0) {
+    fChain->SetCacheSize(fTreeCacheSize);
+    fChain->AddBranchToCache("*", kTRUE);
+    AliInfo(TString::Format("Using tree cache of %lld MB for the embedded input", fTreeCacheSize / (1024 * 1024)));
+  }
+  else if (fTreeCacheSize == 0) {
+    fChain->SetCacheSize(0);
+  }
+
   return kTRUE;
 }
 
@@ -964,6 +1006,9 @@ void AliAnalysisTaskEmcalEmbeddingHelper::SetupEmbedding()
  */
 void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
 {
+  // Opening of the new file counts as waiting for the embedded input
+  TStopwatch ioTimer;
+
   // Load first entry of the (next) file so that we can query information about it
   // (it is unaccessible otherwise).
   // Since fUpperEntry is the total number of entries, loading it will retrieve the
@@ -1008,6 +1053,14 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
       AliDebugStream(3) << "Failed to retrieve cross section from xsec file. Will still attempt to get the information from the header.\n";
     }
   }
+  fIOWaitTime += ioTimer.RealTime();
+
+  // Start opening the following file while this one is embedded. When loading past the end
+  // of the chain, the restart from the first file follows directly and picks up the request.
+  if (fFileNumber < fMaxNumberOfFiles) {
+    ReleasePrefetchedFiles(false);
+    PrefetchNextFile();
+  }
 
   AliDebug(2, TString::Format("Will start embedding file %i beginning from entry %i (entry %i within the file). NOTE: This file number is not equal to the absolute file number in the file list!", fFileNumber, fCurrentEntry, fCurrentEntry - fLowerEntry));
   // NOTE: Cannot use this print message, as it is possible that fMaxNumberOfFiles != fFilenames.size() because
@@ -1021,6 +1074,71 @@ void AliAnalysisTaskEmcalEmbeddingHelper::InitTree()
   fInitializedNewFile = kTRUE;
 }
 
+/**
+ * Request the asynchronous opening of the file following the current one in the TChain, together
+ * with its pythia cross section file. When the TChain switches to the next tree, TFile::Open() picks
+ * up the pending request, so that for remote files the connection and the reading of the file header
+ * overlap with the embedding of the current file instead of stalling the train at the file boundary.
+ * At the end of the chain the first file is requested, as embedding restarts from there.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::PrefetchNextFile()
+{
+  if (!fPrefetchNextFile || !fChain) return;
+
+  Int_t nextFileNumber = fFileNumber + 1;
+  if (nextFileNumber >= fMaxNumberOfFiles) {
+    nextFileNumber = 0;
+  }
+  // Nothing to do if there is only one file or the request was already sent
+  if (nextFileNumber == fFileNumber || nextFileNumber == fPrefetchedFileNumber) return;
+
+  TChainElement * element = static_cast<TChainElement *>(fChain->GetListOfFiles()->At(nextFileNumber));
+  if (!element) return;
+
+  AliDebugStream(2) << "Requesting asynchronous open of the next file to embed \"" << element->GetTitle() << "\"\n";
+  fPrefetchHandle = TFile::AsyncOpen(element->GetTitle());
+  if (static_cast<Int_t>(fPythiaCrossSectionFilenames.size()) > nextFileNumber) {
+    fPrefetchXSecHandle = TFile::AsyncOpen(fPythiaCrossSectionFilenames.at(nextFileNumber).c_str());
+  }
+  fPrefetchedFileNumber = nextFileNumber;
+}
+
+/**
+ * Release the asynchronous open requests of PrefetchNextFile() once the new tree is initialized.
+ * A request picked up by TFile::Open() is owned by the opened file. A request which was not picked
+ * up (the chain moved to another file, the cross section file was not read, or the task is deleted
+ * before reaching the file) stays pending in TFile forever, together with its connection. It is
+ * therefore completed here and the file is closed and deleted, which also deletes the handle.
+ *
+ * @param[in] abandon If true, all pending requests are released, regardless of the current file
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::ReleasePrefetchedFiles(bool abandon)
+{
+  if (fPrefetchedFileNumber < 0) return;
+
+  // The chain opens its files with TFile::Open(), the cross section file is opened by fFileNumber
+  bool treeConsumed = !abandon && fChain && fChain->GetTreeNumber() == fPrefetchedFileNumber;
+  bool xsecConsumed = !abandon && fFileNumber == fPrefetchedFileNumber;
+  TFileOpenHandle * handles[2] = {treeConsumed ? nullptr : fPrefetchHandle, xsecConsumed ? nullptr : fPrefetchXSecHandle};
+  for (auto handle : handles) {
+    if (!handle) continue;
+    AliDebugStream(2) << "Releasing unused asynchronous open request for \"" << handle->GetUrl() << "\"\n";
+    TFile * file = TFile::Open(handle);
+    if (file) {
+      file->Close();
+      delete file;
+    }
+    else {
+      // A failed open does not adopt the handle
+      delete handle;
+    }
+  }
+
+  fPrefetchHandle = nullptr;
+  fPrefetchXSecHandle = nullptr;
+  fPrefetchedFileNumber = -1;
+}
+
 /**
  * Extract pythia information from a cross section file. Modified from AliAnalysisTaskEmcal::PythiaInfoFromFile().
  *
@@ -1208,6 +1326,8 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "Random file access: " << fRandomFileAccess << "\n";
   tempSS << "Starting file index: " << fFilenameIndex << "\n";
   tempSS << "Number of files to embed: " << fFilenames.size() << "\n";
+  tempSS << "Tree cache size: " << fTreeCacheSize << "\n";
+  tempSS << "Prefetch next file: " << fPrefetchNextFile << "\n";
 
   std::bitset<32> triggerMask(fTriggerMask);
   tempSS << "\nEmbedded event settings:\n";
@@ -19,6 +19,7 @@
 class TString;
 class TChain;
 class TFile;
+class TFileOpenHandle;
 class AliVEvent;
 class AliVHeader;
 class AliGenPythiaEventHeader;
@@ -97,6 +98,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t GetStartingFileIndex()                              const { return fFilenameIndex; }
   TString GetFileListFilename()                             const { return fFileListFilename; }
   bool GetCreateHistos()                                    const { return fCreateHisto; }
+  Long64_t GetTreeCacheSize()                               const { return fTreeCacheSize; }
+  bool GetPrefetchNextFile()                                const { return fPrefetchNextFile; }
+  /// Real time (in s) spent waiting for the embedded input (GetEntry and opening of new files)
+  Double_t GetIOWaitTime()                                  const { return fIOWaitTime; }
 
   // Set
   /// Set the pt hard bin which will be added into the file pattern. Can also be omitted and set directly in the pattern.
@@ -129,6 +134,13 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetFileListFilename(const char * filename)                 { fFileListFilename = filename; }
   /// Create QA histograms. These are necessary for proper scaling, so be careful disabling them!
   void SetCreateHistos(bool b)                                    { fCreateHisto = b; }
+  /// Size (in bytes) of the TTreeCache of the embedded input chain, which reads all branches. 0 disables the cache,
+  /// negative values (default) keep the ROOT settings. The cache memory is held for the whole job, e.g. 50 MB are a good
+  /// choice for remote input if the memory budget of the job allows it
+  void SetTreeCacheSize(Long64_t size)                            { fTreeCacheSize = size; }
+  /// Request the next file of the chain (and its cross section file) to be opened asynchronously while the current file is embedded.
+  /// Off by default: up to two extra files and their connections (with read buffers) are kept open at the same time
+  void SetPrefetchNextFile(bool b = true)                         { fPrefetchNextFile = b; }
   /* @} */
 
   /**
@@ -187,6 +199,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
   void            InitTree()            ;
+  void            PrefetchNextFile()    ;
+  void            ReleasePrefetchedFiles(bool abandon);
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
 
   UInt_t                                        fTriggerMask;       ///<  Trigger selection mask
@@ -207,6 +221,8 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t                                        fRandomEventNumberAccess; ///<  If true, it will start embedding from a random entry in the file rather than from the first
   Bool_t                                        fRandomFileAccess ; ///< If true, it will start embedding from a random file in the input files list
   bool                                          fCreateHisto      ; ///< If true, create QA histograms
+  Long64_t                                      fTreeCacheSize    ; ///< Size of the TTreeCache of the embedded input chain (0 to disable, negative to keep the ROOT default)
+  bool                                          fPrefetchNextFile ; ///< If true, open the next file asynchronously while the current one is embedded
 
   TString                                       fFilePattern      ; ///<  File pattern to select AliEn files using alien_find
   TString                                       fInputFilename    ; ///<  Filename of input root files
@@ -222,6 +238,10 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Int_t                                         fOffset           ; //!<! Offset from fLowerEntry where the loop over the tree should start
   Int_t                                         fMaxNumberOfFiles ; //!<! Max number of files that are in the TChain
   Int_t                                         fFileNumber       ; //!<! File number corresponding to the current tree
+  Int_t                                         fPrefetchedFileNumber; //!<! File number for which the asynchronous open was requested
+  TFileOpenHandle                              *fPrefetchHandle   ; //!<! Pending asynchronous open of the next file of the chain
+  TFileOpenHandle                              *fPrefetchXSecHandle; //!<! Pending asynchronous open of the next cross section file
+  Double_t                                      fIOWaitTime       ; //!<! Real time (in s) spent waiting for the embedded input
   THistManager                                  fHistManager      ; ///< Manages access to all histograms
   AliEmcalList                                 *fOutput           ; //!<! List which owns the output histograms to be saved
   AliVEvent                                    *fExternalEvent    ; //!<! Current external event available for embedding
@@ -241,7 +261,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 4);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 5);
   /// \endcond
 };
 #endif
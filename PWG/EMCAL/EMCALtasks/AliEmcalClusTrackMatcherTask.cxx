@@ -5,8 +5,12 @@
 
 #include "AliEmcalClusTrackMatcherTask.h"
 
+#include <vector>
+
 #include <TClonesArray.h>
 #include <TClass.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include <AliAODCaloCluster.h>
 #include <AliESDCaloCluster.h>
@@ -18,6 +22,7 @@
 #include "AliEmcalParticle.h"
 #include "AliParticleContainer.h"
 #include "AliClusterContainer.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 
 ClassImp(AliEmcalClusTrackMatcherTask)
 
@@ -32,6 +37,7 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask() :
   fAttachEmcalParticles(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseMatchingGrid(kTRUE),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
@@ -62,6 +68,7 @@ AliEmcalClusTrackMatcherTask::AliEmcalClusTrackMatcherTask(const char *name, Boo
   fAttachEmcalParticles(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseMatchingGrid(kTRUE),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
@@ -283,17 +290,38 @@ void AliEmcalClusTrackMatcherTask::DoMatching()
 
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Cluster positions, calculated once per cluster instead of once per track-cluster pair
+  // (same calculation as in GetEtaPhiDiff, so that the differences are identical)
+  std::vector<Double_t> clusterEta(fNEmcalClusters), clusterPhi(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    clusterEta[icluster] = cpos.Eta();
+    clusterPhi[icluster] = cpos.Phi();
+  }
+
+  // Bucket the clusters in eta-phi, such that each track is only tested against the clusters
+  // in the neighbouring cells. A distance of 0 disables the bucketing (all clusters are tested)
+  AliEmcalClusterEtaPhiGrid grid;
+  grid.Build(clusterEta, clusterPhi, fUseMatchingGrid ? fMaxDistance : 0.);
+  std::vector<Int_t> candidates;
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    const Double_t veta = track->GetTrackEtaOnEMCal();
+    const Double_t vphi = track->GetTrackPhiOnEMCal();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    grid.GetCandidates(veta, vphi, candidates);
+    for (std::vector<Int_t>::const_iterator icand = candidates.begin(); icand != candidates.end(); ++icand) {
+      const Int_t icluster = *icand;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
 
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
+      Double_t deta = veta - clusterEta[icluster];
+      Double_t dphi = TVector2::Phi_mpi_pi(vphi - clusterPhi[icluster]);
       Double_t d2 = deta * deta + dphi * dphi;
       if (d2 > maxd2) continue;
 
@@ -17,6 +17,7 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   void          SetAttachEmcalParticles(Bool_t b) { fAttachEmcalParticles  = b; }
   void          SetUpdateTracks(Bool_t b)         { fUpdateTracks          = b; }
   void          SetUpdateClusters(Bool_t b)       { fUpdateClusters        = b; }
+  void          SetUseMatchingGrid(Bool_t b)      { fUseMatchingGrid       = b; }
 
  protected:
   void          ExecOnce();
@@ -37,6 +38,7 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   Bool_t        fAttachEmcalParticles;  // attach emcal particles to the event, so that other tasks can use them
   Bool_t        fUpdateTracks;          // update tracks with matching info
   Bool_t        fUpdateClusters;        // update clusters with matching info
+  Bool_t        fUseMatchingGrid;       // only test clusters in neighbouring eta-phi cells of the track (same result as testing all)
 
   TClonesArray *fEmcalTracks;           //!emcal tracks
   TClonesArray *fEmcalClusters;         //!emcal clusters
@@ -51,6 +53,6 @@ class AliEmcalClusTrackMatcherTask : public AliAnalysisTaskEmcal {
   AliEmcalClusTrackMatcherTask(const AliEmcalClusTrackMatcherTask&);            // not implemented
   AliEmcalClusTrackMatcherTask &operator=(const AliEmcalClusTrackMatcherTask&); // not implemented
 
-  ClassDef(AliEmcalClusTrackMatcherTask, 8) // Cluster-Track matching task
+  ClassDef(AliEmcalClusTrackMatcherTask, 9) // Cluster-Track matching task
 };
 #endif
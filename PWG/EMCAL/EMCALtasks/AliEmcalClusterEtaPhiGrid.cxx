@@ -0,0 +1,136 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliEmcalClusterEtaPhiGrid.h"
+
+const Int_t AliEmcalClusterEtaPhiGrid::kMaxCells = 16384;
+
+/**
+ * Default constructor
+ */
+AliEmcalClusterEtaPhiGrid::AliEmcalClusterEtaPhiGrid() :
+  fUseGrid(kFALSE),
+  fNClusters(0),
+  fNEta(0),
+  fNPhi(0),
+  fEtaMin(0),
+  fEtaMax(0),
+  fEtaCellSize(0),
+  fPhiCellSize(0),
+  fCellStart(),
+  fCellClusters()
+{
+}
+
+/**
+ * Sort the clusters into the grid.
+ * @param[in] eta Cluster \f$\eta\f$, indexed by cluster
+ * @param[in] phi Cluster \f$\phi\f$, indexed by cluster
+ * @param[in] maxDistance Matching distance in \f$\eta\f$-\f$\phi\f$
+ */
+void AliEmcalClusterEtaPhiGrid::Build(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, Double_t maxDistance)
+{
+  fNClusters = eta.size();
+  fUseGrid = kFALSE;
+  fNEta = fNPhi = 0;
+  fCellStart.clear();
+  fCellClusters.clear();
+
+  // A zero distance only matches identical positions: test all clusters
+  Double_t cellSize = TMath::Abs(maxDistance);
+  if (!fNClusters || !(cellSize > 0) || !TMath::Finite(cellSize)) return;
+
+  fEtaMin = fEtaMax = eta[0];
+  for (Int_t icl = 0; icl < fNClusters; icl++) {
+    if (!TMath::Finite(eta[icl]) || !TMath::Finite(phi[icl])) return;
+    fEtaMin = TMath::Min(fEtaMin, eta[icl]);
+    fEtaMax = TMath::Max(fEtaMax, eta[icl]);
+  }
+
+  // Cells slightly larger than the matching distance, such that rounding in the
+  // cell index calculation cannot move a match beyond the neighbouring cell
+  cellSize *= 1.01;
+  while (kTRUE) {
+    fNEta = Int_t((fEtaMax - fEtaMin) / cellSize) + 1;
+    fNPhi = TMath::Max(1, Int_t(TMath::TwoPi() / cellSize));
+    if (Double_t(fNEta) * fNPhi <= kMaxCells) break;
+    cellSize *= 2;
+  }
+  // Each track would test all clusters anyway
+  if (fNEta < 3 && fNPhi < 3) return;
+  fEtaCellSize = cellSize;
+  fPhiCellSize = TMath::TwoPi() / fNPhi;
+
+  // Counting sort of the clusters into the cells, preserving the cluster order within a cell
+  std::vector<Int_t> cellOfCluster(fNClusters);
+  fCellStart.assign(fNEta * fNPhi + 1, 0);
+  for (Int_t icl = 0; icl < fNClusters; icl++) {
+    Int_t ieta = TMath::Min(Int_t((eta[icl] - fEtaMin) / fEtaCellSize), fNEta - 1);
+    cellOfCluster[icl] = ieta * fNPhi + GetPhiCell(phi[icl]);
+    fCellStart[cellOfCluster[icl] + 1]++;
+  }
+  for (Int_t icell = 0; icell < fNEta * fNPhi; icell++) fCellStart[icell + 1] += fCellStart[icell];
+  std::vector<Int_t> fill(fCellStart.begin(), fCellStart.end() - 1);
+  fCellClusters.resize(fNClusters);
+  for (Int_t icl = 0; icl < fNClusters; icl++) fCellClusters[fill[cellOfCluster[icl]]++] = icl;
+
+  fUseGrid = kTRUE;
+}
+
+/**
+ * Get the phi cell of a given angle, mapped into \f$[0, 2\pi)\f$.
+ * @param[in] phi Azimuthal angle
+ * @return Cell index in phi
+ */
+Int_t AliEmcalClusterEtaPhiGrid::GetPhiCell(Double_t phi) const
+{
+  Int_t iphi = Int_t(TVector2::Phi_0_2pi(phi) / fPhiCellSize);
+  return TMath::Min(TMath::Max(iphi, 0), fNPhi - 1);
+}
+
+/**
+ * Find the clusters which can be within the matching distance of a given position.
+ * @param[in] eta Track \f$\eta\f$ on the EMCal surface
+ * @param[in] phi Track \f$\phi\f$ on the EMCal surface
+ * @param[out] candidates Indices of the candidate clusters, in increasing order
+ */
+void AliEmcalClusterEtaPhiGrid::GetCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const
+{
+  candidates.clear();
+  if (!fUseGrid || !TMath::Finite(eta) || !TMath::Finite(phi)) {
+    for (Int_t icl = 0; icl < fNClusters; icl++) candidates.push_back(icl);
+    return;
+  }
+
+  // Outside the eta range of the clusters by more than one cell: no match possible
+  if (eta < fEtaMin - fEtaCellSize || eta > fEtaMax + fEtaCellSize) return;
+
+  const Int_t ieta = Int_t(TMath::Floor((eta - fEtaMin) / fEtaCellSize)),
+              iphi = GetPhiCell(phi);
+  // With less than three cells in phi all of them are neighbours
+  const Int_t nphi = TMath::Min(fNPhi, 3);
+  for (Int_t jeta = TMath::Max(ieta - 1, 0); jeta <= TMath::Min(ieta + 1, fNEta - 1); jeta++) {
+    for (Int_t dphi = 0; dphi < nphi; dphi++) {
+      const Int_t jphi = (iphi + fNPhi - 1 + dphi) % fNPhi;
+      const Int_t icell = jeta * fNPhi + jphi;
+      candidates.insert(candidates.end(), fCellClusters.begin() + fCellStart[icell], fCellClusters.begin() + fCellStart[icell + 1]);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+}
@@ -0,0 +1,51 @@
+#ifndef ALIEMCALCLUSTERETAPHIGRID_H
+#define ALIEMCALCLUSTERETAPHIGRID_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <Rtypes.h>
+
+/**
+ * @class AliEmcalClusterEtaPhiGrid
+ * @brief Bucketing of clusters in \f$\eta\f$-\f$\phi\f$ for the cluster-track matching
+ * @ingroup EMCALFWTASKS
+ *
+ * The clusters are sorted into a grid of cells in \f$\eta\f$ and \f$\phi\f$ with a cell
+ * size of at least the matching distance. All clusters which can be within the matching
+ * distance of a given track are therefore found in the cell of the track or in one of its
+ * eight neighbours (cyclic in \f$\phi\f$), so that the number of track-cluster pairs to test
+ * scales with the local cluster density instead of the total number of clusters.
+ *
+ * Candidates are returned sorted by cluster index, so a matcher looping over them
+ * visits the clusters in the same order as a loop over all clusters. If any position is
+ * not finite the grid is not used and all clusters are returned as candidates.
+ */
+class AliEmcalClusterEtaPhiGrid {
+ public:
+  AliEmcalClusterEtaPhiGrid();
+  virtual ~AliEmcalClusterEtaPhiGrid() {}
+
+  void          Build(const std::vector<Double_t> &eta, const std::vector<Double_t> &phi, Double_t maxDistance);
+  void          GetCandidates(Double_t eta, Double_t phi, std::vector<Int_t> &candidates) const;
+  Bool_t        IsGridUsed()                const { return fUseGrid      ; }
+  Int_t         GetNEtaCells()              const { return fNEta         ; }
+  Int_t         GetNPhiCells()              const { return fNPhi         ; }
+
+  static const Int_t kMaxCells;                   ///< Maximum number of cells, the cell size is increased beyond
+
+ protected:
+  Int_t         GetPhiCell(Double_t phi) const;
+
+  Bool_t              fUseGrid;                   ///< False if all clusters have to be tested (non-finite positions, no clusters)
+  Int_t               fNClusters;                 ///< Number of clusters in the grid
+  Int_t               fNEta;                      ///< Number of cells in eta
+  Int_t               fNPhi;                      ///< Number of cells in phi
+  Double_t            fEtaMin;                    ///< Lower eta edge of the grid
+  Double_t            fEtaMax;                    ///< Upper eta edge of the clusters in the grid
+  Double_t            fEtaCellSize;               ///< Cell size in eta
+  Double_t            fPhiCellSize;               ///< Cell size in phi
+  std::vector<Int_t>  fCellStart;                 ///< Index of the first cluster of each cell in fCellClusters (size fNEta*fNPhi+1)
+  std::vector<Int_t>  fCellClusters;              ///< Cluster indices, ordered by cell and by index within a cell
+};
+#endif
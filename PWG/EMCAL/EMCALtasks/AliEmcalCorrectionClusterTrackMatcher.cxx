@@ -3,8 +3,12 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <vector>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TVector2.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -13,6 +17,7 @@
 #include "AliAODCaloCluster.h"
 #include "AliVParticle.h"
 #include "AliEmcalParticle.h"
+#include "AliEmcalClusterEtaPhiGrid.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
 
@@ -37,6 +42,7 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseDCA(kTRUE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fUseMatchingGrid(kTRUE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
@@ -81,6 +87,7 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("useMatchingGrid", fUseMatchingGrid);
   fDoPropagation = fEsdMode;
   
   Bool_t enableFracEMCRecalc = kFALSE;
@@ -357,17 +364,38 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
 
+  // Cluster positions, calculated once per cluster instead of once per track-cluster pair
+  // (same calculation as in GetEtaPhiDiff, so that the differences are identical)
+  std::vector<Double_t> clusterEta(fNEmcalClusters), clusterPhi(fNEmcalClusters);
+  for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    AliVCluster* cluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster))->GetCluster();
+    Float_t pos[3] = {0};
+    cluster->GetPosition(pos);
+    TVector3 cpos(pos);
+    clusterEta[icluster] = cpos.Eta();
+    clusterPhi[icluster] = cpos.Phi();
+  }
+
+  // Bucket the clusters in eta-phi, such that each track is only tested against the clusters
+  // in the neighbouring cells. A distance of 0 disables the bucketing (all clusters are tested)
+  AliEmcalClusterEtaPhiGrid grid;
+  grid.Build(clusterEta, clusterPhi, fUseMatchingGrid ? fMaxDistance : 0.);
+  std::vector<Int_t> candidates;
+
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
+    const Double_t veta = track->GetTrackEtaOnEMCal();
+    const Double_t vphi = track->GetTrackPhiOnEMCal();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    grid.GetCandidates(veta, vphi, candidates);
+    for (std::vector<Int_t>::const_iterator icand = candidates.begin(); icand != candidates.end(); ++icand) {
+      const Int_t icluster = *icand;
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
-      Double_t deta = 999;
-      Double_t dphi = 999;
-      GetEtaPhiDiff(track, cluster, dphi, deta);
+      Double_t deta = veta - clusterEta[icluster];
+      Double_t dphi = TVector2::Phi_mpi_pi(vphi - clusterPhi[icluster]);
       Double_t d2 = deta * deta + dphi * dphi;
 
       if (d2 > maxd2) continue;
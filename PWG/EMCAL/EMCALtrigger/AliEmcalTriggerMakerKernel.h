@@ -23,6 +23,7 @@ class AliVVZERO;
 template<class T> class AliEMCALTriggerDataGrid;
 template<class T> class AliEMCALTriggerAlgorithm;
 template<class T> class AliEMCALTriggerPatchFinder;
+class AliEmcalTriggerSummedAreaPatchFinder;
 
 // To be moved to AliRoot in AliEMCALTriggerConstants.h at the first occasion
 namespace EMCALTrigger {
@@ -361,6 +362,20 @@ public:
    */
   void SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
 
+  /**
+   * @brief Use patch finders based on summed-area tables
+   *
+   * Instead of summing the FastORs of each patch, the data grids are
+   * integrated once per event and all patch sums (L0, gamma, jet and
+   * background patches) are obtained from the integrated grids. The
+   * resulting patches have the same positions, sizes and trigger bits as the
+   * ones of the default patch finder and identical online ADC sums; offline
+   * ADC sums agree within the floating-point tolerance of
+   * AliEmcalTriggerSummedAreaPatchFinder::GetTolerance().
+   * @param[in] doUse If true the summed-area patch finders are used
+   */
+  void SetUseSummedAreaPatchFinder(Bool_t doUse = kTRUE) { fUseSummedAreaPatchFinder = doUse; }
+
   /**
    * @brief Set energy-dependent models for gaussian energy smearing
    * @param[in] mean Parameterization of the mean
@@ -466,6 +481,9 @@ protected:
 
   AliEMCALTriggerPatchFinder<double>       *fPatchFinder;                 ///< The actual patch finder
   AliEMCALTriggerAlgorithm<double>         *fLevel0PatchFinder;           ///< Patch finder for Level0 patches
+  AliEmcalTriggerSummedAreaPatchFinder     *fSummedAreaPatchFinder;       ///< Summed-area patch finder for Level1 patches
+  AliEmcalTriggerSummedAreaPatchFinder     *fLevel0SummedAreaPatchFinder; ///< Summed-area patch finder for Level0 patches
+  Bool_t                                    fUseSummedAreaPatchFinder;    ///< Use summed-area patch finders instead of the default patch finders
   Int_t                                     fL0MinTime;                   ///< Minimum L0 time
   Int_t                                     fL0MaxTime;                   ///< Maximum L0 time
   Int_t                                     fMinCellAmp;                  ///< Minimum offline amplitude of the cells used to generate the patches
@@ -496,7 +514,7 @@ protected:
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
@@ -171,6 +171,18 @@ public:
     if(fTriggerMaker) fTriggerMaker->SetApplyOnlineBadChannelMaskingToOffline(doApply);
   }
 
+  /**
+   * @brief Use summed-area patch finders in the trigger maker kernel.
+   *
+   * Patches agree with the default patch finder within the floating-point
+   * tolerance of the offline ADC sums, which are obtained from integrated data
+   * grids (see AliEmcalTriggerSummedAreaPatchFinder::GetTolerance()).
+   * @param[in] doUse If true the summed-area patch finders are used
+   */
+  void SetUseSummedAreaPatchFinder(Bool_t doUse = kTRUE) {
+    if(fTriggerMaker) fTriggerMaker->SetUseSummedAreaPatchFinder(doUse);
+  }
+
   void SetTriggerThresholdJetLow   ( Int_t a, Int_t b, Int_t c ) {
     if(fTriggerMaker) fTriggerMaker->SetTriggerThresholdJetLow(a, b, c);
   }
@@ -0,0 +1,188 @@
+/**************************************************************************
+ * Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <limits>
+
+#include <TMath.h>
+
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEMCALTriggerRawPatch.h"
+#include "AliEmcalTriggerSummedAreaPatchFinder.h"
+#include "AliLog.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTriggerSummedAreaPatchFinder)
+/// \endcond
+
+AliEmcalTriggerSummedAreaPatchFinder::AliEmcalTriggerSummedAreaPatchFinder():
+  TObject(),
+  fRowMin(),
+  fRowMax(),
+  fBitMask(),
+  fPatchSize(),
+  fSubregionSize(),
+  fThreshold(),
+  fOfflineThreshold(),
+  fNCols(0),
+  fNRows(0),
+  fADC(nullptr),
+  fOfflineADC(nullptr),
+  fADCTolerance(0.),
+  fOfflineADCTolerance(0.),
+  fADCSums(),
+  fOfflineADCSums(),
+  fADCCounts(),
+  fOfflineADCCounts()
+{
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::AddTriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize,
+    Double_t threshold, Double_t offlineThreshold)
+{
+  if (patchSize <= 0 || subregionSize <= 0) {
+    AliError(Form("Invalid patch size (%d) or subregion size (%d), algorithm not added", patchSize, subregionSize));
+    return;
+  }
+  fRowMin.push_back(rowmin);
+  fRowMax.push_back(rowmax);
+  fBitMask.push_back(bitmask);
+  fPatchSize.push_back(patchSize);
+  fSubregionSize.push_back(subregionSize);
+  fThreshold.push_back(threshold);
+  fOfflineThreshold.push_back(offlineThreshold);
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::Reset()
+{
+  fRowMin.clear();
+  fRowMax.clear();
+  fBitMask.clear();
+  fPatchSize.clear();
+  fSubregionSize.clear();
+  fThreshold.clear();
+  fOfflineThreshold.clear();
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::Fill(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc)
+{
+  if (adc.GetNumberOfCols() != offlineAdc.GetNumberOfCols() || adc.GetNumberOfRows() != offlineAdc.GetNumberOfRows()) {
+    AliError(Form("Online (%d x %d) and offline (%d x %d) data grids differ in size",
+        adc.GetNumberOfCols(), adc.GetNumberOfRows(), offlineAdc.GetNumberOfCols(), offlineAdc.GetNumberOfRows()));
+  }
+  fNCols = TMath::Min(adc.GetNumberOfCols(), offlineAdc.GetNumberOfCols());
+  fNRows = TMath::Min(adc.GetNumberOfRows(), offlineAdc.GetNumberOfRows());
+  fADC = &adc;
+  fOfflineADC = &offlineAdc;
+  BuildTables(adc, fADCSums, fADCCounts, fADCTolerance);
+  BuildTables(offlineAdc, fOfflineADCSums, fOfflineADCCounts, fOfflineADCTolerance);
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::BuildTables(const AliEMCALTriggerDataGrid<double> &grid, std::vector<Double_t> &sums, std::vector<Int_t> &counts, Double_t &tolerance) const
+{
+  // Tables have one leading row and column of zeros, so that
+  // entry (row, col) is the sum of all values below row and col
+  const Int_t stride = fNCols + 1;
+  sums.assign((fNRows + 1) * stride, 0.);
+  counts.assign((fNRows + 1) * stride, 0);
+  Bool_t integral = kTRUE;
+  Double_t abssum = 0.;
+  for (Int_t irow = 0; irow < fNRows; irow++) {
+    Double_t rowsum = 0.;
+    Int_t rowcount = 0;
+    for (Int_t icol = 0; icol < fNCols; icol++) {
+      const Double_t val = grid(icol, irow);
+      // Integers up to 2^31 are summed without rounding in any order
+      if (integral && (val != TMath::Floor(val) || TMath::Abs(val) > 2147483647.)) integral = kFALSE;
+      rowsum += val;
+      abssum += TMath::Abs(val);
+      if (val != 0.) rowcount++;
+      sums[(irow + 1) * stride + icol + 1] = sums[irow * stride + icol + 1] + rowsum;
+      counts[(irow + 1) * stride + icol + 1] = counts[irow * stride + icol + 1] + rowcount;
+    }
+  }
+  // Each table entry is a sum of at most fNCols + fNRows partial sums, each
+  // bounded by the sum of absolute values, and a patch sum combines four
+  // entries. The sum in grid order adds at most fNCols * fNRows values.
+  tolerance = integral ? 0. : (4. * (fNCols + fNRows + 1) + fNCols * fNRows) * abssum * std::numeric_limits<Double_t>::epsilon();
+}
+
+Double_t AliEmcalTriggerSummedAreaPatchFinder::GetPatchSum(Int_t col, Int_t row, Int_t size, Bool_t offline) const
+{
+  const Int_t colstart = TMath::Min(TMath::Max(col, 0), fNCols),
+              rowstart = TMath::Min(TMath::Max(row, 0), fNRows),
+              colend = TMath::Min(TMath::Max(col + size, 0), fNCols),
+              rowend = TMath::Min(TMath::Max(row + size, 0), fNRows);
+  const std::vector<Int_t> &counts = offline ? fOfflineADCCounts : fADCCounts;
+  if (counts.empty() || !GetRectangle(counts, colstart, rowstart, colend, rowend)) return 0.;
+  return GetRectangle(offline ? fOfflineADCSums : fADCSums, colstart, rowstart, colend, rowend);
+}
+
+Double_t AliEmcalTriggerSummedAreaPatchFinder::GetPatchSumFromGrid(Int_t col, Int_t row, Int_t size, Bool_t offline) const
+{
+  const Int_t colstart = TMath::Min(TMath::Max(col, 0), fNCols),
+              rowstart = TMath::Min(TMath::Max(row, 0), fNRows),
+              colend = TMath::Min(TMath::Max(col + size, 0), fNCols),
+              rowend = TMath::Min(TMath::Max(row + size, 0), fNRows);
+  if (!GetRectangle(offline ? fOfflineADCCounts : fADCCounts, colstart, rowstart, colend, rowend)) return 0.;
+  const AliEMCALTriggerDataGrid<double> &grid = offline ? *fOfflineADC : *fADC;
+  Double_t sum = 0.;
+  for (Int_t jrow = rowstart; jrow < rowend; jrow++) {
+    for (Int_t jcol = colstart; jcol < colend; jcol++) {
+      sum += grid(jcol, jrow);
+    }
+  }
+  return sum;
+}
+
+Bool_t AliEmcalTriggerSummedAreaPatchFinder::IsAboveThreshold(Double_t &sum, Double_t threshold, Int_t col, Int_t row, Int_t size, Bool_t offline) const
+{
+  const Double_t tolerance = offline ? fOfflineADCTolerance : fADCTolerance;
+  if (tolerance > 0. && TMath::Abs(sum - threshold) <= tolerance) sum = GetPatchSumFromGrid(col, row, size, offline);
+  return sum > threshold;
+}
+
+std::vector<AliEMCALTriggerRawPatch> AliEmcalTriggerSummedAreaPatchFinder::FindPatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc)
+{
+  Fill(adc, offlineAdc);
+  return FindPatches();
+}
+
+std::vector<AliEMCALTriggerRawPatch> AliEmcalTriggerSummedAreaPatchFinder::FindPatches() const
+{
+  std::vector<AliEMCALTriggerRawPatch> result;
+  if (!fADC || !fOfflineADC) {
+    AliError("No data grids provided - call Fill before searching for patches");
+    return result;
+  }
+  for (UInt_t ialgo = 0; ialgo < fRowMin.size(); ialgo++) {
+    const Int_t size = fPatchSize[ialgo], step = fSubregionSize[ialgo],
+                rowStartMax = fRowMax[ialgo] - (size - 1),
+                colStartMax = fNCols - size;
+    for (Int_t irow = fRowMin[ialgo]; irow <= rowStartMax; irow += step) {
+      for (Int_t icol = 0; icol <= colStartMax; icol += step) {
+        Double_t sumadc = GetPatchSum(icol, irow, size, kFALSE),
+                 sumofflineAdc = GetPatchSum(icol, irow, size, kTRUE);
+        // Both checks are needed, so that borderline sums are always taken from the grid
+        const Bool_t onlineAbove = IsAboveThreshold(sumadc, fThreshold[ialgo], icol, irow, size, kFALSE),
+                     offlineAbove = IsAboveThreshold(sumofflineAdc, fOfflineThreshold[ialgo], icol, irow, size, kTRUE);
+        if (onlineAbove || offlineAbove) {
+          AliEMCALTriggerRawPatch recpatch(icol, irow, size, sumadc, sumofflineAdc);
+          recpatch.SetBitmask(fBitMask[ialgo]);
+          result.push_back(recpatch);
+        }
+      }
+    }
+  }
+  return result;
+}
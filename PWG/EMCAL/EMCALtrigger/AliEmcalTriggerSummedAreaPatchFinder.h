@@ -0,0 +1,206 @@
+#ifndef ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H
+#define ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H
+/* Copyright(c) 1998-2018, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliEMCALTriggerRawPatch;
+template<class T> class AliEMCALTriggerDataGrid;
+
+/**
+ * @class AliEmcalTriggerSummedAreaPatchFinder
+ * @brief Patch finder based on summed-area tables (integral images)
+ * @ingroup EMCALTRGFW
+ * @since Oct. 19th, 2018
+ *
+ * Alternative to AliEMCALTriggerPatchFinder / AliEMCALTriggerAlgorithm:
+ * the online and offline data grids are integrated once per event into
+ * summed-area tables, after which the sum of any rectangular patch is
+ * obtained from four table lookups, independent of the patch size. All
+ * registered algorithms (gamma, jet, background, L0, ...) therefore share
+ * one pass over the FastOR grid, and patches can be searched again with
+ * a different configuration without touching the grids.
+ *
+ * The output agrees with the one of AliEMCALTriggerPatchFinder configured
+ * with the same algorithms, within the tolerance of the offline sums below:
+ * - patches are produced in the order of the algorithms, and for each
+ *   algorithm row by row in steps of the subregion size,
+ * - a patch is accepted if the online or offline sum is above the
+ *   corresponding threshold,
+ * - FastORs outside the grid do not contribute to the patch sum.
+ * Sums from the table are exact for grids with integer values. For other
+ * grids (i.e. the offline ADC from cell energies) they agree with the sums
+ * of AliEMCALTriggerAlgorithm within a rounding tolerance determined when
+ * the table is built. Only patches whose table sum is within this tolerance
+ * of a threshold are summed again in the order used by
+ * AliEMCALTriggerAlgorithm, so that the same patches are accepted. Empty
+ * patches are identified from a table of non-zero FastORs.
+ */
+class AliEmcalTriggerSummedAreaPatchFinder : public TObject {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  AliEmcalTriggerSummedAreaPatchFinder();
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~AliEmcalTriggerSummedAreaPatchFinder() {}
+
+  /**
+   * @brief Add trigger algorithm
+   * @param[in] rowmin Minimum row value
+   * @param[in] rowmax Maximum row value
+   * @param[in] bitmask Offline bit mask to be applied to the patches
+   * @param[in] patchSize Size of the patches
+   * @param[in] subregionSize Size of the sliding sub region
+   * @param[in] threshold Threshold on the online ADC sum
+   * @param[in] offlineThreshold Threshold on the offline ADC sum
+   */
+  void AddTriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize,
+      Double_t threshold = 0., Double_t offlineThreshold = 0.);
+
+  /**
+   * @brief Remove all trigger algorithms
+   */
+  void Reset();
+
+  /**
+   * @brief Get the number of trigger algorithms
+   * @return Number of trigger algorithms
+   */
+  Int_t GetNumberOfTriggerAlgorithms() const { return fRowMin.size(); }
+
+  /**
+   * @brief Build the summed-area tables for the online and offline data grids
+   *
+   * The tables stay valid until the next call, so FindPatches() and
+   * GetPatchSum() can be used several times on the same event. The
+   * grids need to stay alive in case they contain non-integer values.
+   * @param[in] adc Online ADC (L1 time sums or L0 amplitudes)
+   * @param[in] offlineAdc Offline ADC (from cell energies)
+   */
+  void Fill(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc);
+
+  /**
+   * @brief Run all trigger algorithms on the grids from the last call to Fill()
+   * @return Raw patches found by the trigger algorithms
+   */
+  std::vector<AliEMCALTriggerRawPatch> FindPatches() const;
+
+  /**
+   * @brief Build the summed-area tables and run all trigger algorithms
+   * @param[in] adc Online ADC (L1 time sums or L0 amplitudes)
+   * @param[in] offlineAdc Offline ADC (from cell energies)
+   * @return Raw patches found by the trigger algorithms
+   */
+  std::vector<AliEMCALTriggerRawPatch> FindPatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc);
+
+  /**
+   * @brief Get the sum of a square patch from the summed-area tables of the last call to Fill()
+   *
+   * FastORs outside the grid are ignored. Exact for grids with integer
+   * values, otherwise within GetTolerance() of the sum in grid order.
+   * @param[in] col Start column of the patch
+   * @param[in] row Start row of the patch
+   * @param[in] size Patch size (in FastORs)
+   * @param[in] offline If true the sum of the offline grid is returned, otherwise of the online grid
+   * @return Sum of the patch
+   */
+  Double_t GetPatchSum(Int_t col, Int_t row, Int_t size, Bool_t offline) const;
+
+  /**
+   * @brief Get the rounding tolerance of patch sums from the tables of the last call to Fill()
+   * @param[in] offline If true the tolerance for the offline grid is returned, otherwise for the online grid
+   * @return Upper limit of the difference between table and grid-order sums (0 for integer grids)
+   */
+  Double_t GetTolerance(Bool_t offline) const { return offline ? fOfflineADCTolerance : fADCTolerance; }
+
+protected:
+
+  /**
+   * @brief Build the summed-area tables for one data grid
+   * @param[in] grid Input data grid
+   * @param[out] sums Summed-area table of the grid values
+   * @param[out] counts Summed-area table of the number of non-zero values
+   * @param[out] tolerance Upper limit of the difference between table and grid-order patch sums
+   */
+  void BuildTables(const AliEMCALTriggerDataGrid<double> &grid, std::vector<Double_t> &sums, std::vector<Int_t> &counts, Double_t &tolerance) const;
+
+  /**
+   * @brief Get the sum of a square patch by summing the grid values
+   *
+   * The values are summed in the same order as in AliEMCALTriggerAlgorithm.
+   * Used for patches whose table sum is too close to a threshold.
+   * @param[in] col Start column of the patch
+   * @param[in] row Start row of the patch
+   * @param[in] size Patch size (in FastORs)
+   * @param[in] offline If true the sum of the offline grid is returned, otherwise of the online grid
+   * @return Sum of the patch
+   */
+  Double_t GetPatchSumFromGrid(Int_t col, Int_t row, Int_t size, Bool_t offline) const;
+
+  /**
+   * @brief Check whether a patch sum is above threshold
+   *
+   * If the table sum is within the rounding tolerance of the threshold
+   * it is replaced by the sum of the grid values.
+   * @param[in,out] sum Patch sum from the table
+   * @param[in] threshold Threshold
+   * @param[in] col Start column of the patch
+   * @param[in] row Start row of the patch
+   * @param[in] size Patch size (in FastORs)
+   * @param[in] offline If true the offline grid is used, otherwise the online grid
+   * @return True if the sum is above threshold
+   */
+  Bool_t IsAboveThreshold(Double_t &sum, Double_t threshold, Int_t col, Int_t row, Int_t size, Bool_t offline) const;
+
+  /**
+   * @brief Get rectangle sum from a summed-area table
+   * @param[in] table Summed-area table
+   * @param[in] col First column (inclusive)
+   * @param[in] row First row (inclusive)
+   * @param[in] colend Last column (exclusive)
+   * @param[in] rowend Last row (exclusive)
+   * @return Sum of the rectangle
+   */
+  template<typename T>
+  T GetRectangle(const std::vector<T> &table, Int_t col, Int_t row, Int_t colend, Int_t rowend) const {
+    const Int_t stride = fNCols + 1;
+    return table[rowend * stride + colend] - table[row * stride + colend] - table[rowend * stride + col] + table[row * stride + col];
+  }
+
+  std::vector<Int_t>                         fRowMin;              ///< Minimum row per algorithm
+  std::vector<Int_t>                         fRowMax;              ///< Maximum row per algorithm
+  std::vector<UInt_t>                        fBitMask;             ///< Bitmask per algorithm
+  std::vector<Int_t>                         fPatchSize;           ///< Patch size per algorithm
+  std::vector<Int_t>                         fSubregionSize;       ///< Subregion size per algorithm
+  std::vector<Double_t>                      fThreshold;           ///< Online threshold per algorithm
+  std::vector<Double_t>                      fOfflineThreshold;    ///< Offline threshold per algorithm
+
+  Int_t                                      fNCols;               //!<! Number of columns of the current grids
+  Int_t                                      fNRows;               //!<! Number of rows of the current grids
+  const AliEMCALTriggerDataGrid<double>     *fADC;                 //!<! Current online grid
+  const AliEMCALTriggerDataGrid<double>     *fOfflineADC;          //!<! Current offline grid
+  Double_t                                   fADCTolerance;        //!<! Rounding uncertainty of online table sums
+  Double_t                                   fOfflineADCTolerance; //!<! Rounding uncertainty of offline table sums
+  std::vector<Double_t>                      fADCSums;             //!<! Summed-area table of the online grid
+  std::vector<Double_t>                      fOfflineADCSums;      //!<! Summed-area table of the offline grid
+  std::vector<Int_t>                         fADCCounts;           //!<! Summed-area table of non-zero online FastORs
+  std::vector<Int_t>                         fOfflineADCCounts;    //!<! Summed-area table of non-zero offline FastORs
+
+private:
+  AliEmcalTriggerSummedAreaPatchFinder(const AliEmcalTriggerSummedAreaPatchFinder &);
+  AliEmcalTriggerSummedAreaPatchFinder &operator=(const AliEmcalTriggerSummedAreaPatchFinder &);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTriggerSummedAreaPatchFinder, 1);
+  /// \endcond
+};
+
+#endif /* ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H */
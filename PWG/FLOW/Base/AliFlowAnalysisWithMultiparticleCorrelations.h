@@ -30,6 +30,7 @@
 #include "TStopwatch.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowGenericCorrelator.h"
 
 class AliFlowAnalysisWithMultiparticleCorrelations{
  public:
@@ -381,7 +382,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   TList *fQvectorList;           // list to hold all Q-vector objects       
   TProfile *fQvectorFlagsPro;    // profile to hold all flags for Q-vector
   Bool_t fCalculateQvector;      // to calculate or not to calculate Q-vector components, that's a Boolean...
-  TComplex fQvector[49][9];      // Q-vector components [fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1]  
+  AliFlowGenericCorrelator *fGenericCorrelator; //! Q-vector components [fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] and the generic correlators built from them
   Bool_t fCalculateDiffQvectors; // to calculate or not to calculate p- and q-vector components, that's a Boolean...  
   TComplex fpvector[100][49][9]; // p-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
   TComplex fqvector[100][49][9]; // q-vector components [bin][fMaxHarmonic*fMaxCorrelator+1][fMaxCorrelator+1] = [6*8+1][8+1] TBI hardwired 100
@@ -391,8 +392,8 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   TProfile *fCorrelationsFlagsPro;    // profile to hold all flags for correlations
   TProfile *fCorrelationsPro[2][8];   // multi-particle correlations [0=cos,1=sin][1p,2p,...,8p]
   Bool_t fCalculateCorrelations;      // calculate and store correlations
-  Int_t fMaxHarmonic;                 // 6 (not going beyond v6, if you change this value, change also fQvector[49][9]) 
-  Int_t fMaxCorrelator;               // 8 (not going beyond 8-p correlations, if you change this value, change also fQvector[49][9]) 
+  Int_t fMaxHarmonic;                 // 6 (not going beyond v6, if you change this value, change also fpvector and fqvector) 
+  Int_t fMaxCorrelator;               // 8 (not going beyond 8-p correlations, if you change this value, change also fpvector and fqvector) 
   Bool_t fCalculateIsotropic;         // calculate only isotropic correlations
   Bool_t fCalculateSame;              // calculate only 'same abs harmonics' correlations TBI 
   Bool_t fSkipZeroHarmonics;          // skip correlations which have some of the harmonicc equal to zero
@@ -476,7 +477,7 @@ class AliFlowAnalysisWithMultiparticleCorrelations{
   Int_t fHighestHarmonicEtaGaps;      // 2-p correlations with eta gaps will be calculated for harmonics [fLowestHarmonicEtaGaps,fHighestHarmonicEtaGaps]
   TProfile *fEtaGapsPro[6];           // [harmonic] different eta gaps are different bins
 
-  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,6);
+  ClassDef(AliFlowAnalysisWithMultiparticleCorrelations,7);
 
 };
 
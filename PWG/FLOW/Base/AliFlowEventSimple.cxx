@@ -1258,4 +1258,6 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  //the mothers point to tracks which are going to be reused
+  if (fMothersCollection) fMothersCollection->Clear();
 }
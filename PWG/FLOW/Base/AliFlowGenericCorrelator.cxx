@@ -0,0 +1,338 @@
+/*************************************************************************
+* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include "AliFlowGenericCorrelator.h"
+#include "TMath.h"
+
+//********************************************************************
+// AliFlowGenericCorrelator:                                         *
+// Q-vectors of one event and the generic multi-particle correlators *
+// computed from them, with the sub-sums of the recursion shared by  *
+// all harmonic combinations of the event.                           *
+//                                                                   *
+// The k-particle correlator follows from the (k-1)-particle ones:   *
+//  N(s1,...,sk) = Q(sk)*N(s1,...,sk-1)                              *
+//               - sum_j N(s1,...,sj+sk,...,sk-1)                    *
+// where each slot s = (n,p) stands for w^p exp(i*n*phi) and sj+sk   *
+// adds harmonics and powers (the particle of slot k is the one of   *
+// slot j). N does not depend on the order of the slots, so every    *
+// term is stored with its slots sorted and computed once per event, *
+// whichever correlator needs it first.                              *
+//********************************************************************
+
+ClassImp(AliFlowGenericCorrelator)
+
+//________________________________________________________________________
+
+AliFlowGenericCorrelator::AliFlowGenericCorrelator(Int_t maxHarmonic, Int_t maxCorrelator):
+ TObject(),
+ fMaxHarmonic(maxHarmonic),
+ fMaxCorrelator(maxCorrelator),
+ fNQHarmonics(0),
+ fQ(),
+ fChanged(kTRUE),
+ fMaxTableSize(1<<20),
+ fStamp(1),
+ fNEntries(0),
+ fKey(),
+ fEntryStamp(),
+ fValue(),
+ fNComputed(0),
+ fNReused(0)
+{
+ // Constructor: Q-vectors for correlators of up to maxCorrelator particles, with harmonics up to maxHarmonic.
+
+ if(fMaxCorrelator < 1 || fMaxCorrelator > kMaxCorrelator)
+ {
+  Error("AliFlowGenericCorrelator","correlators of %d particles not supported, using %d",fMaxCorrelator,kMaxCorrelator);
+  fMaxCorrelator = kMaxCorrelator;
+ }
+ if(fMaxHarmonic < 0 || fMaxHarmonic*fMaxCorrelator >= kHarmonicOffset)
+ {
+  Error("AliFlowGenericCorrelator","harmonic %d not supported, using 6",fMaxHarmonic);
+  fMaxHarmonic = 6;
+ }
+ fNQHarmonics = fMaxHarmonic*fMaxCorrelator+1;
+ fQ.assign(fNQHarmonics*(fMaxCorrelator+1),TComplex(0.,0.));
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Reset()
+{
+ // Set all Q-vector components to zero.
+
+ for(UInt_t i=0;i<fQ.size();i++){fQ[i] = TComplex(0.,0.);}
+ fChanged = kTRUE;
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Fill(Double_t phi, Double_t weight)
+{
+ // Add a particle with azimuthal angle phi and the given weight to all Q-vector components.
+
+ const Int_t nPowers = fMaxCorrelator+1;
+ for(Int_t h=0;h<fNQHarmonics;h++)
+ {
+  const Double_t dCos = TMath::Cos(h*phi), dSin = TMath::Sin(h*phi);
+  TComplex* q = &fQ[h*nPowers];
+  if(weight == 1.)
+  {
+   for(Int_t wp=0;wp<nPowers;wp++){q[wp] += TComplex(dCos,dSin);}
+  } else
+    {
+     for(Int_t wp=0;wp<nPowers;wp++)
+     {
+      const Double_t wToPowerP = pow(weight,wp);
+      q[wp] += TComplex(wToPowerP*dCos,wToPowerP*dSin);
+     }
+    }
+ }
+ fChanged = kTRUE;
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::SetQ(Int_t n, Int_t p, const TComplex& q)
+{
+ // Set the Q-vector component Q(n,p), n >= 0.
+
+ if(n < 0 || n >= fNQHarmonics || p < 0 || p > fMaxCorrelator)
+ {
+  Error("SetQ","Q(%d,%d) out of range",n,p);
+  return;
+ }
+ fQ[n*(fMaxCorrelator+1)+p] = q;
+ fChanged = kTRUE;
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Q(Int_t n, Int_t p) const
+{
+ // Q-vector component, using the fact that Q(-n,p) = Q(n,p)^*.
+
+ if(n>=0){return fQ[n*(fMaxCorrelator+1)+p];}
+ return TComplex::Conjugate(fQ[-n*(fMaxCorrelator+1)+p]);
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Correlator(Int_t k, const Int_t* harmonic)
+{
+ // Generic k-particle correlator with harmonics harmonic[0],...,harmonic[k-1].
+
+ if(k < 1 || k > fMaxCorrelator)
+ {
+  Error("Correlator","%d-particle correlator not supported",k);
+  return TComplex(0.,0.);
+ }
+ Int_t sumHarmonics = 0;
+ UShort_t slot[kMaxCorrelator];
+ for(Int_t i=0;i<k;i++)
+ {
+  sumHarmonics += TMath::Abs(harmonic[i]);
+  // insertion sort, k <= 8
+  const UShort_t s = ((harmonic[i]+kHarmonicOffset)<<4)|1;
+  Int_t j = i;
+  for(;j>0 && slot[j-1]>s;j--){slot[j] = slot[j-1];}
+  slot[j] = s;
+ }
+ if(sumHarmonics >= fNQHarmonics)
+ {
+  Error("Correlator","sum of the harmonics %d above %d",sumHarmonics,fNQHarmonics-1);
+  return TComplex(0.,0.);
+ }
+
+ if(fChanged)
+ {
+  // new Q-vectors, forget all terms
+  NewStamp();
+  fChanged = kFALSE;
+ }
+
+ return Compute(k,slot);
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Two(Int_t n1, Int_t n2)
+{
+ // Generic two-particle correlation <exp[i(n1*phi1+n2*phi2)]>.
+
+ Int_t harmonic[2] = {n1,n2};
+ return Correlator(2,harmonic);
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Three(Int_t n1, Int_t n2, Int_t n3)
+{
+ // Generic three-particle correlation <exp[i(n1*phi1+n2*phi2+n3*phi3)]>.
+
+ Int_t harmonic[3] = {n1,n2,n3};
+ return Correlator(3,harmonic);
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Four(Int_t n1, Int_t n2, Int_t n3, Int_t n4)
+{
+ // Generic four-particle correlation <exp[i(n1*phi1+n2*phi2+n3*phi3+n4*phi4)]>.
+
+ Int_t harmonic[4] = {n1,n2,n3,n4};
+ return Correlator(4,harmonic);
+}
+
+//________________________________________________________________________
+
+TComplex AliFlowGenericCorrelator::Compute(Int_t k, const UShort_t* slot)
+{
+ // Term with the k sorted slots, from the table or with the recursion.
+
+ if(k == 1){return QSlot(slot[0]);}
+
+ ULong64_t key[2] = {0,0};
+ for(Int_t i=0;i<k;i++){key[i/4] |= ULong64_t(slot[i])<<(16*(i%4));}
+ UInt_t entry = Find(key);
+ if(!fKey.empty() && fEntryStamp[entry] == fStamp)
+ {
+  fNReused++;
+  return fValue[entry];
+ }
+
+ const Int_t km1 = k-1;
+ const UShort_t last = slot[km1];
+ TComplex c = QSlot(last)*Compute(km1,slot);
+
+ // the particle of the last slot is one of the particles of the other slots,
+ // slots appearing several times give the same term
+ UShort_t merged[kMaxCorrelator];
+ for(Int_t i=0;i<km1;)
+ {
+  Int_t mult = 1;
+  while(i+mult<km1 && slot[i+mult]==slot[i]){mult++;}
+  const UShort_t sum = slot[i]+last-(kHarmonicOffset<<4); // harmonics and powers add
+  Int_t m = 0;
+  for(Int_t j=0;j<km1;j++){if(j!=i){merged[m++] = slot[j];}}
+  // insert the merged slot
+  Int_t j = m;
+  for(;j>0 && merged[j-1]>sum;j--){merged[j] = merged[j-1];}
+  merged[j] = sum;
+  if(mult == 1){c -= Compute(km1,merged);}
+  else{c -= Double_t(mult)*Compute(km1,merged);}
+  i += mult;
+ }
+
+ Insert(key,c);
+ fNComputed++;
+ return c;
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::NewStamp()
+{
+ // Empty the table of terms.
+
+ if(++fStamp == 0)
+ {
+  for(UInt_t i=0;i<fEntryStamp.size();i++){fEntryStamp[i] = 0;}
+  fStamp = 1;
+ }
+ fNEntries = 0;
+}
+
+//________________________________________________________________________
+
+UInt_t AliFlowGenericCorrelator::Find(const ULong64_t* key) const
+{
+ // Open addressing with linear probing, the table size is a power of 2.
+
+ if(fKey.empty()){return 0;}
+ const UInt_t mask = fEntryStamp.size()-1;
+ ULong64_t hash = key[0]*0x9E3779B97F4A7C15ULL ^ key[1]*0xC2B2AE3D27D4EB4FULL;
+ UInt_t entry = UInt_t(hash ^ (hash>>29)) & mask;
+ while(fEntryStamp[entry] == fStamp)
+ {
+  if(fKey[2*entry] == key[0] && fKey[2*entry+1] == key[1]){break;}
+  entry = (entry+1) & mask;
+ }
+ return entry;
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Insert(const ULong64_t* key, const TComplex& value)
+{
+ // Store a term, the table is enlarged when half full, up to fMaxTableSize entries.
+
+ if(2*(fNEntries+1) > fEntryStamp.size())
+ {
+  if(fEntryStamp.size() >= fMaxTableSize && !fEntryStamp.empty())
+  {
+   // full, start again with the terms needed from now on
+   NewStamp();
+  } else
+    {
+     Grow();
+    }
+ }
+
+ const UInt_t entry = Find(key);
+ fKey[2*entry] = key[0];
+ fKey[2*entry+1] = key[1];
+ fEntryStamp[entry] = fStamp;
+ fValue[entry] = value;
+ fNEntries++;
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Grow()
+{
+ // Double the size of the table, keeping the current terms.
+
+ std::vector<ULong64_t> oldKey;
+ std::vector<UInt_t> oldStamp;
+ std::vector<TComplex> oldValue;
+ oldKey.swap(fKey);
+ oldStamp.swap(fEntryStamp);
+ oldValue.swap(fValue);
+ const UInt_t size = oldStamp.empty() ? 4096 : 2*oldStamp.size();
+ fKey.assign(2*size,0);
+ fEntryStamp.assign(size,0);
+ fValue.assign(size,TComplex(0.,0.));
+ for(UInt_t i=0;i<oldStamp.size();i++)
+ {
+  if(oldStamp[i] != fStamp){continue;}
+  const UInt_t entry = Find(&oldKey[2*i]);
+  fKey[2*entry] = oldKey[2*i];
+  fKey[2*entry+1] = oldKey[2*i+1];
+  fEntryStamp[entry] = fStamp;
+  fValue[entry] = oldValue[i];
+ }
+}
+
+//________________________________________________________________________
+
+void AliFlowGenericCorrelator::Print(Option_t*) const
+{
+ // Settings and counters.
+
+ printf("AliFlowGenericCorrelator: harmonics up to %d, up to %d-particle correlators\n",fMaxHarmonic,fMaxCorrelator);
+ printf("  terms computed %lld, reused %lld, table size %d\n",fNComputed,fNReused,(Int_t)fEntryStamp.size());
+}
@@ -0,0 +1,81 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWGENERICCORRELATOR_H
+#define ALIFLOWGENERICCORRELATOR_H
+
+#include <vector>
+#include "TObject.h"
+#include "TComplex.h"
+
+//********************************************************************
+// AliFlowGenericCorrelator:                                         *
+// Q-vectors of one event and the generic multi-particle correlators *
+// computed from them, with the sub-sums of the recursion shared by  *
+// all harmonic combinations of the event.                           *
+//********************************************************************
+
+class AliFlowGenericCorrelator: public TObject {
+ public:
+  AliFlowGenericCorrelator(Int_t maxHarmonic=6, Int_t maxCorrelator=8);
+  virtual ~AliFlowGenericCorrelator() {}
+
+  // Q-vector store, Q(n,p) = sum_i w_i^p exp(i*n*phi_i) for |n| <= maxHarmonic*maxCorrelator, p <= maxCorrelator:
+  void Reset();                                   // zero the Q-vectors, e.g. for a new event
+  void Fill(Double_t phi, Double_t weight=1.);    // add a particle
+  void SetQ(Int_t n, Int_t p, const TComplex& q); // set a component directly
+  TComplex Q(Int_t n, Int_t p) const;             // Q(-n,p) = Q(n,p)^*
+
+  // Generic correlator sum_{i1!=...!=ik} w_i1*...*w_ik exp[i(n1*phi_i1+...+nk*phi_ik)], k <= maxCorrelator,
+  // divided by Correlator(k,{0,...,0}).Re() it gives <exp[i(n1*phi1+...+nk*phik)]>:
+  TComplex Correlator(Int_t k, const Int_t* harmonic);
+  TComplex Two(Int_t n1, Int_t n2);
+  TComplex Three(Int_t n1, Int_t n2, Int_t n3);
+  TComplex Four(Int_t n1, Int_t n2, Int_t n3, Int_t n4);
+
+  Int_t GetMaxHarmonic() const {return fMaxHarmonic;}
+  Int_t GetMaxCorrelator() const {return fMaxCorrelator;}
+  Long64_t GetNComputed() const {return fNComputed;} // correlators (and sub-sums) computed
+  Long64_t GetNReused() const {return fNReused;}     // correlators (and sub-sums) taken from previous calls
+  void ResetCounters() {fNComputed = fNReused = 0;}
+  void SetMaxTableSize(UInt_t size) {fMaxTableSize = size;} // entries of the table of terms, emptied when full
+  UInt_t GetMaxTableSize() const {return fMaxTableSize;}
+  virtual void Print(Option_t* option="") const;
+
+  static const Int_t kMaxCorrelator = 8; // correlators of up to 8 particles
+
+ private:
+  AliFlowGenericCorrelator(const AliFlowGenericCorrelator& other);
+  AliFlowGenericCorrelator& operator=(const AliFlowGenericCorrelator& other);
+
+  // A term of the recursion is a product over k slots, each slot a harmonic and a power of the weight
+  // coded as ((harmonic+kHarmonicOffset)<<4)|power; terms are looked up with their slots sorted.
+  enum {kHarmonicOffset = 2048};
+  TComplex Compute(Int_t k, const UShort_t* slot);
+  TComplex QSlot(UShort_t slot) const {return Q(Int_t(slot>>4)-kHarmonicOffset, slot&0xf);}
+  UInt_t Find(const ULong64_t* key) const; // entry with the key, or the empty entry where it goes
+  void Insert(const ULong64_t* key, const TComplex& value);
+  void NewStamp();
+  void Grow();
+
+  Int_t fMaxHarmonic;              // largest harmonic of the correlators
+  Int_t fMaxCorrelator;            // largest number of particles of the correlators
+  Int_t fNQHarmonics;              // number of stored harmonics, fMaxHarmonic*fMaxCorrelator+1
+  std::vector<TComplex> fQ;        //! Q-vectors, [n][p]
+  Bool_t fChanged;                 //! Q-vectors changed since the last correlator
+
+  UInt_t fMaxTableSize;            // largest size of the table of terms
+  UInt_t fStamp;                   //! current Q-vectors, the entries of the table with another stamp are empty
+  UInt_t fNEntries;                //! used entries of the table
+  std::vector<ULong64_t> fKey;     //! keys of the table, two words per entry
+  std::vector<UInt_t> fEntryStamp; //! stamp of each entry
+  std::vector<TComplex> fValue;    //! values of the table
+
+  Long64_t fNComputed;             //! number of computed terms
+  Long64_t fNReused;               //! number of terms found in the table
+
+  ClassDef(AliFlowGenericCorrelator,1);
+};
+
+#endif
@@ -44,5 +44,6 @@
 #pragma link C++ class AliFlowAnalysisWithNestedLoops+;
 #pragma link C++ class AliFlowOnTheFlyEventGenerator+;
 #pragma link C++ class AliFlowAnalysisWithMultiparticleCorrelations+;
+#pragma link C++ class AliFlowGenericCorrelator+;
 
 #endif
@@ -372,7 +372,7 @@ void AliAnalysisTaskFlowEvent::UserExec(Option_t *)
       AliWarning("Event does not pass multiplicity cuts"); return;
     }
     //make event
-    fFlowEvent = new AliFlowEvent(mcEvent,fCFManager1,fCFManager2);
+    fFlowEvent->Fill(mcEvent,fCFManager1,fCFManager2);
   }
 
   // Make the FlowEvent for ESD input
@@ -400,7 +400,7 @@ void AliAnalysisTaskFlowEvent::UserExec(Option_t *)
 
     //make event
     if (fRPType == "Global") {
-      fFlowEvent = new AliFlowEvent(myESD,fCFManager1,fCFManager2);
+      fFlowEvent->Fill(myESD,fCFManager1,fCFManager2);
     }
     else if (fRPType == "TPCOnly") {
       fFlowEvent = new AliFlowEvent(myESD,fCFManager2,kFALSE);
@@ -489,7 +489,7 @@ void AliAnalysisTaskFlowEvent::UserExec(Option_t *)
       return;
     }
     AliInfo(Form("AOD has %d tracks", myAOD->GetNumberOfTracks()));
-    fFlowEvent = new AliFlowEvent(myAOD);
+    fFlowEvent->Fill(myAOD,NULL,NULL);
   }
 
   //inject candidates
@@ -6,6 +6,8 @@
   - TOF mismatch is included in the Bayesian probabilities
 
 */
+#include <algorithm>
+
 #include "AliFlowBayesianPID.h"
 
 #include "TDatabasePDG.h"
@@ -36,7 +38,7 @@ TH1D* AliFlowBayesianPID::fgHtofChannelDist=NULL;
 
 //________________________________________________________________________
 AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid) 
-  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0)
+  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0),fTPCResScale(1.0),fMismFrac(0),fPriorsCentr(),fNBatch(0),fBatchIndex(),fInMask(),fInPtBin(),fInDedx(),fInTPCArg(),fInTPCRes(),fInTOFDelta(),fInTOFSigma(),fInTOFMism(),fOutWeights(),fOutProb(),fOutWTofMism(),fOutProbTofMism(),fOutZ(),fOutMassTOF()
 {
   // Constructor
   Bool_t redopriors = kFALSE;
@@ -124,6 +126,11 @@ AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid)
   fTPCResponseF->SetParameter(0,1./fTPCResponseF->Integral(-7,7));
   fTPCResponseF->SetLineColor(4);
 
+  for(Int_t ipar=0;ipar < 4;ipar++){
+    fTOFResponsePar[ipar] = fTOFResponseF->GetParameter(ipar);
+    fTPCResponsePar[ipar] = fTPCResponseF->GetParameter(ipar);
+  }
+
   fBBdata = new TF1("fBBdata", "[0] * AliExternalTrackParam::BetheBlochAleph(x, [1], [2], [3], [4], [5])",0.1, 4000.);
 
   // initialize the mask
@@ -138,6 +145,8 @@ AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid)
     fgHtofChannelDist = (TH1D *) ftofchannel->Get("hTOFchanDist");
   }
 
+  SetCentralityTables();
+
 }
 //________________________________________________________________________
 AliFlowBayesianPID::~AliFlowBayesianPID(){
@@ -161,6 +170,7 @@ void AliFlowBayesianPID::SetDetResponse(AliESDEvent *esd,Float_t centrality,ESta
     if(centrality <= 0) centrality = 0.001;
   }
   fCurrCentrality = centrality;
+  SetCentralityTables();
 
   // retune BB
   Double_t alephParameters[5];
@@ -285,6 +295,7 @@ void AliFlowBayesianPID::SetDetResponse(AliAODEvent *aod,Float_t centrality,ESta
     if(centrality <= 0) centrality = 0.001;
   }
   fCurrCentrality = centrality;
+  SetCentralityTables();
 
   // retune BB
   Double_t alephParameters[5];
@@ -538,10 +549,95 @@ Float_t AliFlowBayesianPID::GetExpDeDx(const AliVTrack *t,Float_t mass) const{
   return dedxExp;
 }
 //________________________________________________________________________
-void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
-  // compute Detector weights for Bayesian probablities
+void AliFlowBayesianPID::SetCentralityTables(){
+  // pre-interpolate the centrality dependent parameters for the current event:
+  // scaling of the TPC resolution, TOF mismatch fraction and priors vs. pT
   Float_t centr = fCurrCentrality;
 
+  if(centr < 0) fTPCResScale = 0.78;
+  else if(centr < 30) fTPCResScale = 1.0;
+  else if(centr < 40) fTPCResScale = 0.95;
+  else if(centr < 50) fTPCResScale = 0.93;
+  else if(centr < 60) fTPCResScale = 0.91;
+  else if(centr < 70) fTPCResScale = 0.88;
+  else fTPCResScale = 0.83;
+
+  Float_t invCentr = 0;
+  if(centr >= 0) invCentr = 1 - centr/100;
+  fMismFrac = 0.005 + 0.05*invCentr*invCentr*invCentr;
+
+  // all the priors have the same binning
+  Int_t nbinsPt = fghPriors[0]->GetNbinsY() + 2;
+  fPriorsCentr.resize(fgkNspecies*nbinsPt);
+  for(Int_t iS=0;iS<fgkNspecies;iS++){
+    Int_t binCentr = fghPriors[iS]->GetXaxis()->FindBin(centr);
+    for(Int_t ibin=0;ibin < nbinsPt;ibin++) fPriorsCentr[iS*nbinsPt + ibin] = fghPriors[iS]->GetBinContent(binCentr,ibin);
+  }
+
+  ResetBatch();
+}
+//________________________________________________________________________
+Double_t AliFlowBayesianPID::EvalResponse(const Double_t *par,Double_t x){
+  // same as Eval() of fTPCResponseF/fTOFResponseF: Gaussian with exponential tail
+  return par[0]*TMath::Exp(-(x-par[1])*(x-par[1])/2/par[2]/par[2])* (x < par[1]+par[3]*par[2]) + (x > par[1]+par[3]*par[2])*par[0]*TMath::Exp(-(x-par[1]-par[3]*par[2]*0.5)*par[3]/par[2]);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ResetBatch(){
+  // forget the probabilities computed for the tracks of the event
+  fNBatch = 0;
+  fBatchIndex.clear();
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ResizeInputs(Int_t n){
+  // room for n tracks (the batch of the event plus one slot for single tracks)
+  if((Int_t) fInPtBin.size() >= n) return;
+  fInMask.resize(2*n);
+  fInPtBin.resize(n);
+  fInDedx.resize(n);
+  fInTPCArg.resize(n*fgkNspecies);
+  fInTPCRes.resize(n*fgkNspecies);
+  fInTOFDelta.resize(n*fgkNspecies);
+  fInTOFSigma.resize(n*fgkNspecies);
+  fInTOFMism.resize(n);
+  fOutWeights.resize(2*n*fgkNspecies);
+  fOutProb.resize(n*fgkNspecies);
+  fOutWTofMism.resize(n);
+  fOutProbTofMism.resize(n);
+  fOutZ.resize(n);
+  fOutMassTOF.resize(n);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::FillTPCInputs(const AliVTrack *t,Float_t momtpc,Float_t dedx,Int_t i){
+  // TPC: normalized dE/dx deviation and resolution for each specie
+  fInDedx[i] = dedx;
+  fInMask[2*i] = t->GetStatus() & AliESDtrack::kTPCout && dedx > 40 && fMaskOR[0]; // if TPC PID available
+  if(!fInMask[2*i]) return;
+
+  Float_t *arg = &fInTPCArg[i*fgkNspecies];
+  Float_t *res = &fInTPCRes[i*fgkNspecies];
+  for(Int_t iS=0;iS<fgkNspecies;iS++){
+    Float_t dedxExp=GetExpDeDx(t,iS);
+
+    Float_t resolutionTPC = 1;
+    if(iS==0) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kElectron); 
+    else if(iS==1) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kMuon);
+    else if(iS==2) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kPion);
+    else if(iS==3) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kKaon);
+    else if(iS==4) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kProton);
+    else if(iS==5) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kDeuteron);
+    else if(iS==6) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kTriton);
+    else if(iS==7) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5*0.07;
+    else if(iS==8) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5*0.07;
+
+    resolutionTPC *= fTPCResScale;
+
+    arg[iS] = (dedx - dedxExp)/resolutionTPC;
+    res[iS] = resolutionTPC;
+  }
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::FillInputs(const AliESDtrack *t,Int_t i){
+  // detector signals of an ESD track needed for the Bayesian probablities
   Float_t pt = t->Pt();
   Float_t p = t->P();
   Double_t ptpc[3];
@@ -606,49 +702,12 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
 	}
   }
 
-  fDedx = dedx;
-
-  if(t->GetStatus() & AliESDtrack::kTPCout && dedx > 40 && fMaskOR[0]){ // if TPC PID available    
-    for(Int_t iS=0;iS<fgkNspecies;iS++){
-      Float_t dedxExp=GetExpDeDx(t,iS);
-      
-      Float_t resolutionTPC = 1;
-      if(iS==0) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kElectron); 
-      else if(iS==1) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kMuon);
-      else if(iS==2) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kPion);
-      else if(iS==3) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kKaon);
-      else if(iS==4) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kProton);
-      else if(iS==5) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kDeuteron);
-      else if(iS==6) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kTriton);
-      else if(iS==7) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5*0.07;
-      else if(iS==8) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5*0.07;
-      
-      if(centr < 0) resolutionTPC *= 0.78;
-      if(centr < 10) resolutionTPC *= 1.0;
-      else if(centr < 20) resolutionTPC *= 1.0;
-      else if(centr < 30) resolutionTPC *= 1.0;
-      else if(centr < 40) resolutionTPC *= 0.95;
-      else if(centr < 50) resolutionTPC *= 0.93;
-      else if(centr < 60) resolutionTPC *= 0.91;
-      else if(centr < 70) resolutionTPC *= 0.88;
-      else resolutionTPC *= 0.83;
-      
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
-    }
-    fMaskCurrent[0] = kTRUE;
-  }
-  else{
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[0][iS] = 1;
-    fMaskCurrent[0] = kFALSE;
-  }
+  FillTPCInputs(t,momtpc,dedx,i);
+  fInPtBin[i] = fghPriors[0]->GetYaxis()->FindBin(t->Pt());
 
   // TOF
-  fWTofMism = 0;
-  if((t->GetStatus() & AliESDtrack::kTOFout) &&  (t->GetStatus() & AliESDtrack::kTIME) && t->GetIntegratedLength() > 365. && fMaskOR[1]){ // if TOF PID available
-    Float_t invCentr = 0;
-    if(centr >= 0) invCentr = 1 - centr/100;
-    Float_t mismfrac = 0.005 + 0.05*invCentr*invCentr*invCentr;
-
+  fInMask[2*i+1] = (t->GetStatus() & AliESDtrack::kTOFout) &&  (t->GetStatus() & AliESDtrack::kTIME) && t->GetIntegratedLength() > 365. && fMaskOR[1]; // if TOF PID available
+  if(fInMask[2*i+1]){
     Float_t timeTOF = t->GetTOFsignal() - fPIDesd->GetTOFResponse().GetStartTime(p);
 
     // TOF mismatch weight
@@ -659,7 +718,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
     Float_t dz =t->GetTOFsignalDz();
     Float_t dx =t->GetTOFsignalDx();
     Float_t mismweight = TMath::Max(fgMism->Eval(timeTOF - timeextra),0.0000001) * ((0.5 + 0.05/pt/pt/pt)*(0.75 + 0.23 * (1.3*dx*dx + 0.7*dz*dz))); // mismatch probabilities
-    fWTofMism = mismfrac*mismweight;
+    fInTOFMism[i] = fMismFrac*mismweight;
 
     Double_t inttimes[9];
     t->GetIntegratedTimes(inttimes,9);
@@ -669,34 +728,39 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
     inttimes[8] = inttimes[0] / p * fMass[8] * TMath::Sqrt(1+p*p/fMass[8]/fMass[8]);
 
     for(Int_t iS=0;iS<fgkNspecies;iS++){
-      Float_t expsigma = fPIDesd->GetTOFResponse().GetExpectedSigma(p, inttimes[iS], fMass[iS]);
-      Float_t delta = timeTOF - inttimes[iS];
-      if (TMath::Abs(delta) > 5*expsigma) {
-	fWeights[1][iS] = mismfrac*mismweight;
-      } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+      fInTOFSigma[i*fgkNspecies + iS] = fPIDesd->GetTOFResponse().GetExpectedSigma(p, inttimes[iS], fMass[iS]);
+      fInTOFDelta[i*fgkNspecies + iS] = timeTOF - inttimes[iS];
     }
-    fMaskCurrent[1] = kTRUE;
-  }
-  else{
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[1][iS] = 1;    
-    fMaskCurrent[1] = kFALSE;
   }
 
-  for(Int_t j=0;j < 2;j++){
-    Float_t rcc = 0;
-    for(Int_t iS=0;iS<fgkNspecies;iS++) rcc += fWeights[j][iS];
-    if(rcc <=0 ) rcc = 1;
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[j][iS] /= rcc;
+  // charge and mass from TPC and TOF
+  if(t->P() > 0.2 && t->GetTPCsignal() > 40 && (t->GetStatus() & AliESDtrack::kTOFout) && (t->GetStatus() & AliESDtrack::kTIME) && (t->GetIntegratedLength() > 365.)&& t->GetTOFsignal()> 12000){
+    Int_t signMass = 1;
 
-    if(j==1) fWTofMism /= rcc;
-  }  
+    Float_t beta = t->GetIntegratedLength() / (t->GetTOFsignal() - fPIDesd->GetTOFResponse().GetStartTime(t->P()))  * 33.3564095198152043;
+    Float_t gamma = 1;
+    if(beta<1){
+      gamma = 1./TMath::Sqrt(1-beta*beta);
+    }
+    else if(beta>1){
+      gamma = 1./TMath::Sqrt(beta*beta-1);
+      signMass=-1;
+    }
+    fOutMassTOF[i] = t->P()/beta/gamma;
+    
+    Float_t bb = fBBdata->Eval(momtpc/fOutMassTOF[i]);
+    fOutZ[i] = TMath::Power(t->GetTPCsignal()/bb,0.431)*t->GetSign();
+
+    fOutMassTOF[i] *= signMass;
+  }
+  else{
+    fOutZ[i]=0;
+    fOutMassTOF[i]=0;
+  }
 }
 //________________________________________________________________________
-void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *aod){
-  // compute Detector weights for Bayesian probablities
-  Float_t centr = fCurrCentrality;
-
+void AliFlowBayesianPID::FillInputs(const AliAODTrack *t,const AliAODEvent *aod,Int_t i){
+  // detector signals of an AOD track needed for the Bayesian probablities
   Float_t pt = t->Pt();
   Float_t p = t->P();
   Float_t momtpc=t->GetTPCmomentum();
@@ -753,51 +817,14 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
      else dedx = 0;
    }
   }
-  fDedx = dedx;
 
   // TPC
-  if(t->GetStatus() & AliESDtrack::kTPCout && dedx > 40 && fMaskOR[0]){ // if TPC PID available    
-    for(Int_t iS=0;iS<fgkNspecies;iS++){
-
-      Float_t dedxExp=GetExpDeDx(t,iS);
-
-      Float_t resolutionTPC = 1;
-      if(iS==0) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kElectron); 
-      else if(iS==1) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kMuon);
-      else if(iS==2) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kPion);
-      else if(iS==3) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kKaon);
-      else if(iS==4) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kProton);
-      else if(iS==5) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kDeuteron);
-      else if(iS==6) resolutionTPC =  fPIDesd->GetTPCResponse().GetExpectedSigma(momtpc,t->GetTPCsignalN(),AliPID::kTriton);
-      else if(iS==7) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[7])*5*0.07;
-      else if(iS==8) resolutionTPC =  fPIDesd->GetTPCResponse().Bethe(momtpc/fMass[8])*5*0.07;
-
-      if(centr < 0) resolutionTPC *= 0.78;
-      if(centr < 10) resolutionTPC *= 1.0;
-      else if(centr < 20) resolutionTPC *= 1.0;
-      else if(centr < 30) resolutionTPC *= 1.0;
-      else if(centr < 40) resolutionTPC *= 0.95;
-      else if(centr < 50) resolutionTPC *= 0.93;
-      else if(centr < 60) resolutionTPC *= 0.91;
-      else if(centr < 70) resolutionTPC *= 0.88;
-      else resolutionTPC *= 0.83;
-      
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
-    }
-    fMaskCurrent[0] = kTRUE;
-  }
-  else{
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[0][iS] = 1;
-    fMaskCurrent[0] = kFALSE;
-  }
+  FillTPCInputs(t,momtpc,dedx,i);
+  fInPtBin[i] = fghPriors[0]->GetYaxis()->FindBin(t->Pt());
 
   // TOF
-  fWTofMism = 0;
-  if((t->GetStatus() & AliESDtrack::kTOFout) &&  (t->GetStatus() & AliESDtrack::kTIME) && fMaskOR[1]){ // if TOF PID available
-    Float_t invCentr = 0;
-    if(centr >= 0) invCentr = 1 - centr/100;
-    Float_t mismfrac = 0.005 + 0.05*invCentr*invCentr*invCentr;
-
+  fInMask[2*i+1] = (t->GetStatus() & AliESDtrack::kTOFout) &&  (t->GetStatus() & AliESDtrack::kTIME) && fMaskOR[1]; // if TOF PID available
+  if(fInMask[2*i+1]){
     Float_t timeTOF = t->GetTOFsignal() - fPIDesd->GetTOFResponse().GetStartTime(p);
 
     // TOF mismatch weight
@@ -811,7 +838,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
     length = fgHtofChannelDist->GetBinContent(extrapolatedTOFchannel);
     timeextra = length * 33.3564095198152043;
     Float_t mismweight = TMath::Max(fgMism->Eval(timeTOF - timeextra),0.0000001) * ((0.5 + 0.05/pt/pt/pt)); // mismatch probabilities
-    fWTofMism = mismfrac*mismweight;
+    fInTOFMism[i] = fMismFrac*mismweight;
 
     Double_t inttimes[9];
     t->GetIntegratedTimes(inttimes,9);
@@ -845,158 +872,225 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
 	}
       }
 
-      Float_t expsigma = fPIDesd->GetTOFResponse().GetExpectedSigma(p, inttimes[iS], fMass[iS]);
-      Float_t delta = timeTOF - inttimes[iS];
-      if (TMath::Abs(delta) > 5*expsigma) {
-	fWeights[1][iS] = mismfrac*mismweight;
-      } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+      fInTOFSigma[i*fgkNspecies + iS] = fPIDesd->GetTOFResponse().GetExpectedSigma(p, inttimes[iS], fMass[iS]);
+      fInTOFDelta[i*fgkNspecies + iS] = timeTOF - inttimes[iS];
     }
-    fMaskCurrent[1] = kTRUE;
-  }
-  else{
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[1][iS] = 1;    
-    fMaskCurrent[1] = kFALSE;
   }
 
-  for(Int_t j=0;j < 2;j++){
-    Float_t rcc = 0;
-    for(Int_t iS=0;iS<fgkNspecies;iS++) rcc += fWeights[j][iS];
-    if(rcc <=0 ) rcc = 1;
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[j][iS] /= rcc;
-
-    if(j==1) fWTofMism /= rcc;
-  }  
+  /* Track length not written in aod
+     if(t->P() > 0.2 && t->GetTPCsignal() > 40 && (t->GetStatus() & AliESDtrack::kTOFout) && (t->GetStatus() & AliESDtrack::kTIME) && t->GetTOFsignal()> 12000){
+     Float_t momtpc=t->GetTPCmomentum();
+     Int_t signMass = 1;
+     
+     Float_t beta = t->GetIntegratedLength() / (t->GetTOFsignal() - fPIDesd->GetTOFResponse().GetStartTime(t->P()))  * 33.3564095198152043;
+     Float_t gamma = 1;
+     if(beta<1){
+     gamma = 1./TMath::Sqrt(1-beta*beta);
+     }
+     else if(beta>1){
+     gamma = 1./TMath::Sqrt(beta*beta-1);
+     signMass=-1;
+     }
+     fMassTOF = t->P()/beta/gamma;
+     
+     Float_t bb = fBBdata->Eval(momtpc/fMassTOF);
+     fZ = TMath::Power(t->GetTPCsignal()/bb,0.431)*t->GetSign();
+     
+     fMassTOF *= signMass;
+     }
+  */
+  fOutZ[i]=0;
+  fOutMassTOF[i]=0;
 }
 //________________________________________________________________________
-void AliFlowBayesianPID::ComputeProb(const AliESDtrack *t,Float_t /*centrObsolete*/){
-  // compute Bayesian probablities
-  ComputeWeights(t);
-  Float_t priors[fgkNspecies];
-  fProbTofMism = 0;
-
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+void AliFlowBayesianPID::FillWeights(Int_t first,Int_t n){
+  // detector weights of the tracks first..first+n-1 from their detector signals
+  for(Int_t i=first;i < first+n;i++){
+    Float_t *wTPC = &fOutWeights[2*i*fgkNspecies];
+    Float_t *wTOF = wTPC + fgkNspecies;
 
-
-  if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
-    Float_t rcc = 0;
-    for(Int_t iS=0;iS<fgkNspecies;iS++){
-      rcc += fWeights[0][iS]*fWeights[1][iS]*priors[iS];
-      fProbTofMism += fWeights[0][iS]*fWTofMism*priors[iS]; 
+    // TPC
+    if(fInMask[2*i]){
+      const Float_t *arg = &fInTPCArg[i*fgkNspecies];
+      const Float_t *res = &fInTPCRes[i*fgkNspecies];
+      for(Int_t iS=0;iS<fgkNspecies;iS++) wTPC[iS] = EvalResponse(fTPCResponsePar,arg[iS])/res[iS];
+    }
+    else{
+      for(Int_t iS=0;iS<fgkNspecies;iS++) wTPC[iS] = 1;
     }
-    if(rcc > 0){
+
+    // TOF
+    fOutWTofMism[i] = 0;
+    if(fInMask[2*i+1]){
+      const Float_t *delta = &fInTOFDelta[i*fgkNspecies];
+      const Float_t *expsigma = &fInTOFSigma[i*fgkNspecies];
+      Float_t mism = fInTOFMism[i];
+      fOutWTofMism[i] = mism;
       for(Int_t iS=0;iS<fgkNspecies;iS++){
-	fProb[iS] = fWeights[0][iS]*fWeights[1][iS]*priors[iS]/rcc;
+	if (TMath::Abs(delta[iS]) > 5*expsigma[iS]) wTOF[iS] = mism;
+	else wTOF[iS] = EvalResponse(fTOFResponsePar,delta[iS]/expsigma[iS])/expsigma[iS] + mism;
       }
-      fProbTofMism /=rcc;
     }
     else{
-      for(Int_t iS=0;iS<fgkNspecies;iS++) fProb[iS] = 0;
-      fProbTofMism = 0;
+      for(Int_t iS=0;iS<fgkNspecies;iS++) wTOF[iS] = 1;
     }
-  }
-  else{
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fProb[iS] = 0;
-    fProbTofMism = 0;   
-  }
-  
-  if(t->P() > 0.2 && t->GetTPCsignal() > 40 && (t->GetStatus() & AliESDtrack::kTOFout) && (t->GetStatus() & AliESDtrack::kTIME) && (t->GetIntegratedLength() > 365.)&& t->GetTOFsignal()> 12000){
-    Double_t ptpc[3];
-    t->GetInnerPxPyPz(ptpc);
-    Float_t momtpc=TMath::Sqrt(ptpc[0]*ptpc[0] + ptpc[1]*ptpc[1] + ptpc[2]*ptpc[2]);
 
-    Int_t signMass = 1;
+    for(Int_t j=0;j < 2;j++){
+      Float_t *w = wTPC + j*fgkNspecies;
+      Float_t rcc = 0;
+      for(Int_t iS=0;iS<fgkNspecies;iS++) rcc += w[iS];
+      if(rcc <=0 ) rcc = 1;
+      for(Int_t iS=0;iS<fgkNspecies;iS++) w[iS] /= rcc;
 
-    Float_t beta = t->GetIntegratedLength() / (t->GetTOFsignal() - fPIDesd->GetTOFResponse().GetStartTime(t->P()))  * 33.3564095198152043;
-    Float_t gamma = 1;
-    if(beta<1){
-      gamma = 1./TMath::Sqrt(1-beta*beta);
+      if(j==1) fOutWTofMism[i] /= rcc;
     }
-    else if(beta>1){
-      gamma = 1./TMath::Sqrt(beta*beta-1);
-      signMass=-1;
-    }
-    fMassTOF = t->P()/beta/gamma;
-    
-    Float_t bb = fBBdata->Eval(momtpc/fMassTOF);
-    fZ = TMath::Power(t->GetTPCsignal()/bb,0.431)*t->GetSign();
-
-    fMassTOF *= signMass;
   }
-  else{
-    fZ=0;
-    fMassTOF=0;
-  }
-  
 }
 //________________________________________________________________________
-void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *aod){
-  // compute Bayesian probablities
-  ComputeWeights(t,aod);
-  Float_t priors[fgkNspecies];
-  fProbTofMism = 0;
-
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
-
+void AliFlowBayesianPID::FillProb(Int_t first,Int_t n){
+  // Bayesian probablities of the tracks first..first+n-1 from their detector weights
+  Int_t nbinsPt = fghPriors[0]->GetNbinsY() + 2;
+  for(Int_t i=first;i < first+n;i++){
+    const Float_t *wTPC = &fOutWeights[2*i*fgkNspecies];
+    const Float_t *wTOF = wTPC + fgkNspecies;
+    Float_t *prob = &fOutProb[i*fgkNspecies];
+    Float_t priors[fgkNspecies];
+    for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fPriorsCentr[iS*nbinsPt + fInPtBin[i]];
 
-  if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
-    Float_t rcc = 0;
-    for(Int_t iS=0;iS<fgkNspecies;iS++){
-      rcc += fWeights[0][iS]*fWeights[1][iS]*priors[iS];
-      fProbTofMism += fWeights[0][iS]*fWTofMism*priors[iS]; 
-    }
-    if(rcc > 0){
+    fOutProbTofMism[i] = 0;
+    if((!fMaskAND[0] || fInMask[2*i]) && (!fMaskAND[1] || fInMask[2*i+1])){
+      Float_t rcc = 0;
       for(Int_t iS=0;iS<fgkNspecies;iS++){
-	fProb[iS] = fWeights[0][iS]*fWeights[1][iS]*priors[iS]/rcc;
+	rcc += wTPC[iS]*wTOF[iS]*priors[iS];
+	fOutProbTofMism[i] += wTPC[iS]*fOutWTofMism[i]*priors[iS]; 
+      }
+      if(rcc > 0){
+	for(Int_t iS=0;iS<fgkNspecies;iS++){
+	  prob[iS] = wTPC[iS]*wTOF[iS]*priors[iS]/rcc;
+	}
+	fOutProbTofMism[i] /=rcc;
+      }
+      else{
+	for(Int_t iS=0;iS<fgkNspecies;iS++) prob[iS] = 0;
+	fOutProbTofMism[i] = 0;
       }
-      fProbTofMism /=rcc;
     }
     else{
-      for(Int_t iS=0;iS<fgkNspecies;iS++) fProb[iS] = 0;
-      fProbTofMism = 0;
+      for(Int_t iS=0;iS<fgkNspecies;iS++) prob[iS] = 0;
+      fOutProbTofMism[i] = 0;   
     }
   }
-  else{
-    for(Int_t iS=0;iS<fgkNspecies;iS++) fProb[iS] = 0;
-    fProbTofMism = 0;   
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::SetCurrent(Int_t i,Bool_t withProb){
+  // copy the results of track i to the single track getters
+  fDedx = fInDedx[i];
+  fMaskCurrent[0] = fInMask[2*i];
+  fMaskCurrent[1] = fInMask[2*i+1];
+  for(Int_t j=0;j < 2;j++){
+    for(Int_t iS=0;iS<fgkNspecies;iS++) fWeights[j][iS] = fOutWeights[(2*i+j)*fgkNspecies + iS];
   }
+  fWTofMism = fOutWTofMism[i];
+  if(!withProb) return;
+  for(Int_t iS=0;iS<fgkNspecies;iS++) fProb[iS] = fOutProb[i*fgkNspecies + iS];
+  fProbTofMism = fOutProbTofMism[i];
+  fZ = fOutZ[i];
+  fMassTOF = fOutMassTOF[i];
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
+  // compute Detector weights for Bayesian probablities
+  ResizeInputs(fNBatch+1);
+  FillInputs(t,fNBatch);
+  FillWeights(fNBatch,1);
+  SetCurrent(fNBatch,kFALSE);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *aod){
+  // compute Detector weights for Bayesian probablities
+  ResizeInputs(fNBatch+1);
+  FillInputs(t,aod,fNBatch);
+  FillWeights(fNBatch,1);
+  SetCurrent(fNBatch,kFALSE);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeProb(const AliESDtrack *t,Float_t /*centrObsolete*/){
+  // compute Bayesian probablities
+  ResizeInputs(fNBatch+1);
+  FillInputs(t,fNBatch);
+  FillWeights(fNBatch,1);
+  FillProb(fNBatch,1);
+  SetCurrent(fNBatch,kTRUE);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *aod){
+  // compute Bayesian probablities
+  ResizeInputs(fNBatch+1);
+  FillInputs(t,aod,fNBatch);
+  FillWeights(fNBatch,1);
+  FillProb(fNBatch,1);
+  SetCurrent(fNBatch,kTRUE);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeEventProb(const AliESDEvent *esd){
+  // compute the Bayesian probablities of all the tracks of the event at once,
+  // to be retrieved with LoadTrackProb()
+  // (not for MC, where the dE/dx is smeared track by track)
+  ResetBatch();
+  if(!esd || fIsMC) return;
 
-  /* Track length not written in aod
-     if(t->P() > 0.2 && t->GetTPCsignal() > 40 && (t->GetStatus() & AliESDtrack::kTOFout) && (t->GetStatus() & AliESDtrack::kTIME) && t->GetTOFsignal()> 12000){
-     Float_t momtpc=t->GetTPCmomentum();
-     Int_t signMass = 1;
-     
-     Float_t beta = t->GetIntegratedLength() / (t->GetTOFsignal() - fPIDesd->GetTOFResponse().GetStartTime(t->P()))  * 33.3564095198152043;
-     Float_t gamma = 1;
-     if(beta<1){
-     gamma = 1./TMath::Sqrt(1-beta*beta);
-     }
-     else if(beta>1){
-     gamma = 1./TMath::Sqrt(beta*beta-1);
-     signMass=-1;
-     }
-     fMassTOF = t->P()/beta/gamma;
-     
-     Float_t bb = fBBdata->Eval(momtpc/fMassTOF);
-     fZ = TMath::Power(t->GetTPCsignal()/bb,0.431)*t->GetSign();
-     
-     fMassTOF *= signMass;
-     }
-  */
-  //  else{
-  fZ=0;
-  fMassTOF=0;
-  //  }
-  
+  Int_t ntracks = esd->GetNumberOfTracks();
+  ResizeInputs(ntracks+1);
+  fBatchIndex.resize(ntracks);
+  for(Int_t i=0;i < ntracks;i++){
+    const AliESDtrack *t = esd->GetTrack(i);
+    FillInputs(t,i);
+    fBatchIndex[i] = std::make_pair(static_cast<const AliVTrack*>(t),i);
+  }
+  FillWeights(0,ntracks);
+  FillProb(0,ntracks);
+  std::sort(fBatchIndex.begin(),fBatchIndex.end());
+  fNBatch = ntracks;
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::ComputeEventProb(const AliAODEvent *aod){
+  // compute the Bayesian probablities of all the tracks of the event at once,
+  // to be retrieved with LoadTrackProb()
+  // (not for MC, where the dE/dx is smeared track by track)
+  ResetBatch();
+  if(!aod || fIsMC) return;
+
+  Int_t ntracks = aod->GetNumberOfTracks();
+  ResizeInputs(ntracks+1);
+  fBatchIndex.reserve(ntracks);
+  Int_t n = 0;
+  for(Int_t i=0;i < ntracks;i++){
+    const AliAODTrack *t = dynamic_cast<const AliAODTrack*>(aod->GetTrack(i));
+    if(!t) continue;
+    FillInputs(t,aod,n);
+    fBatchIndex.push_back(std::make_pair(static_cast<const AliVTrack*>(t),n));
+    n++;
+  }
+  FillWeights(0,n);
+  FillProb(0,n);
+  std::sort(fBatchIndex.begin(),fBatchIndex.end());
+  fNBatch = n;
+}
+//________________________________________________________________________
+Bool_t AliFlowBayesianPID::LoadTrackProb(const AliVTrack *t){
+  // make the probablities computed by ComputeEventProb() for this track
+  // the current ones (GetProb(), GetWeights(), ...), kFALSE if not available
+  if(!fNBatch) return kFALSE;
+  std::vector<std::pair<const AliVTrack*,Int_t> >::const_iterator it = std::lower_bound(fBatchIndex.begin(),fBatchIndex.end(),std::make_pair(t,0));
+  if(it == fBatchIndex.end() || it->first != t) return kFALSE;
+  SetCurrent(it->second,kTRUE);
+  return kTRUE;
 }
 //________________________________________________________________________
 void AliFlowBayesianPID::SetPsiCorrectionDeDx(Float_t psi,Float_t res){
   fPsi=psi;
   fPsiRes=res;
+  ResetBatch();
 }
 //________________________________________________________________________
 void AliFlowBayesianPID::SetPriors(){
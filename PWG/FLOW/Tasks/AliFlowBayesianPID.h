@@ -7,6 +7,8 @@
 #ifndef ALIFLOWBAYESIANPID_H
 #define ALIFLOWBAYESIANPID_H
 
+#include <utility>
+#include <vector>
 #include "AliESDpid.h"
 #include "AliPIDResponse.h"
 
@@ -16,6 +18,7 @@ class AliESDEvent;
 class AliESDtrack;
 class AliAODEvent;
 class AliAODTrack;
+class AliVTrack;
 class TH2D;
 class TSpline3;
 class TF1;
@@ -55,6 +58,15 @@ if you want to use a dE/dx depdence on DeltaPhi set the EP with its resolution o
      }
 
 
+or, for all the tracks of the event at once (not for MC)
+
+     mypid->ComputeEventProb(esdEvent); // or aodEvent, after SetDetResponse and the detector masks
+     for(...){ // track loop
+       if(! mypid->LoadTrackProb(track)) mypid->ComputeProb(track,centrality); // track not in the event (e.g. TPC only copy)
+       Float_t *prob = mypid->GetProb();
+     }
+
+
 More details:
      // for the single detector weights (no priors)
      Float_t *tpcWeight = mypid->GetWeights(0); // TPC weights (equal weights in case of no kTPCpid)
@@ -81,13 +93,13 @@ class AliFlowBayesianPID : public AliPIDResponse{
   // setter
   void SetDetResponse(AliESDEvent *esd,Float_t centrality=-1.0,EStartTimeType_t flagStart=AliESDpid::kTOF_T0,Bool_t /*recomputeT0TOF*/=kFALSE);
   void SetDetResponse(AliAODEvent *aod,Float_t centrality=-1.0,EStartTimeType_t flagStart=AliESDpid::kTOF_T0);
-  void SetNewTrackParam(Bool_t flag=kTRUE){fNewTrackParam=flag;};
-  void SetDetAND(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskAND[idet] = kTRUE;};
-  void SetDetOR(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskOR[idet] = kTRUE;};
-  void ResetDetAND(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskAND[idet] = kFALSE;};
-  void ResetDetOR(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskOR[idet] = kFALSE;};
+  void SetNewTrackParam(Bool_t flag=kTRUE){fNewTrackParam=flag; ResetBatch();};
+  void SetDetAND(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskAND[idet] = kTRUE; ResetBatch();};
+  void SetDetOR(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskOR[idet] = kTRUE; ResetBatch();};
+  void ResetDetAND(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskAND[idet] = kFALSE; ResetBatch();};
+  void ResetDetOR(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskOR[idet] = kFALSE; ResetBatch();};
   void SetPsiCorrectionDeDx(Float_t psi,Float_t res);
-  void SetMC(Bool_t flag){fIsMC=flag;};
+  void SetMC(Bool_t flag){fIsMC=flag; ResetBatch();};
 
   // getter
   AliESDpid* GetESDpid(){return fPIDesd;};
@@ -115,14 +127,29 @@ class AliFlowBayesianPID : public AliPIDResponse{
   void ComputeWeights(const AliAODTrack *t,const AliAODEvent *aod=NULL);
   void ComputeProb(const AliAODTrack *t,const AliAODEvent *aod=NULL); // obsolete method
 
-  void SetTOFres(Float_t res){fTOFresolution=res;};
+  // Bayesian Combined PID for all the tracks of the event
+  void ComputeEventProb(const AliESDEvent *esd);
+  void ComputeEventProb(const AliAODEvent *aod);
+  Bool_t LoadTrackProb(const AliVTrack *t);
+
+  void SetTOFres(Float_t res){fTOFresolution=res; ResetBatch();};
 
   Float_t GetDeDx() const {return fDedx;};
 
-  void ForceOldDedx(Bool_t status=kTRUE) {fForceOldDedx=status;};
+  void ForceOldDedx(Bool_t status=kTRUE) {fForceOldDedx=status; ResetBatch();};
 
  private: 
   void SetPriors();
+  void SetCentralityTables();
+  void ResetBatch();
+  void ResizeInputs(Int_t n);
+  void FillTPCInputs(const AliVTrack *t,Float_t momtpc,Float_t dedx,Int_t i);
+  void FillInputs(const AliESDtrack *t,Int_t i);
+  void FillInputs(const AliAODTrack *t,const AliAODEvent *aod,Int_t i);
+  void FillWeights(Int_t first,Int_t n);
+  void FillProb(Int_t first,Int_t n);
+  void SetCurrent(Int_t i,Bool_t withProb);
+  static Double_t EvalResponse(const Double_t *par,Double_t x);
 
   static const Int_t fgkNdetectors = 2; // Number of detector used for PID
   static const Int_t fgkNspecies = 9;// 0=el, 1=mu, 2=pi, 3=ka, 4=pr, 5=deuteron, 6=triton, 7=He3 
@@ -164,7 +191,33 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
   static TH1D *fgHtofChannelDist; // channel distance from IP
 
-  ClassDef(AliFlowBayesianPID, 10); // example of analysis
+  Double_t fTPCResponsePar[4]; //! parameters of fTPCResponseF
+  Double_t fTOFResponsePar[4]; //! parameters of fTOFResponseF
+
+  // centrality dependent parameters for the current event
+  Double_t fTPCResScale;               //! scaling of the TPC resolution
+  Float_t fMismFrac;                   //! TOF mismatch fraction
+  std::vector<Float_t> fPriorsCentr;   //! priors vs. pT bin, for each specie
+
+  // detector signals and results, for the tracks of the event (ComputeEventProb) + 1 single track
+  Int_t fNBatch;                                                //! number of tracks of the event
+  std::vector<std::pair<const AliVTrack*,Int_t> > fBatchIndex; //! tracks of the event, sorted by address
+  std::vector<Bool_t> fInMask;         //! TPC and TOF PID available
+  std::vector<Int_t> fInPtBin;         //! pT bin of the priors
+  std::vector<Float_t> fInDedx;        //! dE/dx
+  std::vector<Float_t> fInTPCArg;      //! TPC deviation in resolution units, per specie
+  std::vector<Float_t> fInTPCRes;      //! TPC resolution, per specie
+  std::vector<Float_t> fInTOFDelta;    //! TOF time - expected time, per specie
+  std::vector<Float_t> fInTOFSigma;    //! TOF expected resolution, per specie
+  std::vector<Float_t> fInTOFMism;     //! TOF mismatch weight
+  std::vector<Float_t> fOutWeights;    //! TPC and TOF weights, per specie
+  std::vector<Float_t> fOutProb;       //! Bayesian probabilities, per specie
+  std::vector<Float_t> fOutWTofMism;   //! normalized TOF mismatch weight
+  std::vector<Float_t> fOutProbTofMism;//! TOF mismatch probability
+  std::vector<Float_t> fOutZ;          //! measured charge
+  std::vector<Float_t> fOutMassTOF;    //! measured mass/Z
+
+  ClassDef(AliFlowBayesianPID, 11); // example of analysis
 };
 
 #endif
@@ -252,7 +252,17 @@ AliFlowEvent::AliFlowEvent( const AliMCEvent* anInput,
      fQycvsV0[i] = 0x0;
   }
 
-  //Fills the event from the MC kinematic information
+  Fill(anInput,rpCFManager,poiCFManager);
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEvent::Fill( const AliMCEvent* anInput,
+                         const AliCFManager* rpCFManager,
+                         const AliCFManager* poiCFManager )
+{
+  //Fills the event from the MC kinematic information,
+  //the tracks of the previous event are reused
+  ClearFast();
   Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
 
   //loop over tracks
@@ -272,7 +282,8 @@ AliFlowEvent::AliFlowEvent( const AliMCEvent* anInput,
     }
     if (!(rpOK||poiOK)) continue;
 
-    AliFlowTrack* pTrack = new AliFlowTrack(pParticle);
+    AliFlowTrack* pTrack = ReuseTrack(fNumberOfTracks);
+    pTrack->Set(pParticle);
     pTrack->SetSource(AliFlowTrack::kFromMC);
 
     if (rpOK && rpCFManager)
@@ -286,7 +297,7 @@ AliFlowEvent::AliFlowEvent( const AliMCEvent* anInput,
       IncrementNumberOfPOIs(1);
     }
 
-    AddTrack(pTrack) ;
+    TrackAdded();
   }//for all tracks
   SetMCReactionPlaneAngle(anInput);
 }
@@ -314,11 +325,20 @@ AliFlowEvent::AliFlowEvent( const AliESDEvent* anInput,
      fQxcvsV0[i] = 0x0;
      fQycvsV0[i] = 0x0;
   }
+  Fill(anInput,rpCFManager,poiCFManager);
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEvent::Fill( const AliESDEvent* anInput,
+                         const AliCFManager* rpCFManager,
+                         const AliCFManager* poiCFManager )
+{
+  //Fills the event from the ESD,
+  //the tracks of the previous event are reused
+  ClearFast();
   //set run number
   if(anInput->GetRunNumber()) fRun = anInput->GetRunNumber();
  
-  //Fills the event from the ESD
-
   Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
 
   //loop over tracks
@@ -339,7 +359,8 @@ AliFlowEvent::AliFlowEvent( const AliESDEvent* anInput,
     if (!(rpOK || poiOK)) continue;
 
     //make new AliFLowTrack
-    AliFlowTrack* pTrack = new AliFlowTrack(pParticle);
+    AliFlowTrack* pTrack = ReuseTrack(fNumberOfTracks);
+    pTrack->Set(pParticle);
     pTrack->SetSource(AliFlowTrack::kFromESD);
 
     //marking the particles used for int. flow:
@@ -355,7 +376,7 @@ AliFlowEvent::AliFlowEvent( const AliESDEvent* anInput,
       IncrementNumberOfPOIs(1);
     }
 
-    AddTrack(pTrack);
+    TrackAdded();
   }//end of while (itrkN < iNumberOfInputTracks)
 }
 
@@ -383,10 +404,20 @@ AliFlowEvent::AliFlowEvent( const AliAODEvent* anInput,
      fQycvsV0[i] = 0x0;
   }
 
+  Fill(anInput,rpCFManager,poiCFManager);
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEvent::Fill( const AliAODEvent* anInput,
+                         const AliCFManager* rpCFManager,
+                         const AliCFManager* poiCFManager )
+{
+  //Fills the event from the AOD,
+  //the tracks of the previous event are reused
+  ClearFast();
   //set run number
   if(anInput->GetRunNumber()) fRun = anInput->GetRunNumber();
  
-  //Fills the event from the AOD
   Int_t iNumberOfInputTracks = anInput->GetNumberOfTracks() ;
 
   //loop over tracks
@@ -408,7 +439,8 @@ AliFlowEvent::AliFlowEvent( const AliAODEvent* anInput,
     if (!(rpOK || poiOK)) continue;
 
     //make new AliFlowTrack
-    AliFlowTrack* pTrack = new AliFlowTrack(pParticle);
+    AliFlowTrack* pTrack = ReuseTrack(fNumberOfTracks);
+    pTrack->Set(pParticle);
     pTrack->SetSource(AliFlowTrack::kFromAOD);
 
     if (rpOK /* && rpCFManager */ ) // to be fixed - with CF managers uncommented only empty events (NULL in header files)
@@ -421,7 +453,7 @@ AliFlowEvent::AliFlowEvent( const AliAODEvent* anInput,
       pTrack->SetForPOISelection(kTRUE);
       IncrementNumberOfPOIs(1);
     }
-    AddTrack(pTrack);
+    TrackAdded();
   }
 
   //  if (iSelParticlesRP >= fMinMult && iSelParticlesRP <= fMaxMult)
@@ -1146,10 +1178,10 @@ AliFlowEvent::AliFlowEvent( const AliESDEvent* anInput,
     //Float_t pid   = pmdtracks->GetClusterPID();
     Float_t etacls = GetPmdEta(clsX,clsY,clsZ);
     Float_t phicls = GetPmdPhi(clsX,clsY);
-    //make new AliFLowTrackSimple
-    AliFlowTrack* pTrack = new AliFlowTrack();
     //if(det == 0){ //selecting preshower plane only
     if(det == 0 && adc > 270 && ncell > 1){ //selecting preshower plane only
+      //make new AliFLowTrackSimple
+      AliFlowTrack* pTrack = new AliFlowTrack();
       //pTrack->SetPt(adc);//cluster adc
       pTrack->SetPt(0.0);
       pTrack->SetEta(etacls);
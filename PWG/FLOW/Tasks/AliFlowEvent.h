@@ -76,6 +76,15 @@ public:
   
   void Fill( AliFlowTrackCuts* rpCuts,
              AliFlowTrackCuts* poiCuts );
+  void Fill( const AliMCEvent* anInput,
+             const AliCFManager* rpCFManager,
+             const AliCFManager* poiCFManager ); //use CF(2x)
+  void Fill( const AliESDEvent* anInput,
+             const AliCFManager* rpCFManager,
+             const AliCFManager* poiCFManager ); //use CF(2x)
+  void Fill( const AliAODEvent* anInput,
+             const AliCFManager* rpCFManager,
+             const AliCFManager* poiCFManager ); //use CF(2x)
 
   void FindDaughters(Bool_t keepDaughtersInRPselection=kFALSE);
 
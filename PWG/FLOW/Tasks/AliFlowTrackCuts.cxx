@@ -73,6 +73,7 @@
 #include "AliFlowCommonConstants.h"
 #include "AliAnalysisManager.h"
 #include "AliPIDResponse.h"
+#include "AliPIDResponseCache.h"
 #include "TF2.h"
 
 
@@ -799,6 +800,10 @@ void AliFlowTrackCuts::SetEvent(AliVEvent* event, AliMCEvent* mcEvent)
   
   if(fPIDsource==kTOFbayesian) fBayesianResponse->SetDetAND(1);
   else if(fPIDsource==kTPCbayesian) fBayesianResponse->ResetDetOR(1);
+
+  // AOD tracks are all passed to the PID cut: compute their Bayesian probabilities at once
+  if (fCutPID && myAOD && (fParticleID!=AliPID::kUnknown) && (fPIDsource==kTOFbayesian || fPIDsource==kTPCbayesian))
+    fBayesianResponse->ComputeEventProb(myAOD);
     
 }
 
@@ -2181,13 +2186,9 @@ AliFlowTrack* AliFlowTrackCuts::FillFlowTrackGeneric(TObjArray* trackCollection,
     trackCollection->AddAtAndExpand(flowtrack,trackIndex);
   }
   
+  //a rejected track stays in its slot, cleared, to be reused by the next one
   if (FillFlowTrackGeneric(flowtrack)) return flowtrack;
-  else 
-  {
-    trackCollection->RemoveAt(trackIndex);
-    delete flowtrack;
-    return NULL;
-  }
+  return NULL;
 }
 
 //-----------------------------------------------------------------------
@@ -2258,13 +2259,9 @@ AliFlowTrack* AliFlowTrackCuts::FillFlowTrackVParticle(TObjArray* trackCollectio
     trackCollection->AddAtAndExpand(flowtrack,trackIndex);
   }
 
+  //a rejected track stays in its slot, cleared, to be reused by the next one
   if (FillFlowTrackVParticle(flowtrack)) return flowtrack;
-  else
-  {
-    trackCollection->RemoveAt(trackIndex);
-    delete flowtrack;
-    return NULL;
-  }
+  return NULL;
 }
 
 //-----------------------------------------------------------------------
@@ -3677,7 +3674,7 @@ void AliFlowTrackCuts::InitPIDcuts()
 //-----------------------------------------------------------------------
 Bool_t AliFlowTrackCuts::PassesTPCbayesianCut(const AliAODTrack* track)
 {
-  fBayesianResponse->ComputeProb(track,track->GetAODEvent()); // fCurrCentr is needed for mismatch fraction
+  if (!fBayesianResponse->LoadTrackProb(track)) fBayesianResponse->ComputeProb(track,track->GetAODEvent()); // fCurrCentr is needed for mismatch fraction
   Float_t *probabilities = fBayesianResponse->GetProb(); // Bayesian Probability (from 0 to 4) (Combined TPC || TOF) including a tuning of priors and TOF mism$
 
   Int_t kTPC = fBayesianResponse->GetCurrentMask(0); // is TPC on
@@ -3733,7 +3730,7 @@ Bool_t AliFlowTrackCuts::PassesTPCbayesianCut(const AliESDtrack* track)
   //Bool_t statusMatchingHard = TPCTOFagree(track);
   //if (fRequireStrictTOFTPCagreement && (!statusMatchingHard))
   //     return kFALSE;
-  fBayesianResponse->ComputeProb(track,fCurrCentr); // fCurrCentr is needed for mismatch fraction
+  if (!fBayesianResponse->LoadTrackProb(track)) fBayesianResponse->ComputeProb(track,fCurrCentr); // fCurrCentr is needed for mismatch fraction
   Int_t kTPC = fBayesianResponse->GetCurrentMask(0); // is TPC on
   //Int_t kTOF = fBayesianResponse->GetCurrentMask(1); // is TOF on
 
@@ -3807,7 +3804,7 @@ Bool_t AliFlowTrackCuts::PassesTOFbayesianCut(const AliAODTrack* track)
   if (fRequireStrictTOFTPCagreement && (!statusMatchingHard))
        return kFALSE;
 
- fBayesianResponse->ComputeProb(track,track->GetAODEvent()); // fCurrCentr is needed for mismatch fraction
+ if (!fBayesianResponse->LoadTrackProb(track)) fBayesianResponse->ComputeProb(track,track->GetAODEvent()); // fCurrCentr is needed for mismatch fraction
   Float_t *probabilities = fBayesianResponse->GetProb(); // Bayesian Probability (from 0 to 4) (Combined TPC || TOF) including a tuning of priors and TOF mism$
 
   Float_t mismProb = fBayesianResponse->GetTOFMismProb(); // mismatch Bayesian probabilities
@@ -3873,7 +3870,7 @@ Bool_t AliFlowTrackCuts::PassesTOFbayesianCut(const AliESDtrack* track)
   if (fRequireStrictTOFTPCagreement && (!statusMatchingHard))
        return kFALSE;
 
-  fBayesianResponse->ComputeProb(track,fCurrCentr); // fCurrCentr is needed for mismatch fraction
+  if (!fBayesianResponse->LoadTrackProb(track)) fBayesianResponse->ComputeProb(track,fCurrCentr); // fCurrCentr is needed for mismatch fraction
   Float_t *probabilities = fBayesianResponse->GetProb(); // Bayesian Probability (from 0 to 4) (Combined TPC || TOF) including a tuning of priors and TOF mismatch parameterization
 
   Float_t mismProb = fBayesianResponse->GetTOFMismProb(); // mismatch Bayesian probabilities
@@ -4003,8 +4000,8 @@ Bool_t AliFlowTrackCuts::PassesTPCTOFNsigmaCut(const AliAODTrack* track)
     // check TPC status
     if(track->GetTPCsignal() < 10) return kFALSE;
 
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
-    Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse,track,fParticleID);
+    Float_t nsigmaTOF = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse,track,fParticleID);
 
     Float_t nsigma2 = nsigmaTPC*nsigmaTPC + nsigmaTOF*nsigmaTOF;
 
@@ -4027,8 +4024,8 @@ Bool_t AliFlowTrackCuts::PassesTPCTOFNsigmaCut(const AliESDtrack* track)
     // check TPC status
     if(track->GetTPCsignal() < 10) return kFALSE;
 
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
-    Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse,track,fParticleID);
+    Float_t nsigmaTOF = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse,track,fParticleID);
 
     Float_t nsigma2 = nsigmaTPC*nsigmaTPC + nsigmaTOF*nsigmaTOF;
 
@@ -4057,8 +4054,8 @@ Bool_t AliFlowTrackCuts::PassesTPCTOFNsigmaPurityCut(const AliAODTrack* track)
      Double_t LowPtPIDTPCnsigHigh_Kaon[2] ={3,2.2};
      */
     
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
-    Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse,track,fParticleID);
+    Float_t nsigmaTOF = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse,track,fParticleID);
     
     int index = (fParticleID-2)*60 + p_int;
     if ( (track->IsOn(AliAODTrack::kITSin))){
@@ -5224,7 +5221,7 @@ Bool_t AliFlowTrackCuts::PassesTPCTPCTOFNsigmaCut(const AliAODTrack* track){
   }
   if(pass){
     Double_t Pt = track->Pt();
-    Float_t nsigmaTPC = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTPC,track,fParticleID);
+    Float_t nsigmaTPC = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse,track,fParticleID);
     Float_t nsigma2 = 999.;
     if(Pt < fPtTOFPIDoff){
       nsigma2 = nsigmaTPC*nsigmaTPC;
@@ -5233,7 +5230,7 @@ Bool_t AliFlowTrackCuts::PassesTPCTPCTOFNsigmaCut(const AliAODTrack* track){
       if (((track->GetStatus()&AliVTrack::kTOFout)==0)&&((track->GetStatus()&AliVTrack::kTIME)==0)){
         pass = kFALSE;
       }else{
-        Float_t nsigmaTOF = fPIDResponse->NumberOfSigmas(AliPIDResponse::kTOF,track,fParticleID);
+        Float_t nsigmaTOF = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse,track,fParticleID);
         nsigma2 = nsigmaTPC*nsigmaTPC + nsigmaTOF*nsigmaTOF;
       }
     }
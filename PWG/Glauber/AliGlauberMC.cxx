@@ -23,15 +23,20 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <Riostream.h>
+#include <algorithm>
+#include <thread>
 #include <TMath.h>
 #include <TEllipse.h>
-#include <TRandom.h>
+#include <TRandom3.h>
+#include <TROOT.h>
+#include <TList.h>
 #include <TNamed.h>
 #include <TObjArray.h>
 #include <TNtuple.h>
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TCollection.h>
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -172,7 +177,19 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fRandom(0),
+  fNThreads(1),
+  fSigFlucCDF(),
+  fSigFlucMin(0),
+  fSigFlucStep(0),
+  fSigNNA(),
+  fSigNNB(),
+  fNCollA(),
+  fNCollB(),
+  fCellStart(),
+  fCellNucleons(),
+  fCandidates()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -322,7 +339,19 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc),
+  fRandom(in.fRandom),
+  fNThreads(in.fNThreads),
+  fSigFlucCDF(in.fSigFlucCDF),
+  fSigFlucMin(in.fSigFlucMin),
+  fSigFlucStep(in.fSigFlucStep),
+  fSigNNA(),
+  fSigNNB(),
+  fNCollA(),
+  fNCollB(),
+  fCellStart(),
+  fCellNucleons(),
+  fCandidates()
 {
   //copy ctor
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
@@ -453,6 +482,11 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fRandom=in.fRandom;
+  fNThreads=in.fNThreads;
+  fSigFlucCDF=in.fSigFlucCDF;
+  fSigFlucMin=in.fSigFlucMin;
+  fSigFlucStep=in.fSigFlucStep;
   return *this;
 }
 
@@ -461,49 +495,42 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc && fSigFlucCDF.empty())
+    BuildSigFlucTable();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
   fAN = fANucleus.GetN();
   fQAN = fAN * 3;
   //fAN = 3 * fANucleus.GetN(); // for Pb, Number of quark = 3*208;
+  fSigNNA.resize(fAN);
   for (Int_t i = 0; i<fAN; i++)
   {
     AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(GetRandomSigNN());
+    fSigNNA[i] = nucleonA->GetSigNN();
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
   //fBN = 3 * fBNucleus.GetN(); // Number of quark = number of nucleus*3;
   fBN = fBNucleus.GetN();
   fQBN = fBN * 3;
+  fSigNNB.resize(fBN);
   for (Int_t i = 0; i<fBN; i++)
   {
     AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(GetRandomSigNN());
+    fSigNNB[i] = nucleonB->GetSigNN();
   }
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
-  }
+  if (fDoFluc)
+    fXSect = GetRandomSigNN();
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
 
@@ -511,33 +538,99 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
 
+  const Double_t *xA = fANucleus.GetXs();
+  const Double_t *yA = fANucleus.GetYs();
+  const Double_t *xB = fBNucleus.GetXs();
+  const Double_t *yB = fBNucleus.GetYs();
+  fNCollA.assign(fAN,0);
+  fNCollB.assign(fBN,0);
+
+  // nucleons of A are sorted into cells of a 2d grid at least as large as the
+  // largest interaction distance, so that for each nucleon of B only the
+  // nucleons of A in the 3x3 neighbouring cells are tested; the candidates
+  // are tested in the order of the full A x B loop
+  const Int_t kMaxCells = 64;
+  Double_t d2max = d2;
+  if (fDoFluc) {
+    Double_t sigmax = 0;
+    for (Int_t j = 0; j<fAN; j++) sigmax = TMath::Max(sigmax,fSigNNA[j]);
+    for (Int_t i = 0; i<fBN; i++) sigmax = TMath::Max(sigmax,fSigNNB[i]);
+    d2max = sigmax/(TMath::Pi()*10);
+  }
+  Double_t xmin = 0, ymin = 0, cell = 0;
+  Int_t nx = 1, ny = 1;
+  if (fAN>0 && d2max>0) {
+    Double_t xmax = xA[0], ymax = yA[0];
+    xmin = xA[0];
+    ymin = yA[0];
+    for (Int_t j = 1; j<fAN; j++) {
+      xmin = TMath::Min(xmin,xA[j]);
+      xmax = TMath::Max(xmax,xA[j]);
+      ymin = TMath::Min(ymin,yA[j]);
+      ymax = TMath::Max(ymax,yA[j]);
+    }
+    cell = TMath::Max(TMath::Sqrt(d2max)*(1+1e-6),TMath::Max(xmax-xmin,ymax-ymin)/(kMaxCells-1));
+    nx = (Int_t)((xmax-xmin)/cell) + 1;
+    ny = (Int_t)((ymax-ymin)/cell) + 1;
+  }
+  fCellStart.assign(nx*ny+1,0);
+  fCellNucleons.resize(fAN);
+  for (Int_t j = 0; j<fAN && cell>0; j++)
+    fCellStart[(Int_t)((xA[j]-xmin)/cell)*ny+(Int_t)((yA[j]-ymin)/cell)+1]++;
+  for (Int_t c = 0; c<nx*ny; c++)
+    fCellStart[c+1] += fCellStart[c];
+  for (Int_t j = 0; j<fAN && cell>0; j++) {
+    Int_t c = (Int_t)((xA[j]-xmin)/cell)*ny+(Int_t)((yA[j]-ymin)/cell);
+    fCellNucleons[fCellStart[c]++] = j;
+  }
+  for (Int_t c = nx*ny; c>0; c--)
+    fCellStart[c] = fCellStart[c-1];
+  fCellStart[0] = 0;
+
   // for each of the A nucleons in nucleus B
-  for (Int_t i = 0; i<fBN; i++)
+  for (Int_t i = 0; i<fBN && cell>0; i++)
   {
-    AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
+    Double_t cx = TMath::Floor((xB[i]-xmin)/cell);
+    Double_t cy = TMath::Floor((yB[i]-ymin)/cell);
+    if (cx<-1 || cx>nx || cy<-1 || cy>ny) continue;
+    fCandidates.clear();
+    for (Int_t ix = TMath::Max((Int_t)cx-1,0); ix<=TMath::Min((Int_t)cx+1,nx-1); ix++) {
+      for (Int_t iy = TMath::Max((Int_t)cy-1,0); iy<=TMath::Min((Int_t)cy+1,ny-1); iy++) {
+        Int_t c = ix*ny+iy;
+        fCandidates.insert(fCandidates.end(),fCellNucleons.begin()+fCellStart[c],fCellNucleons.begin()+fCellStart[c+1]);
+      }
+    }
+    std::sort(fCandidates.begin(),fCandidates.end());
+    for (UInt_t k = 0; k<fCandidates.size(); k++)
     {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
+      Int_t j = fCandidates[k];
+      Double_t dx = xB[i]-xA[j];
+      Double_t dy = yB[i]-yA[j];
       Double_t dij = dx*dx+dy*dy;
       if (fDoFluc) {
-	//fXSect = nucleonA->GetSigNN();
-	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+	d2 = (Double_t)TMath::Max(fSigNNA[j],fSigNNB[i])/(TMath::Pi()*10); // in fm^2
       }
       if (dij < d2)
       {
 	bNN += dij;
 	++Nco;
-        nucleonB->Collide();
-        nucleonA->Collide();
+        fNCollB[i]++;
+        fNCollA[j]++;
 	if (dij<d2/4)
 	  ++Ncohc;
       }
     }
   }
+  if (fDoFluc && fAN>0 && fBN>0) {
+    // sigNN of the last pair, as left by the full A x B loop
+    //fXSect = nucleonA->GetSigNN();
+    //fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
+    fXSect = TMath::Max(fSigNNA[fAN-1],fSigNNB[fBN-1]);
+  }
+  for (Int_t j = 0; j<fAN; j++)
+    ((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j)))->SetNColl(fNCollA[j]);
+  for (Int_t i = 0; i<fBN; i++)
+    ((AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i)))->SetNColl(fNCollB[i]);
 
   if (Nco>0) {
     fNcollw = Ncohc;
@@ -1267,7 +1360,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1371,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=GetRandom()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1401,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandom()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1599,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*GetRandom()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1682,18 +1775,84 @@ Double_t AliGlauberMC::GetPsi4m2() const
 }
 */
 //______________________________________________________________________________
-void AliGlauberMC::Run(Int_t nevents)
+void AliGlauberMC::BookNtuple()
 {
-  //example run
-  cout << "Generating " << nevents << " events..." << endl;
+  //create the ntuple for the results
+  if (fnt) return;
   TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
   TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
-  if (fnt == 0)
+  fnt = new TNtuple(name,title,
+                    "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
+  fnt->SetDirectory(0);
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::Run(Int_t nevents)
+{
+  //example run
+  //with SetNThreads the events are generated in several threads, each with a copy of
+  //this generator and an own TRandom3 seeded from GetRandom(); the ntuples of the
+  //copies are merged into the one of this generator in the order of the threads.
+  //This needs the tabulated radii (SetRadiusTable), TF1::GetRandom is not thread safe
+  Int_t nThreads = (fNThreads > 0 ? fNThreads : (Int_t)std::thread::hardware_concurrency());
+  nThreads = TMath::Max(1,TMath::Min(nThreads,nevents));
+  if (nThreads == 1) {
+    RunEvents(nevents);
+    return;
+  }
+
+  // the tables are built once here and copied to the threads
+  fANucleus.BuildRadiusTable();
+  fBNucleus.BuildRadiusTable();
+  if (fANucleus.GetRadiusTable()<1 || fBNucleus.GetRadiusTable()<1) {
+    cout << "Radii from TF1::GetRandom are not thread safe (use SetRadiusTable), generating in one thread" << endl;
+    RunEvents(nevents);
+    return;
+  }
+  if (fDoFluc && fSigFlucCDF.empty())
+    BuildSigFlucTable();
+  BookNtuple();
+
+  cout << "Generating " << nevents << " events in " << nThreads << " threads..." << endl;
+  TList generators;
+  generators.SetOwner(kTRUE);
+  std::vector<TRandom*> randoms(nThreads);
+  for (Int_t i = 0; i<nThreads; i++)
   {
-    fnt = new TNtuple(name,title,
-                      "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
-    fnt->SetDirectory(0);
+    AliGlauberMC *gen = new AliGlauberMC(*this);
+    gen->fnt = 0;
+    gen->fEvents = 0;
+    gen->fTotalEvents = 0;
+    randoms[i] = new TRandom3(GetRandom()->Integer(kMaxUInt)+1);
+    gen->SetRandom(randoms[i]);
+    gen->BookNtuple();
+    generators.Add(gen);
   }
+
+  ROOT::EnableThreadSafety();
+  std::vector<std::thread> threads;
+  for (Int_t i = 0; i<nThreads; i++)
+  {
+    AliGlauberMC *gen = (AliGlauberMC*)generators.At(i);
+    Int_t n = nevents/nThreads + (i < nevents%nThreads ? 1 : 0);
+    threads.push_back(std::thread([gen,n]() { gen->RunEvents(n,kFALSE); }));
+  }
+  for (Int_t i = 0; i<nThreads; i++)
+    threads[i].join();
+
+  Merge(&generators);
+  generators.Delete();
+  for (Int_t i = 0; i<nThreads; i++)
+    delete randoms[i];
+  std::cout << "Done! Succesfull events:  " << fnt->GetEntries() << endl;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::RunEvents(Int_t nevents, Bool_t verbose)
+{
+  //generate nevents events and fill them into the ntuple
+  if (verbose) cout << "Generating " << nevents << " events..." << endl;
+  BookNtuple();
   Int_t q = 0;
   Int_t u = 0;
   for (Int_t i = 0; i<nevents; i++)
@@ -1772,9 +1931,94 @@ void AliGlauberMC::Run(Int_t nevents)
     //always at the end
     fnt->Fill(v);
 
-    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+    if (verbose && (i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  }
+  if (verbose) std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+Long64_t AliGlauberMC::Merge(TCollection* list)
+{
+  //merge the ntuples and event counts of generators run independently,
+  //e.g. in separate jobs or threads, each with its own random generator (SetRandom)
+  if (!list) return 0;
+  TIter next(list);
+  TObject *obj = 0;
+  while ((obj = next()))
+  {
+    AliGlauberMC *other = dynamic_cast<AliGlauberMC*>(obj);
+    if (!other || other==this) continue;
+    fEvents      += other->fEvents;
+    fTotalEvents += other->fTotalEvents;
+    if (other->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = other->fMaxNpartFound;
+    TNtuple *nt = other->GetNtuple();
+    if (!nt) continue;
+    BookNtuple();
+    if (nt->GetNvar() != fnt->GetNvar())
+    {
+      cout << "Cannot merge ntuple " << nt->GetName() << " with " << nt->GetNvar() << " variables into " << fnt->GetName() << endl;
+      continue;
+    }
+    for (Long64_t i = 0; i<nt->GetEntries(); i++)
+    {
+      nt->GetEntry(i);
+      fnt->Fill(nt->GetArgs());
+    }
+  }
+  return fnt ? fnt->GetEntries() : 0;
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::BuildSigFlucTable()
+{
+  //set up the parameterization of the fluctuating sigNN and tabulate its
+  //cumulative integral (trapezoid rule) for the sampling in GetRandomSigNN
+  if (!fSigFluc) {
+    fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+    cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
   }
-  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+  fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+
+  const Int_t nbins = 1000;
+  fSigFlucMin  = fSigFluc->GetXmin();
+  fSigFlucStep = (fSigFluc->GetXmax()-fSigFlucMin)/nbins;
+  fSigFlucCDF.assign(nbins+1,0);
+  Double_t last = 0;
+  for (Int_t i = 0; i<=nbins; i++) {
+    Double_t f = fSigFluc->Eval(fSigFlucMin + i*fSigFlucStep);
+    if (!TMath::Finite(f) || f<0) f = 0;
+    if (i>0) fSigFlucCDF[i] = fSigFlucCDF[i-1] + 0.5*fSigFlucStep*(last+f);
+    last = f;
+  }
+  if (!(fSigFlucCDF[nbins]>0))
+    cerr << "Fluctuating sigNN has no positive integral, using x-sect = " << fXSect << " mb" << endl;
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::GetRandomSigNN()
+{
+  //fluctuating sigNN from the inverse of the tabulated cumulative distribution
+  //of fSigFluc, linear within the bins, with the random generator GetRandom()
+  if (fSigFlucCDF.empty())
+    BuildSigFlucTable();
+  Int_t nbins = fSigFlucCDF.size()-1;
+  if (!(fSigFlucCDF[nbins]>0))
+    return fXSect;
+
+  Double_t area = GetRandom()->Rndm()*fSigFlucCDF[nbins];
+  Int_t bin = std::upper_bound(fSigFlucCDF.begin(),fSigFlucCDF.end(),area) - fSigFlucCDF.begin() - 1;
+  if (bin<0) bin = 0;
+  if (bin>nbins-1) bin = nbins-1;
+  Double_t width = fSigFlucCDF[bin+1]-fSigFlucCDF[bin];
+  Double_t t = width>0 ? (area-fSigFlucCDF[bin])/width : 0.5;
+  return fSigFlucMin + (bin+t)*fSigFlucStep;
+}
+
+//______________________________________________________________________________
+TRandom *AliGlauberMC::GetRandom() const
+{
+  //random generator for the impact parameter, the nucleon positions and the particle production
+  return fRandom ? fRandom : gRandom;
 }
 
 //---------------------------------------------------------------------------------
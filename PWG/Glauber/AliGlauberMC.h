@@ -14,11 +14,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "AliGlauberNucleus.h"
+#include <vector>
 #include <Riostream.h>
 #include <TNamed.h>
 
+class TCollection;
 class TObjArray;
 class TNtuple;
+class TRandom;
 
 using std::cout;
 using std::endl;
@@ -39,6 +42,8 @@ public:
    void         Draw(Option_t* option);
 
    void         Run(Int_t nevents);
+   void         RunEvents(Int_t nevents, Bool_t verbose=kTRUE);
+   Long64_t     Merge(TCollection* list);
    Bool_t       NextEvent(Double_t bgen=-1);
    Bool_t       CalcEvent(Double_t bgen);
 
@@ -96,10 +101,14 @@ public:
    void   SetBmax(Double_t bmax)      {fBMax = bmax;}
    void   SetMinDistance(Double_t d)  {fANucleus.SetMinDist(d); fBNucleus.SetMinDist(d);}
    void   SetDoPartProduction(Bool_t b) { fDoPartProd = b; }
+   void   SetRadiusTable(Int_t nbins) {fANucleus.SetRadiusTable(nbins); fBNucleus.SetRadiusTable(nbins);}
+   void   SetRandom(TRandom* rnd)     {fRandom=rnd; fANucleus.SetRandom(rnd); fBNucleus.SetRandom(rnd);}
+   TRandom *GetRandom() const;
+   void   SetNThreads(Int_t n=0)      {fNThreads=n;} // threads used by Run (0: number of cores)
    void   Setr(Double_t r)  {fANucleus.SetR(r); fBNucleus.SetR(r);}
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
-            {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+            {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;fSigFlucCDF.clear();}
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -251,9 +260,24 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   TRandom     *fRandom;         //!random generator, gRandom if not set
+   Int_t        fNThreads;       //number of threads used by Run
+   std::vector<Double_t> fSigFlucCDF; //!cumulative integral of fSigFluc at the bin edges
+   Double_t     fSigFlucMin;     //!lower edge of the fSigFluc table
+   Double_t     fSigFlucStep;    //!bin width of the fSigFluc table
+   std::vector<Double_t> fSigNNA;     //!sigNN of the nucleons in nucleus A
+   std::vector<Double_t> fSigNNB;     //!sigNN of the nucleons in nucleus B
+   std::vector<Int_t>    fNCollA;     //!collisions of the nucleons in nucleus A
+   std::vector<Int_t>    fNCollB;     //!collisions of the nucleons in nucleus B
+   std::vector<Int_t>    fCellStart;  //!first entry of each cell in fCellNucleons
+   std::vector<Int_t>    fCellNucleons; //!nucleons of nucleus A sorted by cell
+   std::vector<Int_t>    fCandidates; //!nucleons of nucleus A near a nucleon of nucleus B
    Bool_t       CalcResults(Double_t bgen);
+   void         BookNtuple();
+   void         BuildSigFlucTable();
+   Double_t     GetRandomSigNN();
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
@@ -41,6 +41,7 @@ public:
    Bool_t     IsSpectator()  const {return !fNColl;}
    Bool_t     IsWounded()    const {return fNColl;}
    void       Reset()              {fNColl=0;}
+   void       SetNColl(Int_t n)    {fNColl=n;}
    void       SetInNucleusA()      {fInNucleusA=1;}
    void       SetInNucleusB()      {fInNucleusA=0;}
    void       SetSigNN(Double_t s) {fSigNN=s;}
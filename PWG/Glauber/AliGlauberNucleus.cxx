@@ -24,6 +24,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <Riostream.h>
+#include <algorithm>
 #include <TMath.h>
 #include <TEllipse.h>
 #include <TNamed.h>
@@ -49,7 +50,22 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fNRadiusBins(0),
+  fRandom(0),
+  fXs(),
+  fYs(),
+  fZs(),
+  fRadiusCDF(),
+  fRadiusPDF(),
+  fRadiusMin(0),
+  fRadiusStep(0),
+  fGridHead(),
+  fGridNext(),
+  fGridCell(),
+  fGridN(0),
+  fGridSize(0),
+  fGridMin(0)
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -76,12 +92,29 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fMinDist(in.fMinDist),
   fF(in.fF),
   fTrials(in.fTrials),
-  fFunction(in.fFunction),
-  fNucleons(NULL)
+  fFunction(in.fFunction ? new TF1(*in.fFunction) : 0),
+  fNucleons(NULL),
+  fNRadiusBins(in.fNRadiusBins),
+  fRandom(in.fRandom),
+  fXs(),
+  fYs(),
+  fZs(),
+  fRadiusCDF(in.fRadiusCDF),
+  fRadiusPDF(in.fRadiusPDF),
+  fRadiusMin(in.fRadiusMin),
+  fRadiusStep(in.fRadiusStep),
+  fGridHead(),
+  fGridNext(),
+  fGridCell(),
+  fGridN(0),
+  fGridSize(0),
+  fGridMin(0)
 {
-  //copy ctor
-  if (in.fNucleons)
+  //copy ctor, with an own copy of the density function
+  if (in.fNucleons) {
     fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
+    fNucleons->SetOwner();
+  }
 }
 
 //______________________________________________________________________________
@@ -96,7 +129,15 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fMinDist=in.fMinDist;
   fF=in.fF;
   fTrials=in.fTrials;
-  fFunction=in.fFunction;
+  delete fFunction;
+  fFunction=in.fFunction ? new TF1(*in.fFunction) : 0;
+  fNRadiusBins=in.fNRadiusBins;
+  fRandom=in.fRandom;
+  fRadiusCDF=in.fRadiusCDF;
+  fRadiusPDF=in.fRadiusPDF;
+  fRadiusMin=in.fRadiusMin;
+  fRadiusStep=in.fRadiusStep;
+  fGridN=0;
   delete fNucleons;
   fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
   fNucleons->SetOwner();
@@ -177,6 +218,7 @@ void AliGlauberNucleus::Lookup(Option_t* name)
 void AliGlauberNucleus::SetR(Double_t ir)
 {
    fR = ir;
+   fRadiusCDF.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -195,6 +237,7 @@ void AliGlauberNucleus::SetR(Double_t ir)
 void AliGlauberNucleus::SetA(Double_t ia)
 {
    fA = ia;
+   fRadiusCDF.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -212,6 +255,7 @@ void AliGlauberNucleus::SetA(Double_t ia)
 void AliGlauberNucleus::SetW(Double_t iw)
 {
    fW = iw;
+   fRadiusCDF.clear();
    switch (fF)
    {
       case 0: // Proton
@@ -225,6 +269,78 @@ void AliGlauberNucleus::SetW(Double_t iw)
    }
 }
 
+//______________________________________________________________________________
+TRandom *AliGlauberNucleus::GetRandom() const
+{
+   // random generator used for the nucleon positions
+   return fRandom ? fRandom : gRandom;
+}
+
+//______________________________________________________________________________
+void AliGlauberNucleus::BuildRadiusTable()
+{
+   // tabulate rho(r) and its cumulative integral (trapezoid rule, exact for
+   // the piecewise linear density sampled in GetRandomRadius) in the range of fFunction
+   fRadiusCDF.clear();
+   fRadiusPDF.clear();
+   if (!fFunction || fNRadiusBins<1) return;
+
+   fRadiusMin  = fFunction->GetXmin();
+   fRadiusStep = (fFunction->GetXmax()-fRadiusMin)/fNRadiusBins;
+   fRadiusPDF.resize(fNRadiusBins+1);
+   for (Int_t i = 0; i<=fNRadiusBins; i++) {
+      Double_t rho = fFunction->Eval(fRadiusMin + i*fRadiusStep);
+      fRadiusPDF[i] = (TMath::Finite(rho) && rho>0) ? rho : 0;
+   }
+   fRadiusCDF.resize(fNRadiusBins+1);
+   fRadiusCDF[0] = 0;
+   for (Int_t i = 1; i<=fNRadiusBins; i++)
+      fRadiusCDF[i] = fRadiusCDF[i-1] + 0.5*fRadiusStep*(fRadiusPDF[i-1]+fRadiusPDF[i]);
+   if (!(fRadiusCDF[fNRadiusBins]>0)) {
+      cerr << "Density of nucleus " << GetName() << " has no positive integral, using TF1::GetRandom" << endl;
+      fRadiusCDF.clear();
+      fRadiusPDF.clear();
+      fNRadiusBins = 0;
+   }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::GetRandomRadius()
+{
+   // radius distributed according to rho(r): TF1::GetRandom (from gRandom) by default,
+   // the tabulated inverse cumulative distribution with GetRandom() after SetRadiusTable(n)
+   if (fNRadiusBins<1) return fFunction->GetRandom();
+   if (fRadiusCDF.empty()) {
+      BuildRadiusTable();
+      if (fNRadiusBins<1) return fFunction->GetRandom();
+   }
+
+   Double_t area = GetRandom()->Rndm()*fRadiusCDF[fNRadiusBins];
+   Int_t bin = std::upper_bound(fRadiusCDF.begin(),fRadiusCDF.end(),area) - fRadiusCDF.begin() - 1;
+   if (bin<0) bin = 0;
+   if (bin>fNRadiusBins-1) bin = fNRadiusBins-1;
+
+   // solve f0*t + s*t^2/2 = area for the linear density f0 + s*t within the bin
+   area -= fRadiusCDF[bin];
+   Double_t f0    = fRadiusPDF[bin];
+   Double_t slope = (fRadiusPDF[bin+1]-f0)/fRadiusStep;
+   Double_t disc  = f0*f0 + 2*slope*area;
+   Double_t denom = f0 + TMath::Sqrt(disc>0 ? disc : 0);
+   Double_t t     = denom>0 ? 2*area/denom : 0;
+   if (t>fRadiusStep) t = fRadiusStep;
+   return fRadiusMin + bin*fRadiusStep + t;
+}
+
+//______________________________________________________________________________
+Int_t AliGlauberNucleus::GridIndex(Double_t v) const
+{
+   // cell of the hard-core grid along one axis, clamped to the grid
+   Double_t i = TMath::Floor((v-fGridMin)/fGridSize);
+   if (!(i>0)) return 0;
+   if (i>=fGridN) return fGridN-1;
+   return (Int_t)i;
+}
+
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
@@ -236,6 +352,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 	 fNucleons->Add(nucleon); 
       }
    } 
+   fXs.resize(fN);
+   fYs.resize(fN);
+   fZs.resize(fN);
    
    fTrials = 0;
 
@@ -243,63 +362,108 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Double_t sumy=0;       
    Double_t sumz=0;       
 
+   TRandom *rnd = GetRandom();
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = GetRandomRadius()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
-      AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
-      AliGlauberNucleon *nucleon2=(AliGlauberNucleon*)(fNucleons->UncheckedAt(1));
-      nucleon1->Reset();
-      nucleon1->SetXYZ(r * stheta * cos(phi) + xshift,
-		       r * stheta * sin(phi),
-		       r * ctheta);
-      nucleon2->Reset();
-      nucleon2->SetXYZ(-nucleon1->GetX() + 2*xshift,
-		       -nucleon1->GetY(),
-		       -nucleon1->GetZ());
+      fXs[0] = r * stheta * cos(phi) + xshift;
+      fYs[0] = r * stheta * sin(phi);
+      fZs[0] = r * ctheta;
+      fXs[1] = -fXs[0] + 2*xshift;
+      fYs[1] = -fYs[0];
+      fZs[1] = -fZs[0];
+      for (Int_t i = 0; i<fN; i++) {
+         AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
+         nucleon->Reset();
+         nucleon->SetXYZ(fXs[i],fYs[i],fZs[i]);
+      }
       fTrials = 1;
       return;
    }
 
+   // the minimum distance is checked against the nucleons in the neighbouring
+   // cells of a 3d grid (cell size >= fMinDist) around the centre of the nucleus
+   Bool_t useGrid = (fMinDist>0 && fN>1);
+   if (useGrid) {
+      const Int_t kMaxCells = 32;
+      Double_t rmax = TMath::Abs(fFunction->GetXmax());
+      Double_t size = TMath::Max(fMinDist,2*rmax/kMaxCells);
+      if (fGridN==0 || fGridSize!=size || fGridMin!=-rmax) {
+         fGridSize = size;
+         fGridMin  = -rmax;
+         fGridN    = TMath::Min(kMaxCells,(Int_t)TMath::Ceil(2*rmax/size)) + 1;
+         fGridHead.assign(fGridN*fGridN*fGridN,-1);
+      }
+      fGridNext.resize(fN);
+      fGridCell.resize(fN);
+   }
+
    for (Int_t i = 0; i<fN; i++) {
-      AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
-      nucleon->Reset();
+      Int_t ix=0, iy=0, iz=0;
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = GetRandomRadius();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
          Double_t z = r * ctheta;      
-         nucleon->SetXYZ(x,y,z);
+         fXs[i] = x;
+         fYs[i] = y;
+         fZs[i] = z;
          if(fMinDist<0) break;
          Bool_t test=1;
-         for (Int_t j = 0; j<i; j++) {
-            AliGlauberNucleon *other=(AliGlauberNucleon*)fNucleons->UncheckedAt(j);
-            Double_t xo=other->GetX();
-            Double_t yo=other->GetY();
-            Double_t zo=other->GetZ();
-            Double_t dist = TMath::Sqrt((x-xo)*(x-xo)+
-                                       (y-yo)*(y-yo)+
-                                       (z-zo)*(z-zo));
-	       
-            if(dist<fMinDist) {
-               test=0;
-               break;
+         if (useGrid) {
+            ix = GridIndex(x-xshift);
+            iy = GridIndex(y);
+            iz = GridIndex(z);
+            for (Int_t jx = TMath::Max(ix-1,0); test && jx<=TMath::Min(ix+1,fGridN-1); jx++) {
+               for (Int_t jy = TMath::Max(iy-1,0); test && jy<=TMath::Min(iy+1,fGridN-1); jy++) {
+                  for (Int_t jz = TMath::Max(iz-1,0); test && jz<=TMath::Min(iz+1,fGridN-1); jz++) {
+                     for (Int_t j = fGridHead[(jx*fGridN+jy)*fGridN+jz]; j>=0; j = fGridNext[j]) {
+                        Double_t dist = TMath::Sqrt((x-fXs[j])*(x-fXs[j])+
+                                                    (y-fYs[j])*(y-fYs[j])+
+                                                    (z-fZs[j])*(z-fZs[j]));
+                        if(dist<fMinDist) {
+                           test=0;
+                           break;
+                        }
+                     }
+                  }
+               }
+            }
+         } else {
+            for (Int_t j = 0; j<i; j++) {
+               Double_t dist = TMath::Sqrt((x-fXs[j])*(x-fXs[j])+
+                                           (y-fYs[j])*(y-fYs[j])+
+                                           (z-fZs[j])*(z-fZs[j]));
+               if(dist<fMinDist) {
+                  test=0;
+                  break;
+               }
             }
          }
          if (test) break; //found nucleuon outside of mindist
       }
+      if (useGrid) {
+         Int_t cell = (ix*fGridN+iy)*fGridN+iz;
+         fGridCell[i] = cell;
+         fGridNext[i] = fGridHead[cell];
+         fGridHead[cell] = i;
+      }
            
-      sumx += nucleon->GetX();
-      sumy += nucleon->GetY();
-      sumz += nucleon->GetZ();
+      sumx += fXs[i];
+      sumy += fYs[i];
+      sumz += fZs[i];
+   }
+   if (useGrid) { // empty the grid for the next nucleus
+      for (Int_t i = 0; i<fN; i++) fGridHead[fGridCell[i]] = -1;
    }
       
    if(1) { // set the centre-of-mass to be at zero (+xshift)
@@ -307,11 +471,12 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       sumy = sumy/fN;  
       sumz = sumz/fN;  
       for (Int_t i = 0; i<fN; i++) {
+         fXs[i] = fXs[i]-sumx-xshift;
+         fYs[i] = fYs[i]-sumy;
+         fZs[i] = fZs[i]-sumz;
          AliGlauberNucleon *nucleon=(AliGlauberNucleon*)(fNucleons->UncheckedAt(i));
-         nucleon->SetXYZ(nucleon->GetX()-sumx-xshift,
-                         nucleon->GetY()-sumy,
-                         nucleon->GetZ()-sumz);
+         nucleon->Reset();
+         nucleon->SetXYZ(fXs[i],fYs[i],fZs[i]);
       }
    }
 }
-
@@ -15,9 +15,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 //class TNamed;
+#include <vector>
 #include <TNamed.h>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +32,25 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   Int_t      fNRadiusBins;//Bins of the tabulated rho(r), 0 = TF1::GetRandom with gRandom
+   TRandom*   fRandom;     //!Random generator, gRandom if not set
+   std::vector<Double_t> fXs;          //!x of the nucleons
+   std::vector<Double_t> fYs;          //!y of the nucleons
+   std::vector<Double_t> fZs;          //!z of the nucleons
+   std::vector<Double_t> fRadiusCDF;   //!Cumulative rho(r) at the bin edges
+   std::vector<Double_t> fRadiusPDF;   //!rho(r) at the bin edges
+   Double_t   fRadiusMin;  //!Lower edge of the table
+   Double_t   fRadiusStep; //!Bin width of the table
+   std::vector<Int_t>    fGridHead;    //!First nucleon in each cell of the hard-core grid
+   std::vector<Int_t>    fGridNext;    //!Next nucleon in the same cell
+   std::vector<Int_t>    fGridCell;    //!Cell of each nucleon
+   Int_t      fGridN;      //!Cells per dimension
+   Double_t   fGridSize;   //!Cell size
+   Double_t   fGridMin;    //!Lower edge of the grid
 
    void       Lookup(Option_t* name);
+   Double_t   GetRandomRadius();
+   Int_t      GridIndex(Double_t v) const;
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -46,15 +65,23 @@ public:
    Double_t   GetA()             const {return fA;}
    Double_t   GetW()             const {return fW;}
    TObjArray *GetNucleons()      const {return fNucleons;}
+   const Double_t *GetXs()       const {return fXs.empty() ? 0 : &fXs[0];}
+   const Double_t *GetYs()       const {return fYs.empty() ? 0 : &fYs[0];}
+   const Double_t *GetZs()       const {return fZs.empty() ? 0 : &fZs[0];}
    Int_t      GetTrials()        const {return fTrials;}
+   Int_t      GetRadiusTable()   const {return fNRadiusBins;}
+   TRandom   *GetRandom()        const;
    void       SetN(Int_t in)           {fN=in;}
    void       SetR(Double_t ir);
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRadiusTable(Int_t nbins) {fNRadiusBins=nbins; fRadiusCDF.clear();}
+   void       SetRandom(TRandom *rnd)  {fRandom=rnd;}
+   void       BuildRadiusTable();
    void       ThrowNucleons(Double_t xshift=0.);
 
-   ClassDef(AliGlauberNucleus,1)
+   ClassDef(AliGlauberNucleus,2)
 };
 
 #endif
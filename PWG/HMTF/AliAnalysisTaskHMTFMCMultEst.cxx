@@ -25,14 +25,14 @@ ClassImp(AliAnalysisTaskHMTFMCMultEst)
 
 //________________________________________________________________________
 AliAnalysisTaskHMTFMCMultEst::AliAnalysisTaskHMTFMCMultEst()
-: AliAnalysisTaskSE(), fMyOut(0), fClassifiers(0), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
+: AliAnalysisTaskSE(), fMyOut(0), fClassifiers(0), fPrimaries(), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
   fGlobalTriggerClassifiers(0)
 {
 }
 
 //________________________________________________________________________
 AliAnalysisTaskHMTFMCMultEst::AliAnalysisTaskHMTFMCMultEst(const char *name)
-  : AliAnalysisTaskSE(name), fMyOut(0), fClassifiers(0), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
+  : AliAnalysisTaskSE(name), fMyOut(0), fClassifiers(0), fPrimaries(), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
     fGlobalTriggerClassifiers(0)
 {
   DefineOutput(1, TList::Class());
@@ -100,6 +100,11 @@ void AliAnalysisTaskHMTFMCMultEst::UserCreateOutputObjects()
     new AliEventClassifierSphericity("sphericity", "sphericity", fMyOut);
   fClassifiers.push_back(refClassifierSphericity);
 
+  // All classifiers use the primaries extracted once per event by the task
+  for (Int_t i = 0; i < fClassifiers.size(); i++) {
+    fClassifiers[i]->SetPrimaries(&fPrimaries);
+  }
+
   // Set the global trigger if one was defined for this task
   // Remember to reset the classifiers used here as well (if new ones are defined just for the trigger)
   if (fGlobalTrigger == kINEL) {
@@ -141,6 +146,8 @@ void AliAnalysisTaskHMTFMCMultEst::UserExec(Option_t *)
   for (Int_t i = 0; i < fClassifiers.size(); i++) {
     fClassifiers[i]->ResetClassifier();
   }
+  // the AliMCEvent object is reused for all events: forget the primaries of the previous one
+  fPrimaries.Clear();
 
   // Load event
   AliMCEvent* mcEvent = MCEvent();
@@ -149,6 +156,7 @@ void AliAnalysisTaskHMTFMCMultEst::UserExec(Option_t *)
      return;
   }
   AliStack  *stack = mcEvent->Stack();
+  fPrimaries.Fill(mcEvent, stack);
 
   // do we have the right trigger?
   if (((fGlobalTrigger == kINEL) && IsInel(mcEvent, stack)) ||
@@ -4,6 +4,7 @@
 #include "AliAnalysisTaskSE.h"
 
 #include "AliEventClassifierBase.h"
+#include "AliEventClassifierPrimaries.h"
 #include "AliObservableBase.h"
 
 class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
@@ -22,6 +23,7 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
  private:
   TList *fMyOut;                          // Output list
   std::vector<AliEventClassifierBase*> fClassifiers;
+  AliEventClassifierPrimaries fPrimaries; //! Primaries of the current event, shared by all classifiers
   std::vector<AliObservableBase*> fObservables;
 
   Int_t fGlobalTrigger;
@@ -43,7 +45,7 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
   AliAnalysisTaskHMTFMCMultEst(const AliAnalysisTaskHMTFMCMultEst&); // not implemented
   AliAnalysisTaskHMTFMCMultEst& operator=(const AliAnalysisTaskHMTFMCMultEst&); // not implemented
 
-  ClassDef(AliAnalysisTaskHMTFMCMultEst, 2); // example of analysis
+  ClassDef(AliAnalysisTaskHMTFMCMultEst, 3); // example of analysis
 };
 
 #endif
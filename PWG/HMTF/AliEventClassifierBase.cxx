@@ -19,7 +19,9 @@ AliEventClassifierBase::AliEventClassifierBase()
   fCollisionSystem(0),
   fClassifierValueIsCached(false),
   fClassifierOutputList(0),
-  fTaskOutputList(0)
+  fTaskOutputList(0),
+  fPrimaries(0),
+  fOwnPrimaries()
 {
   
 }
@@ -31,7 +33,9 @@ AliEventClassifierBase::AliEventClassifierBase(const char* name, const char* tit
     fCollisionSystem(collisionSystem),
     fClassifierValueIsCached(false),
     fClassifierOutputList(0),
-    fTaskOutputList(taskOutputList)
+    fTaskOutputList(taskOutputList),
+    fPrimaries(0),
+    fOwnPrimaries()
 {
   fClassifierOutputList = new TList();
   fClassifierOutputList->SetName(name);
@@ -46,3 +50,10 @@ Float_t AliEventClassifierBase::GetClassifierValue(AliMCEvent *event, AliStack *
   }
   return fClassifierValue;
 }
+
+const AliEventClassifierPrimaries* AliEventClassifierBase::GetPrimaries(AliMCEvent *event, AliStack *stack) {
+  if (fPrimaries && fPrimaries->IsFilled())
+    return fPrimaries;
+  fOwnPrimaries.Fill(event, stack);
+  return &fOwnPrimaries;
+}
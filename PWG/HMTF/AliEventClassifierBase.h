@@ -7,6 +7,8 @@
 #include "AliMCEvent.h"
 #include "AliStack.h"
 
+#include "AliEventClassifierPrimaries.h"
+
 class AliEventClassifierBase : public TNamed {
  public:
   AliEventClassifierBase();
@@ -18,9 +20,13 @@ class AliEventClassifierBase : public TNamed {
   TList* GetClassifierOutputList() {return fClassifierOutputList;}
   Int_t GetExpectedMinValue() {return fExpectedMinValue;}
   Int_t GetExpectedMaxValue() {return fExpectedMaxValue;}
+  // Primaries of the current event, extracted by the task and shared by all classifiers
+  void SetPrimaries(const AliEventClassifierPrimaries *primaries) {fPrimaries = primaries;}
 
  protected:
   virtual void CalculateClassifierValue(AliMCEvent *event, AliStack *stack) = 0;
+  // The shared primaries if they were filled for this event, otherwise they are extracted here
+  const AliEventClassifierPrimaries* GetPrimaries(AliMCEvent *event, AliStack *stack);
   Bool_t fClassifierValueIsCached;    // Is the classifier value already computed?
   Float_t fClassifierValue;           // The value for this classifier for the current event
   Int_t fExpectedMinValue;            // The expected min value produced by this estimator, used for hists
@@ -29,8 +35,10 @@ class AliEventClassifierBase : public TNamed {
   
   TList *fClassifierOutputList;  // The "folder" in which the hists binned in this classifier a saved
   TList *fTaskOutputList;        // The list for the entire task
+  const AliEventClassifierPrimaries *fPrimaries;  //! Primaries shared by the classifiers of the task
+  AliEventClassifierPrimaries fOwnPrimaries;      //! Primaries if no shared ones are available
 
-  ClassDef(AliEventClassifierBase, 2);
+  ClassDef(AliEventClassifierBase, 3);
 };
 
 #endif
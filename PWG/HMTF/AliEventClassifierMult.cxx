@@ -43,25 +43,14 @@ AliEventClassifierMult::AliEventClassifierMult(const char* name, const char* tit
 
 void AliEventClassifierMult::CalculateClassifierValue(AliMCEvent *event, AliStack *stack) {
   fClassifierValue = 0.0;
-  for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++) {
-    AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-    // load track
-    if (!track) {
-      Printf("ERROR: Could not receive track %d", iTrack);
-      continue;
-    }
-    // discard unphysical particles from some generators
-    if (track->Pt() == 0 || track->E() <= 0)
-      continue;
-
-    // Only calculate for primaries (Aliroot definition excluding Pi0)
-    if (!stack->IsPhysicalPrimary(iTrack)) continue;
-
+  // Only calculate for primaries (Aliroot definition excluding Pi0)
+  const AliEventClassifierPrimaries *primaries = GetPrimaries(event, stack);
+  for (Int_t iPrimary = 0; iPrimary < primaries->GetNumberOfPrimaries(); iPrimary++) {
     // do we count charged or neutral?
-    if (track->Charge() == 0 && fCountCharged) continue;
+    if (primaries->GetCharge(iPrimary) == 0 && fCountCharged) continue;
 
     // does this track fall into any of the defined regions?
-    Double_t eta = track->Eta();
+    Double_t eta = primaries->GetEta(iPrimary);
     Bool_t trackIsInRegion = false;
     for(Int_t i = 0; i != fRegions.size(); i++) {
       if(eta >= fRegions[i][0] && eta <=fRegions[i][1]) {
@@ -0,0 +1,53 @@
+#include "TMath.h"
+
+#include "AliMCEvent.h"
+#include "AliMCParticle.h"
+#include "AliStack.h"
+
+#include "AliEventClassifierPrimaries.h"
+
+AliEventClassifierPrimaries::AliEventClassifierPrimaries()
+  : fFilled(kFALSE),
+    fPt(),
+    fEta(),
+    fPhi(),
+    fCharge(),
+    fPx(),
+    fPy()
+{
+}
+
+void AliEventClassifierPrimaries::Clear() {
+  fFilled = kFALSE;
+  fPt.clear();
+  fEta.clear();
+  fPhi.clear();
+  fCharge.clear();
+  fPx.clear();
+  fPy.clear();
+}
+
+void AliEventClassifierPrimaries::Fill(AliMCEvent *event, AliStack *stack) {
+  Clear();
+  for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++) {
+    AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
+    if (!track) {
+      Printf("ERROR: Could not receive track %d", iTrack);
+      continue;
+    }
+    // discard unphysical particles from some generators
+    if (track->Pt() == 0 || track->E() <= 0)
+      continue;
+
+    // Only primaries (Aliroot definition excluding Pi0)
+    if (!stack->IsPhysicalPrimary(iTrack)) continue;
+
+    fPt.push_back(track->Pt());
+    fEta.push_back(track->Eta());
+    fPhi.push_back(track->Phi());
+    fCharge.push_back(track->Charge());
+    fPx.push_back(track->Pt() * TMath::Cos(track->Phi()));
+    fPy.push_back(track->Pt() * TMath::Sin(track->Phi()));
+  }
+  fFilled = kTRUE;
+}
@@ -0,0 +1,42 @@
+#ifndef AliEventClassifierPrimaries_cxx
+#define AliEventClassifierPrimaries_cxx
+
+#include <vector>
+
+#include "Rtypes.h"
+
+class AliMCEvent;
+class AliStack;
+
+// The physical primaries of an MC event (excluding unphysical particles with pt == 0 or E <= 0),
+// extracted once per event and shared by the event classifiers instead of each classifier
+// looping over the full MC event. The MC handler reuses the same AliMCEvent object for all
+// events, so the owner has to Clear() the primaries at the beginning of every event.
+class AliEventClassifierPrimaries {
+ public:
+  AliEventClassifierPrimaries();
+  virtual ~AliEventClassifierPrimaries() {}
+
+  void Fill(AliMCEvent *event, AliStack *stack);
+  void Clear();
+  Bool_t IsFilled() const {return fFilled;}
+
+  Int_t GetNumberOfPrimaries() const {return fPt.size();}
+  Double_t GetPt(Int_t i) const {return fPt[i];}
+  Double_t GetEta(Int_t i) const {return fEta[i];}
+  Double_t GetPhi(Int_t i) const {return fPhi[i];}
+  Short_t GetCharge(Int_t i) const {return fCharge[i];}
+  Float_t GetPx(Int_t i) const {return fPx[i];}  // pt * cos(phi)
+  Float_t GetPy(Int_t i) const {return fPy[i];}  // pt * sin(phi)
+
+ private:
+  Bool_t fFilled;                 // Filled for the current event
+  std::vector<Double_t> fPt;      // Transverse momentum
+  std::vector<Double_t> fEta;     // Pseudorapidity
+  std::vector<Double_t> fPhi;     // Azimuth
+  std::vector<Short_t> fCharge;   // Charge
+  std::vector<Float_t> fPx;       // Transverse momentum in x
+  std::vector<Float_t> fPy;       // Transverse momentum in y
+};
+
+#endif
@@ -33,24 +33,16 @@ void AliEventClassifierSphericity::CalculateClassifierValue(AliMCEvent *event, A
   Float_t s11=0;
   Float_t totalpt=0;
 
-  Int_t ntracks = event->GetNumberOfTracks();
-  for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
-    AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-    if (!track)
-      continue;
-    // Only calculate for primaries (Aliroot definition excluding Pi0)
-    if (!stack->IsPhysicalPrimary(iTrack))
-      continue;
-    // discard unphysical particles from some generators
-    if (track->Pt() == 0 || track->E() <= 0)
-      continue;
-    
-    Float_t px = track->Pt() * TMath::Cos( track->Phi() );
-    Float_t py = track->Pt() * TMath::Sin( track->Phi() );
-    s00 += (px * px) / track->Pt();
-    s01 += (py * px) / track->Pt();
-    s11 += (py * py) / track->Pt();
-    totalpt += track->Pt();
+  // Only calculate for primaries (Aliroot definition excluding Pi0)
+  const AliEventClassifierPrimaries *primaries = GetPrimaries(event, stack);
+  for (Int_t iPrimary = 0; iPrimary < primaries->GetNumberOfPrimaries(); iPrimary++) {
+    Double_t pt = primaries->GetPt(iPrimary);
+    Float_t px = primaries->GetPx(iPrimary);
+    Float_t py = primaries->GetPy(iPrimary);
+    s00 += (px * px) / pt;
+    s01 += (py * px) / pt;
+    s11 += (py * py) / pt;
+    totalpt += pt;
   }
   // did we have valid tracks or did we never reach the bottom of the for loop?
   if (!(totalpt > 0)) {
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <utility>
 #include <vector>
 #include <iostream>
 
@@ -23,67 +25,58 @@ AliEventClassifierSpherocity::AliEventClassifierSpherocity(const char* name, con
   fExpectedMaxValue = 1;
 }
 
-Bool_t AliEventClassifierSpherocity::TrackPassesSelection(AliMCParticle* track, AliStack *stack, Int_t iTrack) {
-    if (!track) {
-      Printf("ERROR: Could not receive track %d", iTrack);
-      return false;
-    }
-    // discard unphysical particles from some generators
-    if (track->Pt() == 0 || track->E() <= 0)
-      return false;
-
-    // Only calculate for primaries (Aliroot definition excluding Pi0)
-    if (!stack->IsPhysicalPrimary(iTrack)) return false;
-
-    // Restrict to |eta| < 0.8
-    if (TMath::Abs(track->Eta()) > 0.8) return false;
-
-    return true;
-}
-
 void AliEventClassifierSpherocity::CalculateClassifierValue(AliMCEvent *event, AliStack *stack) {
   // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
+  // The sum of |n x pT| is minimized exactly over the unit vectors n of the transverse plane
+  // instead of scanning n in steps of 0.1 degree: between two consecutive particle directions
+  // the sum is a concave function of the angle of n, so the minimum is reached for n along
+  // one of the particles. These directions are visited in increasing angle in [0, pi), the sum
+  // being kept as n x (sum of s_i pT_i), where s_i is the sign of the term of particle i and
+  // flips when n passes the direction of particle i.
   fClassifierValue = 0.0;
 
-  Float_t sumRatioSquare = 0;
-  Float_t minimalSumRatioSquare = 2;
-  
-  // Step size in phi unit vector used to find m spherocity
-  Float_t phiStepSize = 0.1;
+  Double_t minimalSumRatioSquare = 2;
+
+  // Primaries in |eta| < 0.8, with their direction in [0, pi)
+  const AliEventClassifierPrimaries *primaries = GetPrimaries(event, stack);
+  std::vector<std::pair<Double_t, Int_t> > directions;
+  std::vector<Int_t> signs(primaries->GetNumberOfPrimaries(), 0);
+  Double_t sumapt = 0;
+  Double_t sumx = 0;  // sum of s_i px_i
+  Double_t sumy = 0;  // sum of s_i py_i
+  for (Int_t iPrimary = 0; iPrimary < primaries->GetNumberOfPrimaries(); iPrimary++) {
+    if (TMath::Abs(primaries->GetEta(iPrimary)) > 0.8) continue;
+    Double_t px = primaries->GetPx(iPrimary);
+    Double_t py = primaries->GetPy(iPrimary);
+    sumapt += primaries->GetPt(iPrimary);
 
-  // Computing total pt
-  Float_t sumapt = 0;
-  Int_t ntracks = event->GetNumberOfTracks();
-  for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
-    AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-    if (!TrackPassesSelection(track, stack, iTrack)) continue;
-    sumapt += track->Pt();
+    // for n along x the term of particle i is py_i
+    signs[iPrimary] = (py >= 0) ? 1 : -1;
+    sumx += signs[iPrimary] * px;
+    sumy += signs[iPrimary] * py;
+
+    Double_t direction = TMath::ATan2(py, px);
+    if (direction < 0) direction += TMath::Pi();
+    if (direction >= TMath::Pi()) direction -= TMath::Pi();
+    directions.push_back(std::make_pair(direction, iPrimary));
   }
-  
-  // Getting thrust
-  for(Int_t i = 0; i < 360/(phiStepSize); ++i){
-    Float_t numerator = 0;
-    Float_t phiparam  = 0;
-    Float_t nx = 0;
-    Float_t ny = 0;
-    phiparam=((TMath::Pi()) * i * phiStepSize) / 180; // parametrization of the angle
-    nx = TMath::Cos(phiparam);            // x component of an unitary vector n
-    ny = TMath::Sin(phiparam);            // y component of an unitary vector n
-    for(Int_t iTrack = 0; iTrack < ntracks; ++iTrack){
-      AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-      if (!TrackPassesSelection(track, stack, iTrack)) continue;
-      
-      Float_t pxA = track->Pt() * TMath::Cos(track->Phi());
-      Float_t pyA = track->Pt() * TMath::Sin(track->Phi());
-      //product between p projection in XY plane and the unitary vector
-      numerator += TMath::Abs( ny * pxA - nx * pyA );
-    }
-    
-    sumRatioSquare = TMath::Power((numerator / sumapt), 2);
+  std::sort(directions.begin(), directions.end());
+
+  for (UInt_t i = 0; i < directions.size(); i++) {
+    Double_t nx = TMath::Cos(directions[i].first);
+    Double_t ny = TMath::Sin(directions[i].first);
+    // product between p projection in XY plane and the unitary vector, summed over the particles
+    Double_t numerator = TMath::Abs(nx * sumy - ny * sumx);
+    Double_t sumRatioSquare = (numerator / sumapt) * (numerator / sumapt);
     if(sumRatioSquare < minimalSumRatioSquare)  //minimization of pFull
       {
 	minimalSumRatioSquare = sumRatioSquare;
       }
+    // the term of this particle changes sign beyond its direction
+    Int_t iPrimary = directions[i].second;
+    sumx -= 2 * signs[iPrimary] * primaries->GetPx(iPrimary);
+    sumy -= 2 * signs[iPrimary] * primaries->GetPy(iPrimary);
+    signs[iPrimary] = -signs[iPrimary];
   }
 
   // Compute the final spherocity:
@@ -12,7 +12,6 @@ class AliEventClassifierSpherocity : public AliEventClassifierBase {
   virtual ~AliEventClassifierSpherocity() {}
 
  private:
-  Bool_t TrackPassesSelection(AliMCParticle* track, AliStack *stack, Int_t iTrack);
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
   
   ClassDef(AliEventClassifierSpherocity, 1);
@@ -13,6 +13,7 @@
 #pragma link C++ class AliEventClassifierBase+;
 #pragma link C++ class AliEventClassifierMult+;
 #pragma link C++ class AliEventClassifierMPI+;
+#pragma link C++ class AliEventClassifierPrimaries+;
 #pragma link C++ class AliEventClassifierSphericity+;
 #pragma link C++ class AliEventClassifierSpherocity+;
 #pragma link C++ class AliEventClassifierQ2+;
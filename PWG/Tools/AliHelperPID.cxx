@@ -31,6 +31,7 @@
 #include "TParticle.h"
 #include "AliAODMCParticle.h" 
 #include "AliPIDResponse.h"   
+#include "AliPIDResponseCache.h"
 #include "AliPIDCombined.h"   
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
@@ -315,9 +316,9 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
   // Compute nsigma for each hypthesis
   AliVParticle *inEvHMain = dynamic_cast<AliVParticle *>(trk);
   // --- TPC
-  Double_t nsigmaTPCkProton = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kProton);
-  Double_t nsigmaTPCkKaon   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kKaon); 
-  Double_t nsigmaTPCkPion   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kPion); 
+  Double_t nsigmaTPCkProton = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, inEvHMain, AliPID::kProton);
+  Double_t nsigmaTPCkKaon   = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, inEvHMain, AliPID::kKaon); 
+  Double_t nsigmaTPCkPion   = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, inEvHMain, AliPID::kPion); 
   // --- TOF
   Double_t nsigmaTOFkProton=999.,nsigmaTOFkKaon=999.,nsigmaTOFkPion=999.;
   Double_t nsigmaTPCTOFkProton=999.,nsigmaTPCTOFkKaon=999.,nsigmaTPCTOFkPion=999.;
@@ -325,9 +326,9 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
   CheckTOF(trk);
   
   if(fHasTOFPID && trk->Pt()>fPtTOFPID){//use TOF information
-    nsigmaTOFkProton = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kProton);
-    nsigmaTOFkKaon   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kKaon); 
-    nsigmaTOFkPion   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kPion); 
+    nsigmaTOFkProton = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse, inEvHMain, AliPID::kProton);
+    nsigmaTOFkKaon   = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse, inEvHMain, AliPID::kKaon); 
+    nsigmaTOFkPion   = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse, inEvHMain, AliPID::kPion); 
     Double_t d2Proton=nsigmaTPCkProton * nsigmaTPCkProton + nsigmaTOFkProton * nsigmaTOFkProton;
     Double_t d2Kaon=nsigmaTPCkKaon * nsigmaTPCkKaon + nsigmaTOFkKaon * nsigmaTOFkKaon;
     Double_t d2Pion=nsigmaTPCkPion * nsigmaTPCkPion + nsigmaTOFkPion * nsigmaTOFkPion;
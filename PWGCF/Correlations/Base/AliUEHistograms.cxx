@@ -36,6 +36,10 @@
 #include "TH3F.h"
 #include "TMath.h"
 #include "TLorentzVector.h"
+#include "TArrayC.h"
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayS.h"
 
 ClassImp(AliUEHistograms)
 
@@ -567,10 +571,50 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   }
 
   // Eta() is extremely time consuming, therefore cache it for the inner loop here:
+  // (same for pT, phi and charge, which are needed for each pair)
   TObjArray* input = (mixed) ? mixed : particles;
   TArrayF eta(input->GetEntriesFast());
+  TArrayD pt(input->GetEntriesFast());
+  TArrayD phi(input->GetEntriesFast());
+  TArrayS charge(input->GetEntriesFast());
   for (Int_t i=0; i<input->GetEntriesFast(); i++)
-    eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
+  {
+    AliVParticle* particle = (AliVParticle*) input->UncheckedAt(i);
+    eta[i] = particle->Eta();
+    pt[i] = particle->Pt();
+    phi[i] = particle->Phi();
+    charge[i] = particle->Charge();
+  }
+  
+  // radii for the two-track cut: minimum radius, 2.5 m, and the radii scanned between them.
+  // asin(0.075 * radius / pT) only depends on the particle and the radius and is cached
+  // per particle the first time the particle is part of a close pair
+  TArrayF radii;
+  TArrayD asinTrigger, asinAssociated;
+  TArrayC asinTriggerFilled, asinAssociatedFilled;
+  if (twoTrackEfficiencyCut && particles)
+  {
+    Int_t nRadii = 2;
+    for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01)
+      nRadii++;
+    radii.Set(nRadii);
+    radii[0] = fTwoTrackCutMinRadius;
+    radii[1] = 2.5;
+    nRadii = 2;
+    for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01)
+      radii[nRadii++] = rad;
+    
+    asinTrigger.Set(particles->GetEntriesFast() * radii.GetSize());
+    asinTriggerFilled.Set(particles->GetEntriesFast());
+    if (mixed)
+    {
+      asinAssociated.Set(mixed->GetEntriesFast() * radii.GetSize());
+      asinAssociatedFilled.Set(mixed->GetEntriesFast());
+    }
+  }
+  // without mixing trigger and associated particles are from the same list
+  TArrayD& asinAssociatedCache = (mixed) ? asinAssociated : asinTrigger;
+  TArrayC& asinAssociatedCacheFilled = (mixed) ? asinAssociatedFilled : asinTriggerFilled;
   
   // if particles is not set, just fill event statistics
   if (particles)
@@ -692,6 +736,9 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       
       // some optimization
       Float_t triggerEta = triggerParticle->Eta();
+      const Double_t triggerPt = triggerParticle->Pt();
+      const Double_t triggerPhi = triggerParticle->Phi();
+      const Short_t triggerCharge = triggerParticle->Charge();
       
       if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
 	continue;
@@ -703,7 +750,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
       }
       
       if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
+	if (triggerCharge * fTriggerSelectCharge < 0)
 	  continue;
 	
       if (fRejectResonanceDaughters > 0)
@@ -739,21 +786,21 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
           continue;
         
         if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
+	  if (pt[j] >= triggerPt)
 	    continue;
 	
 	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
+	  if (charge[j] * fAssociatedSelectCharge < 0)
 	    continue;
 
         if (fSelectCharge > 0)
         {
           // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
+          if (fSelectCharge == 1 && charge[j] * triggerCharge > 0)
             continue;
             
           // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
+          if (fSelectCharge == 2 && charge[j] * triggerCharge < 0)
             continue;
         }
         
@@ -773,13 +820,13 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 
 	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutConversionsV > 0 && charge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.510e-3, 0.510e-3);
 	  
 	  if (mass < fCutConversionsV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.510e-3, 0.510e-3);
 	    
 	    fControlConvResoncances->Fill(0.0, mass);
 
@@ -789,15 +836,15 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// K0s
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && charge[j] * triggerCharge < 0)
 	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	  Float_t mass = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.1396, 0.1396);
 	  
 	  const Float_t kK0smass = 0.4976;
 	  
 	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutResonancesV * 5)
 	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	    mass = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.1396, 0.1396);
 	    
 	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
 
@@ -807,16 +854,16 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	}
 	
 	// Lambda
-	if (fCutResonancesV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	if (fCutResonancesV > 0 && charge[j] * triggerCharge < 0)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t mass1 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.1396, 0.9383);
+	  Float_t mass2 = GetInvMassSquaredCheap(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.9383, 0.1396);
 	  
 	  const Float_t kLambdaMass = 1.115;
 
 	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
+	    mass1 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.1396, 0.9383);
 
 	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
 	    
@@ -825,7 +872,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  }
 	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutResonancesV * 5)
 	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	    mass2 = GetInvMassSquared(triggerPt, triggerEta, triggerPhi, pt[j], eta[j], phi[j], 0.9383, 0.1396);
 
 	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
 
@@ -839,22 +886,26 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	  // the variables & cuthave been developed by the HBT group 
 	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
+	  Float_t phi1 = triggerPhi;
+	  Float_t pt1 = triggerPt;
+	  Float_t charge1 = triggerCharge;
 	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
+	  Float_t phi2 = phi[j];
+	  Float_t pt2 = pt[j];
+	  Float_t charge2 = charge[j];
 	      
 	  Float_t deta = triggerEta - eta[j];
 	      
 	  // optimization
 	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	  {
+	    // same as GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, radii[k], bSign)
+	    const Double_t* asin1 = GetDPhiStarASin(asinTrigger, asinTriggerFilled, i, pt1, radii);
+	    const Double_t* asin2 = GetDPhiStarASin(asinAssociatedCache, asinAssociatedCacheFilled, j, pt2, radii);
+	    
 	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
+	    Float_t dphistar1 = GetDPhiStarFromASin(phi1, charge1, asin1[0], phi2, charge2, asin2[0], bSign);
+	    Float_t dphistar2 = GetDPhiStarFromASin(phi1, charge1, asin1[1], phi2, charge2, asin2[1], bSign);
 	    
 	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
 
@@ -862,9 +913,9 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	    Float_t dphistarmin = 1e5;
 	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
 	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
+	      for (Int_t k=2; k<radii.GetSize(); k++) 
 	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+		Float_t dphistar = GetDPhiStarFromASin(phi1, charge1, asin1[k], phi2, charge2, asin2[k], bSign);
 
 		Float_t dphistarabs = TMath::Abs(dphistar);
 		
@@ -890,10 +941,10 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
         
         Double_t vars[6];
         vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
+        vars[1] = pt[j];
+        vars[2] = triggerPt;
         vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
+        vars[4] = triggerPhi - phi[j];
         if (vars[4] > 1.5 * TMath::Pi()) 
           vars[4] -= TMath::TwoPi();
         if (vars[4] < -0.5 * TMath::Pi())
@@ -901,7 +952,7 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
 	vars[5] = zVtx;
 	
 	if (fillpT)
-	  weight = particle->Pt();
+	  weight = pt[j];
 	
 	Double_t useWeight = weight;
 	if (applyEfficiency)
@@ -1001,6 +1052,26 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   FillEvent(centrality, step);
 }
   
+//____________________________________________________________________
+const Double_t* AliUEHistograms::GetDPhiStarASin(TArrayD& cache, TArrayC& filled, Int_t index, Float_t pt, const TArrayF& radii)
+{
+  // returns asin(0.075 * radius / pt) for all radii of the particle with the given index,
+  // the values are calculated at the first call for each particle
+  
+  Double_t* values = cache.GetArray() + index * radii.GetSize();
+  if (!filled[index])
+  {
+    for (Int_t k=0; k<radii.GetSize(); k++)
+    {
+      Float_t radius = radii[k];
+      values[k] = TMath::ASin(0.075 * radius / pt);
+    }
+    filled[index] = 1;
+  }
+  
+  return values;
+}
+
 //____________________________________________________________________
 void AliUEHistograms::FillTrackingEfficiency(TObjArray* mc, TObjArray* recoPrim, TObjArray* recoAll, TObjArray* recoPrimPID, TObjArray* recoAllPID, TObjArray* fake, Int_t particleType, Double_t centrality, Double_t zVtx)
 {
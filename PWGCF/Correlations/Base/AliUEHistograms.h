@@ -21,6 +21,9 @@ class TObjArray;
 class TH1F;
 class TH2F;
 class TH3F;
+class TArrayC;
+class TArrayD;
+class TArrayF;
 
 class AliUEHistograms : public TNamed
 {
@@ -113,6 +116,8 @@ protected:
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t GetDPhiStarFromASin(Float_t phi1, Float_t charge1, Double_t asin1, Float_t phi2, Float_t charge2, Double_t asin2, Float_t bSign);
+  const Double_t* GetDPhiStarASin(TArrayD& cache, TArrayC& filled, Int_t index, Float_t pt, const TArrayF& radii);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -172,7 +177,16 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   // calculates dphistar
   //
   
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStarFromASin(phi1, charge1, TMath::ASin(0.075 * radius / pt1), phi2, charge2, TMath::ASin(0.075 * radius / pt2), bSign);
+}
+
+Float_t AliUEHistograms::GetDPhiStarFromASin(Float_t phi1, Float_t charge1, Double_t asin1, Float_t phi2, Float_t charge2, Double_t asin2, Float_t bSign)
+{ 
+  //
+  // calculates dphistar from asin(0.075 * radius / pt) of both particles (see GetDPhiStar)
+  //
+  
+  Float_t dphistar = phi1 - phi2 - charge1 * bSign * asin1 + charge2 * bSign * asin2;
   
   static const Double_t kPi = TMath::Pi();
   
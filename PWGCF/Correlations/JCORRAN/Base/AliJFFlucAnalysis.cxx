@@ -33,6 +33,7 @@
 //#include "AliJHistManager.h"
 #include "TClonesArray.h"
 #include "AliJEfficiency.h"
+#include "AliFlowGenericCorrelator.h"
 
 
 ClassImp(AliJFFlucAnalysis)
@@ -45,6 +46,7 @@ AliJFFlucAnalysis::AliJFFlucAnalysis()
 		fVertex(0),
 		fCent(0),
 		fNJacek(0),	
+		fQC(NULL),
 		fHMG(NULL),
 		fEfficiency(0), // pointer to tracking efficiency
 		fEffMode(0),
@@ -98,6 +100,7 @@ AliJFFlucAnalysis::AliJFFlucAnalysis(const char *name)
 		fVertex(0),
 		fCent(0),
 		fNJacek(0),
+		fQC(NULL),
 		fHMG(NULL),
 		fEfficiency(0), 
 		fEffMode(0),
@@ -172,6 +175,7 @@ AliJFFlucAnalysis::AliJFFlucAnalysis(const AliJFFlucAnalysis& a):
 		//h_phi_module(a.h_phi_module),
 		fVertex(a.fVertex),
 		fCent(a.fCent),
+		fQC(NULL),
 		fHMG(a.fHMG),
 		fEfficiency(a.fEfficiency),
 		fEffMode(a.fEffMode),
@@ -351,6 +355,7 @@ void AliJFFlucAnalysis::UserCreateOutputObjects(){
 //________________________________________________________________________
 AliJFFlucAnalysis::~AliJFFlucAnalysis() {
 		delete fInputList;
+		delete fQC;
 		delete fHMG;
 		delete fEfficiency;
 		delete []fPttJacek;
@@ -447,13 +452,19 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				}
 		}
 		// vn^2k calcualted for n.... k....
+		// (QnA QnB*)^k, once per event for all combinations below
+		TComplex QnAQnBstar_k[kNH][nKL];
+		for( int ih=2; ih<kNH; ih++){ 
+				for( int ik=1; ik<nKL; ik++){
+						QnAQnBstar_k[ih][ik] = TComplex::Power( QnA[ih]*QnB_star[ih],ik);
+				}
+		}
 		// calculate hvn_vn (2 combination of vn) 
 		for( int ih=2; ih<kNH; ih++){ 
 				for( int ik=1; ik<nKL; ik++){
 						for( int ihh=2; ihh<kNH; ihh++){ 
 								for(int ikk=1; ikk<nKL; ikk++){
-										vn2_vn2[ih][ik][ihh][ikk] = (  
-														TComplex::Power( QnA[ih]*QnB_star[ih],ik)*TComplex::Power(QnA[ihh]*QnB_star[ihh],ikk) ).Re();
+										vn2_vn2[ih][ik][ihh][ikk] = ( QnAQnBstar_k[ih][ik]*QnAQnBstar_k[ihh][ikk] ).Re();
 								}
 						}
 				}
@@ -482,15 +493,16 @@ void AliJFFlucAnalysis::UserExec(Option_t *) {
 				}
 		}
 		///	Fill more correlators in manualy
-		TComplex V4V2starv2_2 =	QnA[4] *TComplex::Power( QnB_star[2] ,2) * vn2[2][1] ;
-		TComplex V4V2starv2_4 = QnA[4] * TComplex::Power( QnB_star[2], 2) * vn2[2][2] ;
-		TComplex V4V2star = QnA[4] * TComplex::Power( QnB_star[2], 2 ); 
+		const TComplex QnB_star2_2 = TComplex::Power( QnB_star[2], 2 );
+		TComplex V4V2starv2_2 =	QnA[4] * QnB_star2_2 * vn2[2][1] ;
+		TComplex V4V2starv2_4 = QnA[4] * QnB_star2_2 * vn2[2][2] ;
+		TComplex V4V2star = QnA[4] * QnB_star2_2; 
 		TComplex V5V2starV3starv2_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[2][1] ;
 		TComplex V5V2starV3star = QnA[5] * QnB_star[2] * QnB_star[3] ;
 		TComplex V5V2starV3startv3_2 = QnA[5] * QnB_star[2] * QnB_star[3] * vn2[3][1];
 		TComplex V6V2star_3 = QnA[6] * TComplex::Power( QnB_star[2] , 3) ;
 		TComplex V6V3star_2 = QnA[6] * TComplex::Power( QnB_star[3], 2) ;
-		TComplex V7V2star_2V3star = QnA[7] * TComplex::Power( QnB_star[2] , 2) * QnB_star[3]; 
+		TComplex V7V2star_2V3star = QnA[7] * QnB_star2_2 * QnB_star[3]; 
 
 
 		// New correlattors (Modified by You's corretion term for self-correlations)
@@ -847,9 +859,11 @@ Double_t AliJFFlucAnalysis::Get_Qn_Img_pt(Double_t eta1, Double_t eta2, int harm
 void AliJFFlucAnalysis::CalculateQvectorsQC(){
 		// calcualte Q-vector for QC method ( no subgroup )
 		//init
+		// Q-vectors up to harmonic 4*5 cover the 4p correlators of harmonics up to 5
+		if(!fQC) fQC = new AliFlowGenericCorrelator(kH5, kK4);
+		fQC->Reset();
 		for(int ih=0; ih<kNH; ih++){
 				for(int ik=0; ik<nKL; ik++){
-						QvectorQC[ih][ik] = TComplex(0, 0);
 						for(int isub=0; isub<2; isub++){	
 							QvectorQCeta10[ih][ik][isub] = TComplex(0, 0);	
 						}
@@ -871,9 +885,9 @@ void AliJFFlucAnalysis::CalculateQvectorsQC(){
 				if( eta < fQC_eta_cut_min || eta > fQC_eta_cut_max) continue;  
 				/////////////////////////////////////////////////
 
+				fQC->Fill(phi); // no weights, Q(n,p) is the same for all p
 				for(int ih=0; ih<kNH; ih++){
 						for(int ik=0; ik<nKL; ik++){
-								QvectorQC[ih][ik] += TComplex( TMath::Cos(ih*phi), TMath::Sin(ih*phi) );
 								// this is not working (there are no eta gap for +0.6, +0.61 in this way..
 								// fix this as like SP -> 2 sub event // 
 								if( TMath::Abs(eta) > 0.5 ){  // this is for Noramlized SC ( denominator need eta gap )
@@ -891,18 +905,17 @@ void AliJFFlucAnalysis::CalculateQvectorsQC(){
 		/*
 		// Save QA plot
 		for(int ih=2; ih<kNH; ih++){
-		fh_QvectorQC[ih][fCBin]->Fill( QvectorQC[ih][1].Re()/QvectorQC[0][1].Re() , QvectorQC[ih][1].Im()/QvectorQC[0][1].Re() ); // fill normalized Q vector
-		fh_QvectorQCphi[ih][fCBin]->Fill( QvectorQC[ih][1].Theta() );
+		fh_QvectorQC[ih][fCBin]->Fill( Q(ih,1).Re()/Q(0,1).Re() , Q(ih,1).Im()/Q(0,1).Re() ); // fill normalized Q vector
+		fh_QvectorQCphi[ih][fCBin]->Fill( Q(ih,1).Theta() );
 		}
 		// Q-vector calculated
 		 */
 }
 //________________________________________________________________________
 TComplex AliJFFlucAnalysis::Q(int n, int p){
-		// Retrun QvectorQC 
+		// Retrun QC Q-vector 
 		// Q{-n, p} = Q{n, p}*
-		if(n>=0){ return QvectorQC[n][p]; }
-		return TComplex::Conjugate( QvectorQC[-n][p] );
+		return fQC->Q(n, p);
 }
 //________________________________________________________________________
 TComplex AliJFFlucAnalysis::Two(int n1, int n2 ){
@@ -18,6 +18,7 @@
 class TClonesArray;
 class AliJBaseTrack;
 class AliJEfficiency;
+class AliFlowGenericCorrelator;
 
 class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 
@@ -113,7 +114,7 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		Double_t fQC_eta_cut_max;
 
 
-		TComplex QvectorQC[kNH][nKL]; 
+		AliFlowGenericCorrelator *fQC;//! // Q-vectors for QC method, Q(n,p) for |n| <= 4*kH5, p <= kK4
 		TComplex QvectorQCeta10[kNH][nKL][2]; // ksub  
 
 		TH1D *h_phi_module[7][2]; // cent, isub 
@@ -160,7 +161,7 @@ class AliJFFlucAnalysis : public AliAnalysisTaskSE {
 		AliJTH1D fh_QvectorQCphi;//!
 		AliJTH1D fh_evt_SP_QC_ratio_2p;//! // check SP QC evt by evt ratio
 		AliJTH1D fh_evt_SP_QC_ratio_4p;//! // check SP QC evt by evt ratio
-		ClassDef(AliJFFlucAnalysis, 1); // example of analysis
+		ClassDef(AliJFFlucAnalysis, 2); // example of analysis
 };
 
 #endif
@@ -9,6 +9,7 @@
 ////////////////
 #include "AliFemtoEvent.h"
 #include "AliFemtoTrack.h"
+#include "AliFemtoTrackTable.h"
 #include "AliFemtoV0.h"
 #include "AliFemtoXi.h"
 #include "AliFemtoKink.h"
@@ -52,6 +53,7 @@ AliFemtoEvent::AliFemtoEvent():
   fPrimVertPos(-999.0,-999.0,-999.0),
   fPrimVertCov(),
   fTrackCollection(NULL),
+  fTrackTable(NULL),
   fV0Collection(NULL),
   fXiCollection(NULL),
   fKinkCollection(NULL),
@@ -103,6 +105,7 @@ AliFemtoEvent::AliFemtoEvent(const AliFemtoEvent& ev, AliFemtoTrackCut* tCut, Al
   fPrimVertPos(ev.fPrimVertPos),
   fPrimVertCov(),
   fTrackCollection(NULL),
+  fTrackTable(NULL),
   fV0Collection(NULL),
   fXiCollection(NULL),
   fKinkCollection(NULL),
@@ -184,6 +187,7 @@ AliFemtoEvent::AliFemtoEvent(const AliFemtoEvent& ev):
   fPrimVertPos(ev.fPrimVertPos),
   fPrimVertCov(),
   fTrackCollection(NULL),
+  fTrackTable(NULL),
   fV0Collection(NULL),
   fXiCollection(NULL),
   fKinkCollection(NULL),
@@ -276,12 +280,13 @@ AliFemtoEvent& AliFemtoEvent::operator=(const AliFemtoEvent& aEvent)
 
   if (fTrackCollection) {
     for (AliFemtoTrackIterator iter=fTrackCollection->begin();iter!=fTrackCollection->end();iter++){
-      delete *iter;
+      if (!(*iter)->TrackTable()) delete *iter;
     }
     fTrackCollection->clear();
   } else {
     fTrackCollection = new AliFemtoTrackCollection;
   }
+  SetTrackTable(NULL);
 
   if (fV0Collection) {
     for (AliFemtoV0Iterator tV0iter=fV0Collection->begin();tV0iter!=fV0Collection->end();tV0iter++){
@@ -341,10 +346,12 @@ AliFemtoEvent::~AliFemtoEvent(){
   cout << " AliFemtoEvent::~AliFemtoEvent() " << endl;
 #endif
   for (AliFemtoTrackIterator iter=fTrackCollection->begin();iter!=fTrackCollection->end();iter++){
-    delete *iter;
+    if (!(*iter)->TrackTable()) delete *iter;
   }
   fTrackCollection->clear();
   delete fTrackCollection;
+  // the rows of the table are deleted with the last particle referencing them
+  SetTrackTable(NULL);
   //must do the same for the V0 collection
   for (AliFemtoV0Iterator tV0iter=fV0Collection->begin();tV0iter!=fV0Collection->end();tV0iter++){
     delete *tV0iter;
@@ -410,6 +417,12 @@ AliFemtoV0Collection* AliFemtoEvent::V0Collection() const {return fV0Collection;
 AliFemtoXiCollection* AliFemtoEvent::XiCollection() const {return fXiCollection;}
 AliFemtoKinkCollection* AliFemtoEvent::KinkCollection() const {return fKinkCollection;}
 AliFemtoTrackCollection* AliFemtoEvent::TrackCollection() const {return fTrackCollection;}
+AliFemtoTrackTable* AliFemtoEvent::TrackTable() const {return fTrackTable;}
+void AliFemtoEvent::SetTrackTable(AliFemtoTrackTable* table)
+{
+  if (fTrackTable) fTrackTable->Release();
+  fTrackTable = table;
+}
 AliFemtoThreeVector AliFemtoEvent::PrimVertPos() const {return fPrimVertPos;}
 const double* AliFemtoEvent::PrimVertCov() const {return fPrimVertCov;}
 double AliFemtoEvent::MagneticField() const {return fMagneticField;}
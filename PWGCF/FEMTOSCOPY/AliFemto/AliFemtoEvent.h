@@ -21,6 +21,7 @@ class AliFemtoV0Cut;
 class AliFemtoXiCut;
 class AliFemtoKinkCut;
 class AliEventplane;
+class AliFemtoTrackTable;
 
 class AliFemtoEvent {
 public:
@@ -39,6 +40,7 @@ public:
   AliFemtoXiCollection* XiCollection() const;
   AliFemtoKinkCollection* KinkCollection() const;
   AliFemtoTrackCollection* TrackCollection() const;
+  AliFemtoTrackTable* TrackTable() const;
   double MagneticField() const;
   bool IsCollisionCandidate() const;
 
@@ -100,6 +102,10 @@ public:
   void SetReactionPlaneAngle(const float& a);
   void SetEP(AliEventplane* ep);
 
+  /// Table holding the tracks of the collection, the event takes over the
+  /// reference of the caller (see AliFemtoEventReader::SetUseTrackTable)
+  void SetTrackTable(AliFemtoTrackTable* table);
+
   int UncorrectedNumberOfNegativePrimaries() const;
   int UncorrectedNumberOfPrimaries() const;
   int SPDMultiplicity() const;
@@ -155,6 +161,7 @@ private:
   AliFemtoThreeVector fPrimVertPos;          ///< primary vertex position
   double fPrimVertCov[6];                    ///< primary vertex covariances
   AliFemtoTrackCollection* fTrackCollection; ///< collection of tracks
+  AliFemtoTrackTable*      fTrackTable;      //!<! table holding the tracks, if any
   AliFemtoV0Collection*    fV0Collection;    ///< collection of V0s
   AliFemtoXiCollection*    fXiCollection;    ///< collection of Xis
   AliFemtoKinkCollection*  fKinkCollection;  ///< collection of kinks
@@ -4,6 +4,8 @@
 /// All event readers must inherit from this one
 
 #include "AliFemtoEvent.h"
+#include "AliFemtoTrack.h"
+#include "AliFemtoTrackTable.h"
 #include "AliFemtoEventCut.h"
 #include "AliFemtoTrackCut.h"
 #include "AliFemtoV0Cut.h"
@@ -24,7 +26,8 @@ AliFemtoEventReader::AliFemtoEventReader():
   fXiCut(NULL),
   fKinkCut(NULL),
   fReaderStatus(0),
-  fDebug(1)
+  fDebug(1),
+  fUseTrackTable(false)
 { // no-op
 }
 
@@ -35,7 +38,8 @@ AliFemtoEventReader::AliFemtoEventReader(const AliFemtoEventReader& aReader):
   fXiCut(aReader.fXiCut),
   fKinkCut(aReader.fKinkCut),
   fReaderStatus(aReader.fReaderStatus),
-  fDebug(aReader.fDebug)
+  fDebug(aReader.fDebug),
+  fUseTrackTable(aReader.fUseTrackTable)
 { // Copy constructor
 }
 
@@ -52,10 +56,26 @@ AliFemtoEventReader& AliFemtoEventReader::operator=(const AliFemtoEventReader& a
   fKinkCut  = aReader.fKinkCut;
   fReaderStatus = aReader.fReaderStatus;
   fDebug = aReader.fDebug;
+  fUseTrackTable = aReader.fUseTrackTable;
 
   return *this;
 }
 
+AliFemtoTrack* AliFemtoEventReader::NewTrack(AliFemtoEvent* event)
+{
+  AliFemtoTrackTable *table = event->TrackTable();
+  return table ? table->NewTrack() : new AliFemtoTrack();
+}
+
+void AliFemtoEventReader::DiscardTrack(AliFemtoTrack* track)
+{
+  if (track->TrackTable()) {
+    track->TrackTable()->RemoveLast();
+  } else {
+    delete track;
+  }
+}
+
 
 AliFemtoString AliFemtoEventReader::Report()
 { // Create a simple report from the workings of the reader
@@ -6,6 +6,7 @@
 #define ALIFEMTOEVENTREADER_H
 
 class AliFemtoEvent;
+class AliFemtoTrack;
 class AliFemtoEventCut;
 class AliFemtoTrackCut;
 class AliFemtoV0Cut;
@@ -97,7 +98,21 @@ public:
   int Debug() const { return fDebug; }
   void SetDebug(int d) { fDebug = d; }
 
+  /// Store the tracks of each event in an AliFemtoTrackTable, allocated once
+  /// per event and referenced by the particles of all analyses instead of
+  /// copied into each of them. Supported by the AOD, ESDChain and
+  /// KinematicsChain readers, ignored by the others.
+  void SetUseTrackTable(bool use) { fUseTrackTable = use; }
+  bool UseTrackTable() const { return fUseTrackTable; }
+
 protected:
+  /// New track of the event: a row of its track table if it has one,
+  /// else a new object
+  AliFemtoTrack* NewTrack(AliFemtoEvent* event);
+
+  /// Deletes the last track returned by NewTrack, if not added to the event
+  void DiscardTrack(AliFemtoTrack* track);
+
   AliFemtoEventCut* fEventCut;     //!<! link to the front-loaded event cut
   AliFemtoTrackCut* fTrackCut;     //!<! link to the front-loaded track cut
   AliFemtoV0Cut* fV0Cut;           //!<! link to the front-loaded V0 cut
@@ -105,6 +120,7 @@ protected:
   AliFemtoKinkCut* fKinkCut;       //!<! link to the front-loaded Kink cut
   int fReaderStatus;               ///< 0="good"
   int fDebug;                      ///< Debug information level
+  bool fUseTrackTable;             ///< Store the tracks of the events in track tables
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -19,11 +19,13 @@
 #include "SystemOfUnits.h"
 
 #include "AliFemtoEvent.h"
+#include "AliFemtoTrackTable.h"
 #include "AliFemtoModelHiddenInfo.h"
 #include "AliFemtoModelGlobalHiddenInfo.h"
 #include "AliPID.h"
 
 #include "AliAODpidUtil.h"
+#include "AliPIDResponseCache.h"
 #include "AliAnalysisUtils.h"
 #include "AliGenHijingEventHeader.h"
 
@@ -441,6 +443,10 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
     }
   }
 
+  if (fUseTrackTable) {
+    tEvent->SetTrackTable(new AliFemtoTrackTable(nofTracks));
+  }
+
   int tNormMult = 0;
   for (int i = 0; i < nofTracks; i++) {
 
@@ -470,7 +476,8 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
               tNormMult++;
     }
 
-    AliFemtoTrack *trackCopy = CopyAODtoFemtoTrack(aodtrack);
+    AliFemtoTrack *trackCopy = NewTrack(tEvent);
+    CopyAODtoFemtoTrack(aodtrack, trackCopy);
 
     // copying PID information from the correspondent track
     //  const AliAODTrack *aodtrackpid = fEvent->GetTrack(labels[-1-fEvent->GetTrack(i)->GetID()]);
@@ -648,7 +655,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
       }
       else {
 	// cout<<"bad track : AOD REader pdg cod"<<pdg<<" ptrue "<<ptrue<<endl;
-	delete  trackCopy;
+	DiscardTrack(trackCopy);
       }
       //Special MC analysis for pi,K,p,e slected by PDG code <--
     }
@@ -944,10 +951,17 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
 }
 
 AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrack)
+{
+  // Copy the track information from the AOD into a new AliFemtoTrack
+  AliFemtoTrack *tFemtoTrack = new AliFemtoTrack();
+  CopyAODtoFemtoTrack(tAodTrack, tFemtoTrack);
+  return tFemtoTrack;
+}
+
+void AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack)
 {
   // Copy the track information from the AOD into the internal AliFemtoTrack
   // If it exists, use the additional information from the PWG2 AOD
-  AliFemtoTrack *tFemtoTrack = new AliFemtoTrack();
 
   // Primary Vertex position
 
@@ -1101,9 +1115,6 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrac
     tFemtoTrack->SetCorrectionAll(f1DcorrectionsAll->GetBinContent(f1DcorrectionsAll->FindFixBin(tAodTrack->Pt())));
   }
   else tFemtoTrack->SetCorrectionAll(1.0);
-
-
-  return tFemtoTrack;
 }
 
 AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
@@ -1239,12 +1250,12 @@ AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
     tFemtoV0->SetStatusPos(trackpos->GetStatus());
     tFemtoV0->SetStatusNeg(trackneg->GetStatus());
 
-    tFemtoV0->SetPosNSigmaTPCK(fAODpidUtil->NumberOfSigmasTPC(trackpos, AliPID::kKaon));
-    tFemtoV0->SetNegNSigmaTPCK(fAODpidUtil->NumberOfSigmasTPC(trackneg, AliPID::kKaon));
-    tFemtoV0->SetPosNSigmaTPCP(fAODpidUtil->NumberOfSigmasTPC(trackpos, AliPID::kProton));
-    tFemtoV0->SetNegNSigmaTPCP(fAODpidUtil->NumberOfSigmasTPC(trackneg, AliPID::kProton));
-    tFemtoV0->SetPosNSigmaTPCPi(fAODpidUtil->NumberOfSigmasTPC(trackpos, AliPID::kPion));
-    tFemtoV0->SetNegNSigmaTPCPi(fAODpidUtil->NumberOfSigmasTPC(trackneg, AliPID::kPion));
+    tFemtoV0->SetPosNSigmaTPCK(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackpos, AliPID::kKaon));
+    tFemtoV0->SetNegNSigmaTPCK(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackneg, AliPID::kKaon));
+    tFemtoV0->SetPosNSigmaTPCP(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackpos, AliPID::kProton));
+    tFemtoV0->SetNegNSigmaTPCP(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackneg, AliPID::kProton));
+    tFemtoV0->SetPosNSigmaTPCPi(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackpos, AliPID::kPion));
+    tFemtoV0->SetNegNSigmaTPCPi(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackneg, AliPID::kPion));
 
 
     float bfield = 5 * fMagFieldSign;
@@ -1385,16 +1396,16 @@ AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
       if (((tFemtoV0->StatusPos() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoV0->StatusPos() & AliVTrack::kTIME) == AliVTrack::kTIME) && probMisPos < 0.01) {
 
         // if(trackpos->IsOn(AliESDtrack::kTOFout & AliESDtrack::kTIME)) {
-        tFemtoV0->SetPosNSigmaTOFK(fAODpidUtil->NumberOfSigmasTOF(trackpos, AliPID::kKaon));
-        tFemtoV0->SetPosNSigmaTOFP(fAODpidUtil->NumberOfSigmasTOF(trackpos, AliPID::kProton));
-        tFemtoV0->SetPosNSigmaTOFPi(fAODpidUtil->NumberOfSigmasTOF(trackpos, AliPID::kPion));
+        tFemtoV0->SetPosNSigmaTOFK(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackpos, AliPID::kKaon));
+        tFemtoV0->SetPosNSigmaTOFP(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackpos, AliPID::kProton));
+        tFemtoV0->SetPosNSigmaTOFPi(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackpos, AliPID::kPion));
       }
       if (((tFemtoV0->StatusNeg() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoV0->StatusNeg() & AliVTrack::kTIME) == AliVTrack::kTIME) && probMisNeg < 0.01) {
 
         // if(trackneg->IsOn(AliESDtrack::kTOFout & AliESDtrack::kTIME)) {
-        tFemtoV0->SetNegNSigmaTOFK(fAODpidUtil->NumberOfSigmasTOF(trackneg, AliPID::kKaon));
-        tFemtoV0->SetNegNSigmaTOFP(fAODpidUtil->NumberOfSigmasTOF(trackneg, AliPID::kProton));
-        tFemtoV0->SetNegNSigmaTOFPi(fAODpidUtil->NumberOfSigmasTOF(trackneg, AliPID::kPion));
+        tFemtoV0->SetNegNSigmaTOFK(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackneg, AliPID::kKaon));
+        tFemtoV0->SetNegNSigmaTOFP(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackneg, AliPID::kProton));
+        tFemtoV0->SetNegNSigmaTOFPi(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackneg, AliPID::kPion));
       }
       double TOFSignalPos = trackpos->GetTOFsignal();
       double TOFSignalNeg = trackneg->GetTOFsignal();
@@ -1495,9 +1506,9 @@ AliFemtoXi *AliFemtoEventReaderAOD::CopyAODtoFemtoXi(AliAODcascade *tAODxi)
     tFemtoXi->SetNdofBac(trackbac->Chi2perNDF());//bac!
     tFemtoXi->SetStatusBac(trackbac->GetStatus()); //bac!
 
-    tFemtoXi->SetBacNSigmaTPCK(fAODpidUtil->NumberOfSigmasTPC(trackbac, AliPID::kKaon));
-    tFemtoXi->SetBacNSigmaTPCP(fAODpidUtil->NumberOfSigmasTPC(trackbac, AliPID::kProton));
-    tFemtoXi->SetBacNSigmaTPCPi(fAODpidUtil->NumberOfSigmasTPC(trackbac, AliPID::kPion));
+    tFemtoXi->SetBacNSigmaTPCK(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackbac, AliPID::kKaon));
+    tFemtoXi->SetBacNSigmaTPCP(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackbac, AliPID::kProton));
+    tFemtoXi->SetBacNSigmaTPCPi(AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, trackbac, AliPID::kPion));
 
 
     //NEED TO ADD:  
@@ -1593,9 +1604,9 @@ AliFemtoXi *AliFemtoEventReaderAOD::CopyAODtoFemtoXi(AliAODcascade *tAODxi)
     {
       if (((tFemtoXi->StatusBac() & AliVTrack::kTOFout) == AliVTrack::kTOFout) && ((tFemtoXi->StatusBac() & AliVTrack::kTIME) == AliVTrack::kTIME) && probMisBac < 0.01)
       {
-        tFemtoXi->SetBacNSigmaTOFK(fAODpidUtil->NumberOfSigmasTOF(trackbac, AliPID::kKaon));
-        tFemtoXi->SetBacNSigmaTOFP(fAODpidUtil->NumberOfSigmasTOF(trackbac, AliPID::kProton));
-        tFemtoXi->SetBacNSigmaTOFPi(fAODpidUtil->NumberOfSigmasTOF(trackbac, AliPID::kPion));
+        tFemtoXi->SetBacNSigmaTOFK(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackbac, AliPID::kKaon));
+        tFemtoXi->SetBacNSigmaTOFP(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackbac, AliPID::kProton));
+        tFemtoXi->SetBacNSigmaTOFPi(AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, trackbac, AliPID::kPion));
       }
 
       double TOFSignalBac = trackbac->GetTOFsignal();
@@ -1788,10 +1799,10 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
 
   //////  TPC ////////////////////////////////////////////
 
-  const float nsigmaTPCK = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kKaon);
-  const float nsigmaTPCPi = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kPion);
-  const float nsigmaTPCP = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kProton);
-  const float nsigmaTPCE = fAODpidUtil->NumberOfSigmasTPC(tAodTrack, AliPID::kElectron);
+  const float nsigmaTPCK = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kKaon);
+  const float nsigmaTPCPi = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kPion);
+  const float nsigmaTPCP = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kProton);
+  const float nsigmaTPCE = AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fAODpidUtil, tAodTrack, AliPID::kElectron);
 
   tFemtoTrack->SetNSigmaTPCPi(nsigmaTPCPi);
   tFemtoTrack->SetNSigmaTPCK(nsigmaTPCK);
@@ -1819,10 +1830,10 @@ void AliFemtoEventReaderAOD::CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemt
       && ((status & AliVTrack::kTIME) == AliVTrack::kTIME)
       && probMis < 0.01) {
 
-    nsigmaTOFPi = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kPion);
-    nsigmaTOFK = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kKaon);
-    nsigmaTOFP = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kProton);
-    nsigmaTOFE = fAODpidUtil->NumberOfSigmasTOF(tAodTrack, AliPID::kElectron);
+    nsigmaTOFPi = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kPion);
+    nsigmaTOFK = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kKaon);
+    nsigmaTOFP = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kProton);
+    nsigmaTOFE = AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fAODpidUtil, tAodTrack, AliPID::kElectron);
 
     Double_t len = 200; // esdtrack->GetIntegratedLength(); !!!!!
     Double_t tof = tAodTrack->GetTOFsignal();
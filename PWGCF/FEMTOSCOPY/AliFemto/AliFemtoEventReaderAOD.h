@@ -104,6 +104,7 @@ protected:
   virtual AliFemtoTrack *CopyAODtoFemtoTrack(AliAODTrack *tAodTrack
       //            AliPWG2AODTrack *tPWG2AODTrack
                                             );
+  virtual void CopyAODtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
   virtual AliFemtoV0 *CopyAODtoFemtoV0(AliAODv0 *tAODv0);
   virtual AliFemtoXi *CopyAODtoFemtoXi(AliAODcascade *tAODxi);
   virtual void CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
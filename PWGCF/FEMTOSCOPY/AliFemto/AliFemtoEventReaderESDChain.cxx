@@ -21,6 +21,7 @@
 #include "AliFmThreeVectorF.h"
 #include "SystemOfUnits.h"
 #include "AliFemtoEvent.h"
+#include "AliFemtoTrackTable.h"
 #include "AliFemtoModelHiddenInfo.h"
 #include "AliPID.h"
 #include "AliAnalysisUtils.h"
@@ -425,6 +426,9 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
   //  hbtEvent->SetMultiplicityEstimateITSPure(tITSPure);
   hbtEvent->SetMultiplicityEstimateITSPure(fEvent->GetMultiplicity()->GetNumberOfITSClusters(1));
 
+  if (fUseTrackTable)
+    hbtEvent->SetTrackTable(new AliFemtoTrackTable(nofTracks));
+
   for (int i=0;i<nofTracks;i++)
     {
       bool  tGoodMomentum=true; //flaga to chcek if we can read momentum of this track
@@ -474,7 +478,7 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
 	}
       }
 
-      AliFemtoTrack* trackCopy = new AliFemtoTrack();
+      AliFemtoTrack* trackCopy = NewTrack(hbtEvent);
       trackCopy->SetCharge((short)esdtrack->GetSign());
 
       //in aliroot we have AliPID
@@ -565,7 +569,7 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
 
 	if (fUseTPCOnly) {
 	  if (!esdtrack->GetTPCInnerParam()) {
-	    delete trackCopy;
+	    DiscardTrack(trackCopy);
 	    continue;
 	  }
 
@@ -589,7 +593,7 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
 	  AliFemtoThreeVector v(pxyz[0],pxyz[1],pxyz[2]);
 	  if (v.Mag() < 0.0001) {
 	    //	cout << "Found 0 momentum ???? " <<endl;
-	    delete trackCopy;
+	    DiscardTrack(trackCopy);
 	    continue;
 	  }
 	  trackCopy->SetP(v);//setting momentum
@@ -644,7 +648,7 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
 	    if (esdtrack->GetTPCInnerParam())
 	      esdtrack->GetTPCInnerParam()->GetPxPyPz(pxyz);
 	    else {
-	      delete trackCopy;
+	      DiscardTrack(trackCopy);
 	      continue;
 	    }
 	  }
@@ -659,7 +663,7 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
 	  AliFemtoThreeVector v(pxyz[0],pxyz[1],pxyz[2]);
 	  if (v.Mag() < 0.0001) {
 	    //	cout << "Found 0 momentum ???? " <<endl;
-	    delete trackCopy;
+	    DiscardTrack(trackCopy);
 	    continue;
 	  }
 	  trackCopy->SetP(v);//setting momentum
@@ -743,7 +747,7 @@ void AliFemtoEventReaderESDChain::CopyESDtoFemtoEvent(AliFemtoEvent *hbtEvent)
 	  }
 	else
 	  {
-	    delete  trackCopy;
+	    DiscardTrack(trackCopy);
 	  }
 
     }
@@ -20,6 +20,7 @@
 #include "SystemOfUnits.h"
 
 #include "AliFemtoEvent.h"
+#include "AliFemtoTrackTable.h"
 
 #include "TParticle.h"
 #include "AliStack.h"
@@ -244,6 +245,8 @@ AliFemtoEvent* AliFemtoEventReaderKinematicsChain::ReturnHbtEvent()
   nofTracks=fStack->GetNtrack();
   int realnofTracks=0;//number of track which we use in analysis
 
+  if (fUseTrackTable)
+    hbtEvent->SetTrackTable(new AliFemtoTrackTable(nofTracks));
 
   int tNormMult = 0;
   int tV0direction = 0;
@@ -262,7 +265,7 @@ AliFemtoEvent* AliFemtoEventReaderKinematicsChain::ReturnHbtEvent()
 	  if(!(fStack->IsPhysicalPrimary(i) || fStack->IsSecondaryFromWeakDecay(i) || fStack->IsSecondaryFromMaterial(i))) {continue;}
 	}
 
-      AliFemtoTrack* trackCopy = new AliFemtoTrack();
+      AliFemtoTrack* trackCopy = NewTrack(hbtEvent);
 
       	  //getting next track
       TParticle *kinetrack= fStack->Particle(i);
@@ -280,7 +283,7 @@ AliFemtoEvent* AliFemtoEventReaderKinematicsChain::ReturnHbtEvent()
             motherParticle1 = fStack->Particle(motherIndex1);
 	        if(motherParticle1->GetPdgCode()==kinetrack->GetPdgCode())
              {
-                delete trackCopy;
+                DiscardTrack(trackCopy);
                  deleted_kinetrack = true;
               continue;
             
@@ -325,7 +328,7 @@ AliFemtoEvent* AliFemtoEventReaderKinematicsChain::ReturnHbtEvent()
 				}
 			}
 				if(fromWeak) {
-					delete trackCopy;
+					DiscardTrack(trackCopy);
 					continue;
 				}
 		}
@@ -381,7 +384,7 @@ AliFemtoEvent* AliFemtoEventReaderKinematicsChain::ReturnHbtEvent()
       else if(pdgcode==3312 || pdgcode==-3312) //Xi-, Xi+
 	{; }
       else {
-		delete trackCopy;
+		DiscardTrack(trackCopy);
 		continue;
       }
   
@@ -431,7 +434,7 @@ AliFemtoEvent* AliFemtoEventReaderKinematicsChain::ReturnHbtEvent()
       AliFemtoThreeVector v(pxyz[0],pxyz[1],pxyz[2]);
       if (v.Mag() < 0.0001) {
 	//cout << "Found 0 momentum ???? "  << pxyz[0] << " " << pxyz[1] << " " << pxyz[2] << endl;
-	delete trackCopy;
+	DiscardTrack(trackCopy);
 	continue;
       }
 
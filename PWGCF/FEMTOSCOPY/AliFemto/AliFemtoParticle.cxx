@@ -4,8 +4,30 @@
 
 #include "AliFemtoKink.h"
 #include "AliFemtoParticle.h"
+#include "AliFemtoTrackTable.h"
 #include "AliFemtoXi.h"
 
+// Tracks of an AliFemtoTrackTable are shared with the table, which is kept
+// alive by the particles referencing it; other tracks are copied.
+static AliFemtoTrack *ShareTrack(const AliFemtoTrack *track)
+{
+  AliFemtoTrackTable *table = track->TrackTable();
+  if (!table) {
+    return new AliFemtoTrack(*track);
+  }
+  table->AddRef();
+  return const_cast<AliFemtoTrack *>(track);
+}
+
+static void ReleaseTrack(AliFemtoTrack *track)
+{
+  if (track && track->TrackTable()) {
+    track->TrackTable()->Release();
+  } else {
+    delete track;
+  }
+}
+
 double AliFemtoParticle::fgPrimPimPar0 = 9.05632e-01;
 double AliFemtoParticle::fgPrimPimPar1 = -2.26737e-01;
 double AliFemtoParticle::fgPrimPimPar2 = -1.03922e-01;
@@ -68,7 +90,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
   // Copy constructor
   memcpy(fPurity, aParticle.fPurity, sizeof(fPurity));
   if (aParticle.fTrack)
-    fTrack = new AliFemtoTrack(*aParticle.fTrack);
+    fTrack = ShareTrack(aParticle.fTrack);
   if (aParticle.fV0)
     fV0 = new AliFemtoV0(*aParticle.fV0);
   if (aParticle.fKink)
@@ -84,7 +106,7 @@ AliFemtoParticle::AliFemtoParticle(const AliFemtoParticle &aParticle):
 //_____________________
 AliFemtoParticle::~AliFemtoParticle()
 {
-  delete fTrack;
+  ReleaseTrack(fTrack);
   delete fV0;
   delete fKink;
   delete fXi;
@@ -92,7 +114,7 @@ AliFemtoParticle::~AliFemtoParticle()
 }
 //_____________________
 AliFemtoParticle::AliFemtoParticle(const AliFemtoTrack *const hbtTrack, const double &mass):
-  fTrack(new AliFemtoTrack(*hbtTrack)),
+  fTrack(ShareTrack(hbtTrack)),
   fV0(NULL),
   fKink(NULL),
   fXi(NULL),
@@ -202,10 +224,10 @@ AliFemtoParticle &AliFemtoParticle::operator=(const AliFemtoParticle &aParticle)
   // assignment operator
   if (this == &aParticle) return *this;
 
-  delete fTrack;
+  ReleaseTrack(fTrack);
   fTrack = NULL;
   if (aParticle.fTrack) {
-    fTrack = new AliFemtoTrack(*aParticle.fTrack);
+    fTrack = ShareTrack(aParticle.fTrack);
     CalculatePurity();
   }
 
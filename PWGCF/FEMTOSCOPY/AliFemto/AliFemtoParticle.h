@@ -87,7 +87,7 @@ public:
   /*   int* fV0NegSect;                         // Array of Neg cluster sectors */
 
 private:
-  AliFemtoTrack *fTrack;  // copy of the track the particle was formed of, else Null
+  AliFemtoTrack *fTrack;  // copy of the track the particle was formed of (shared if in an AliFemtoTrackTable), else Null
   AliFemtoV0 *fV0;        // copy of the v0 the particle was formed of, else Null
   AliFemtoKink *fKink;    // copy of the v0 the particle was formed of, else Null
   AliFemtoXi *fXi;        // copy of the Xi the particle was formed of, else Null
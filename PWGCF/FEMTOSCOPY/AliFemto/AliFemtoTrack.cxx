@@ -78,7 +78,8 @@ AliFemtoTrack::AliFemtoTrack():
   fCorrPiMinus(0.0),
   fCorrKMinus(0.0),
   fCorrPMinus(0.0),
-  fCorrAll(0.0)
+  fCorrAll(0.0),
+  fTrackTable(NULL)
 {
   // Default constructor
   fKinkIndexes[0] = 0;
@@ -164,7 +165,8 @@ AliFemtoTrack::AliFemtoTrack(const AliFemtoTrack& t) :
   fCorrPiMinus(t.fCorrPiMinus),
   fCorrKMinus(t.fCorrKMinus),
   fCorrPMinus(t.fCorrPMinus),
-  fCorrAll(t.fCorrAll)
+  fCorrAll(t.fCorrAll),
+  fTrackTable(NULL)
  {
    // copy constructor
   fHiddenInfo = t.ValidHiddenInfo() ? t.GetHiddenInfo()->Clone() : nullptr;
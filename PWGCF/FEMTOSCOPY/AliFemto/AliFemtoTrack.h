@@ -20,6 +20,7 @@
 #include "TBits.h"
 #include "AliFemtoHiddenInfo.h"
 
+class AliFemtoTrackTable;
 
 class AliFemtoTrack {
 public:
@@ -208,6 +209,11 @@ public:
   void SetPrimaryVertex(const double *vertex);
   void GetPrimaryVertex(double *vertex);
 
+  /// Table holding the track (track table mode of the readers), NULL for
+  /// tracks owned by an event or particle. Copies are never in a table.
+  AliFemtoTrackTable* TrackTable() const { return fTrackTable; }
+  void SetTrackTable(AliFemtoTrackTable *aTable) { fTrackTable = aTable; }
+
   //Alice stuff
   enum {
     kITSin=0x0001,kITSout=0x0002,kITSrefit=0x0004,kITSpid=0x0008,
@@ -310,6 +316,8 @@ public:
 
   float fCorrAll;    //corrections for particles without PID
 
+  AliFemtoTrackTable *fTrackTable; //!<! table holding this track, if any
+
 };
 
 //inline const float* AliFemtoTrack::NSigma() const
@@ -0,0 +1,70 @@
+///
+/// \file AliFemtoTrackTable.cxx
+///
+
+#include "AliFemtoTrackTable.h"
+#include "AliFemtoTrack.h"
+
+#include <new>
+
+long AliFemtoTrackTable::fgLiveTables = 0;
+long AliFemtoTrackTable::fgLiveBytes = 0;
+long AliFemtoTrackTable::fgPeakBytes = 0;
+
+AliFemtoTrackTable::AliFemtoTrackTable(size_t nTracks):
+  fChunks(),
+  fChunkSize(nTracks < 64 ? 64 : nTracks),
+  fSize(0),
+  fNRefs(1)
+{
+  fgLiveTables++;
+}
+
+AliFemtoTrackTable::~AliFemtoTrackTable()
+{
+  while (fSize) {
+    RemoveLast();
+  }
+  for (size_t i = 0; i < fChunks.size(); i++) {
+    ::operator delete(fChunks[i]);
+  }
+  fgLiveTables--;
+  fgLiveBytes -= MemorySize();
+}
+
+AliFemtoTrack* AliFemtoTrackTable::NewTrack()
+{
+  if (fSize == fChunks.size() * fChunkSize) {
+    // rows are never moved, the tracks are referenced by the event and the particles
+    fChunks.push_back(static_cast<AliFemtoTrack*>(::operator new(fChunkSize * sizeof(AliFemtoTrack))));
+    fgLiveBytes += fChunkSize * sizeof(AliFemtoTrack);
+    if (fgLiveBytes > fgPeakBytes) {
+      fgPeakBytes = fgLiveBytes;
+    }
+  }
+  AliFemtoTrack *track = new (Row(fSize)) AliFemtoTrack();
+  track->SetTrackTable(this);
+  fSize++;
+  return track;
+}
+
+void AliFemtoTrackTable::RemoveLast()
+{
+  if (!fSize) {
+    return;
+  }
+  fSize--;
+  Row(fSize)->~AliFemtoTrack();
+}
+
+AliFemtoTrack* AliFemtoTrackTable::Row(size_t i) const
+{
+  return fChunks[i / fChunkSize] + i % fChunkSize;
+}
+
+size_t AliFemtoTrackTable::MemorySize() const
+{
+  /// Memory of the rows, not including the buffers owned by the tracks
+  /// (cluster maps, hidden info)
+  return fChunks.size() * fChunkSize * sizeof(AliFemtoTrack);
+}
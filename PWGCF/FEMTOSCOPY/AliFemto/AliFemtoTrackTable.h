@@ -0,0 +1,67 @@
+///
+/// \file AliFemtoTrackTable.h
+///
+
+#ifndef ALIFEMTOTRACKTABLE_H
+#define ALIFEMTOTRACKTABLE_H
+
+#include <vector>
+#include <cstddef>
+
+class AliFemtoTrack;
+
+/// \class AliFemtoTrackTable
+/// \brief Per-event block of tracks, shared by the event and its particles
+///
+/// In track table mode (AliFemtoEventReader::SetUseTrackTable) a reader stores
+/// the tracks of an event in the rows of a table, allocated in a few chunks
+/// instead of one object per track. The track collection of the AliFemtoEvent
+/// points to the rows, and the AliFemtoParticles made of them by the particle
+/// cuts of all analyses reference the rows instead of copying the track.
+///
+/// The table is reference counted: the event holds one reference, each
+/// particle made of one of its tracks another one, the table is deleted with
+/// the last of them (i.e. when the event and all particles in the mixing
+/// buffers are gone). Tracks of a table must not be modified by the analyses.
+///
+class AliFemtoTrackTable {
+public:
+  /// Empty table with one reference, the first chunk holds nTracks rows
+  AliFemtoTrackTable(size_t nTracks);
+
+  /// Default constructed track in the next row
+  AliFemtoTrack* NewTrack();
+
+  /// Removes the last track returned by NewTrack(), its row is reused
+  void RemoveLast();
+
+  size_t Size() const { return fSize; }
+  size_t MemorySize() const;
+
+  void AddRef() { ++fNRefs; }
+  void Release() { if (--fNRefs == 0) delete this; }
+  int NRefs() const { return fNRefs; }
+
+  /// Number of tables and their memory, summed over all live tables
+  static long LiveTables() { return fgLiveTables; }
+  static long LiveBytes() { return fgLiveBytes; }
+  static long PeakBytes() { return fgPeakBytes; }
+
+private:
+  ~AliFemtoTrackTable();
+  AliFemtoTrackTable(const AliFemtoTrackTable&);
+  AliFemtoTrackTable& operator=(const AliFemtoTrackTable&);
+
+  AliFemtoTrack* Row(size_t i) const;
+
+  std::vector<AliFemtoTrack*> fChunks;  ///< Storage of the rows, fChunkSize each
+  size_t fChunkSize;                    ///< Rows per chunk
+  size_t fSize;                         ///< Number of constructed rows
+  int    fNRefs;                        ///< Number of references (event, particles)
+
+  static long fgLiveTables;             ///< Number of existing tables
+  static long fgLiveBytes;              ///< Memory of the existing tables
+  static long fgPeakBytes;              ///< Maximum of fgLiveBytes
+};
+
+#endif
@@ -155,14 +155,14 @@ AliAnalysisTaskSE(),
   farrP2(),
   fIC(),
   fDefaultsCharSwitch(),
-  fLowQPairSwitch_E0E0(),
-  fLowQPairSwitch_E0E1(),
-  fLowQPairSwitch_E0E2(),
-  fLowQPairSwitch_E0E3(),
-  fLowQPairSwitch_E1E1(),
-  fLowQPairSwitch_E1E2(),
-  fLowQPairSwitch_E1E3(),
-  fLowQPairSwitch_E2E3(),
+  fLowQPairs_E0E0(),
+  fLowQPairs_E0E1(),
+  fLowQPairs_E0E2(),
+  fLowQPairs_E0E3(),
+  fLowQPairs_E1E1(),
+  fLowQPairs_E1E2(),
+  fLowQPairs_E1E3(),
+  fLowQPairs_E2E3(),
   fNormQPairSwitch_E0E0(),
   fNormQPairSwitch_E0E1(),
   fNormQPairSwitch_E0E2(),
@@ -372,14 +372,14 @@ AliFourPion::AliFourPion(const Char_t *name)
   farrP2(),
   fIC(),
   fDefaultsCharSwitch(),
-  fLowQPairSwitch_E0E0(),
-  fLowQPairSwitch_E0E1(),
-  fLowQPairSwitch_E0E2(),
-  fLowQPairSwitch_E0E3(),
-  fLowQPairSwitch_E1E1(),
-  fLowQPairSwitch_E1E2(),
-  fLowQPairSwitch_E1E3(),
-  fLowQPairSwitch_E2E3(),
+  fLowQPairs_E0E0(),
+  fLowQPairs_E0E1(),
+  fLowQPairs_E0E2(),
+  fLowQPairs_E0E3(),
+  fLowQPairs_E1E1(),
+  fLowQPairs_E1E2(),
+  fLowQPairs_E1E3(),
+  fLowQPairs_E2E3(),
   fNormQPairSwitch_E0E0(),
   fNormQPairSwitch_E0E1(),
   fNormQPairSwitch_E0E2(),
@@ -594,14 +594,14 @@ AliFourPion::AliFourPion(const AliFourPion &obj)
     farrP2(),
     fIC(),
     fDefaultsCharSwitch(),
-    fLowQPairSwitch_E0E0(),
-    fLowQPairSwitch_E0E1(),
-    fLowQPairSwitch_E0E2(),
-    fLowQPairSwitch_E0E3(),
-    fLowQPairSwitch_E1E1(),
-    fLowQPairSwitch_E1E2(),
-    fLowQPairSwitch_E1E3(),
-    fLowQPairSwitch_E2E3(),
+    fLowQPairs_E0E0(),
+    fLowQPairs_E0E1(),
+    fLowQPairs_E0E2(),
+    fLowQPairs_E0E3(),
+    fLowQPairs_E1E1(),
+    fLowQPairs_E1E2(),
+    fLowQPairs_E1E3(),
+    fLowQPairs_E2E3(),
     fNormQPairSwitch_E0E0(),
     fNormQPairSwitch_E0E1(),
     fNormQPairSwitch_E0E2(),
@@ -806,15 +806,6 @@ AliFourPion::~AliFourPion()
   }
   
   for(Int_t j=0; j<kMultLimitPbPb; j++){
-    if(fLowQPairSwitch_E0E0[j]) delete [] fLowQPairSwitch_E0E0[j];
-    if(fLowQPairSwitch_E0E1[j]) delete [] fLowQPairSwitch_E0E1[j];
-    if(fLowQPairSwitch_E0E2[j]) delete [] fLowQPairSwitch_E0E2[j];
-    if(fLowQPairSwitch_E0E3[j]) delete [] fLowQPairSwitch_E0E3[j];
-    if(fLowQPairSwitch_E1E1[j]) delete [] fLowQPairSwitch_E1E1[j];
-    if(fLowQPairSwitch_E1E2[j]) delete [] fLowQPairSwitch_E1E2[j];
-    if(fLowQPairSwitch_E1E3[j]) delete [] fLowQPairSwitch_E1E3[j];
-    if(fLowQPairSwitch_E2E3[j]) delete [] fLowQPairSwitch_E2E3[j];
-    //
     if(fNormQPairSwitch_E0E0[j]) delete [] fNormQPairSwitch_E0E0[j];
     if(fNormQPairSwitch_E0E1[j]) delete [] fNormQPairSwitch_E0E1[j];
     if(fNormQPairSwitch_E0E2[j]) delete [] fNormQPairSwitch_E0E2[j];
@@ -1040,15 +1031,6 @@ void AliFourPion::ParInit()
   
   for(Int_t i=0; i<kMultLimitPbPb; i++) fDefaultsCharSwitch[i]='0';
   for(Int_t i=0; i<kMultLimitPbPb; i++) {
-    fLowQPairSwitch_E0E0[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E2E3[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
-    //
     fNormQPairSwitch_E0E0[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
     fNormQPairSwitch_E0E1[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
     fNormQPairSwitch_E0E2[i] = new TArrayC(kMultLimitPbPb,fDefaultsCharSwitch);
@@ -2678,6 +2660,7 @@ void AliFourPion::UserExec(Option_t *)
   Bool_t pionParent1=kFALSE, pionParent2=kFALSE, pionParent3=kFALSE, pionParent4=kFALSE;
   Bool_t FilledMCpair12=kFALSE, FilledMCtriplet123=kFALSE;
   Bool_t Positive1stTripletWeights=kTRUE, Positive2ndTripletWeights=kTRUE;
+  std::vector<Int_t> lowQPartners3, lowQPartners34, lowQPartners4;// common low-q partners of particles 1,2 and 1,2,3
   Float_t T12=0, T13=0, T14=0, T23=0, T24=0, T34=0;
   Float_t t12=0, t13=0, t14=0, t23=0, t24=0, t34=0;
   Int_t momBin12=1, momBin13=1, momBin14=1, momBin23=1, momBin24=1, momBin34=1;
@@ -2692,15 +2675,6 @@ void AliFourPion::UserExec(Option_t *)
 
   // reset to defaults
   for(Int_t i=0; i<fMultLimit; i++) {
-    fLowQPairSwitch_E0E0[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E0E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E1E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    fLowQPairSwitch_E2E3[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
-    //
     fNormQPairSwitch_E0E0[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
     fNormQPairSwitch_E0E1[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
     fNormQPairSwitch_E0E2[i]->Set(kMultLimitPbPb,fDefaultsCharSwitch);
@@ -2718,6 +2692,8 @@ void AliFourPion::UserExec(Option_t *)
   for(Int_t en1=0; en1<=2; en1++){// 1st event number (en1=0 is the same event as current event)
     for(Int_t en2=en1; en2<=3; en2++){// 2nd event number (en2=0 is the same event as current event)
       if(en1>1 && en1==en2) continue;
+      AliLowQPairGraph *lowQPairs = GetLowQPairGraph(en1, en2);
+      lowQPairs->Reset((fEvt+en1)->fNtracks);
       
       for (Int_t i=0; i<(fEvt+en1)->fNtracks; i++) {// 1st particle
 	for (Int_t j=i+1; j<(fEvt+en2)->fNtracks; j++) {// 2nd particle
@@ -2842,16 +2818,7 @@ void AliFourPion::UserExec(Option_t *)
 	  
 	  //////////////////////////////////////////////////////////////////////////////
 	 
-	  if(qinv12 <= fQcut) {
-	    if(en1==0 && en2==0) {fLowQPairSwitch_E0E0[i]->AddAt('1',j);}
-	    if(en1==0 && en2==1) {fLowQPairSwitch_E0E1[i]->AddAt('1',j);}
-	    if(en1==0 && en2==2) {fLowQPairSwitch_E0E2[i]->AddAt('1',j);}
-	    if(en1==0 && en2==3) {fLowQPairSwitch_E0E3[i]->AddAt('1',j);}
-	    if(en1==1 && en2==1) {fLowQPairSwitch_E1E1[i]->AddAt('1',j);}
-	    if(en1==1 && en2==2) {fLowQPairSwitch_E1E2[i]->AddAt('1',j);}
-	    if(en1==1 && en2==3) {fLowQPairSwitch_E1E3[i]->AddAt('1',j);}
-	    if(en1==2 && en2==3) {fLowQPairSwitch_E2E3[i]->AddAt('1',j);}
-	  }
+	  if(qinv12 <= fQcut) lowQPairs->AddPair(i,j);
 	  if((qinv12 >= fNormQcutLow) && (qinv12 < fNormQcutHigh)) {
 	    if(en1==0 && en2==0) {fNormQPairSwitch_E0E0[i]->AddAt('1',j);}
 	    if(en1==0 && en2==1) {fNormQPairSwitch_E0E1[i]->AddAt('1',j);}
@@ -2865,6 +2832,7 @@ void AliFourPion::UserExec(Option_t *)
 	  
 	}
       }
+      lowQPairs->Finish();
     }
   }
     
@@ -3050,9 +3018,12 @@ void AliFourPion::UserExec(Option_t *)
 	    if((fEvt)->fTracks[i].fPt > fMaxPt) continue;
 
 	    /////////////////////////////////////////////////////////////
-	    for (Int_t j=i+1; j<(fEvt+en2)->fNtracks; j++) {// 2nd particle
-	      if(en2==0) {if(fLowQPairSwitch_E0E0[i]->At(j)=='0') continue;}
-	      else {if(fLowQPairSwitch_E0E1[i]->At(j)=='0') continue;}
+	    // low-q partners j > i of particle i
+	    const AliLowQPairGraph &lowQPairs12 = (en2==0 ? fLowQPairs_E0E0 : fLowQPairs_E0E1);
+	    const Int_t nLowQPartners2 = lowQPairs12.GetNPartners(i);
+	    const Int_t *lowQPartners2 = lowQPairs12.GetPartners(i);
+	    for (Int_t jPartner=0; jPartner<nLowQPartners2; jPartner++) {// 2nd particle
+	      Int_t j = lowQPartners2[jPartner];
 	      if((fEvt+en2)->fTracks[j].fPt < fMinPt) continue; 
 	      if((fEvt+en2)->fTracks[j].fPt > fMaxPt) continue;
 	      
@@ -3257,17 +3228,20 @@ void AliFourPion::UserExec(Option_t *)
 	     
 	     
 	      /////////////////////////////////////////////////////////////
-	      for (Int_t k=j+1; k<(fEvt+en3)->fNtracks; k++) {// 3rd particle
-		if(en3==0) {
-		  if(fLowQPairSwitch_E0E0[i]->At(k)=='0') continue;
-		  if(fLowQPairSwitch_E0E0[j]->At(k)=='0') continue;
-		}else if(en3==1){
-		  if(fLowQPairSwitch_E0E1[i]->At(k)=='0') continue;
-		  if(fLowQPairSwitch_E0E1[j]->At(k)=='0') continue;
-		}else{
-		  if(fLowQPairSwitch_E0E2[i]->At(k)=='0') continue;
-		  if(fLowQPairSwitch_E1E2[j]->At(k)=='0') continue;
-		}
+	      // common low-q partners k > j of particles i and j (3rd particle),
+	      // and l > j (4th particle, to be intersected with the partners of k)
+	      if(en3==0) AliLowQPairGraph::Intersect(fLowQPairs_E0E0, i, fLowQPairs_E0E0, j, j, lowQPartners3);
+	      else if(en3==1) AliLowQPairGraph::Intersect(fLowQPairs_E0E1, i, fLowQPairs_E0E1, j, j, lowQPartners3);
+	      else AliLowQPairGraph::Intersect(fLowQPairs_E0E2, i, fLowQPairs_E1E2, j, j, lowQPartners3);
+	      const std::vector<Int_t> *lowQCandidates4 = &lowQPartners3;
+	      if(en4!=en3){
+		if(en4==1) AliLowQPairGraph::Intersect(fLowQPairs_E0E1, i, fLowQPairs_E0E1, j, j, lowQPartners34);
+		else if(en4==2) AliLowQPairGraph::Intersect(fLowQPairs_E0E2, i, fLowQPairs_E0E2, j, j, lowQPartners34);
+		else AliLowQPairGraph::Intersect(fLowQPairs_E0E3, i, fLowQPairs_E1E3, j, j, lowQPartners34);
+		lowQCandidates4 = &lowQPartners34;
+	      }
+	      for (UInt_t kPartner=0; kPartner<lowQPartners3.size(); kPartner++) {// 3rd particle
+		Int_t k = lowQPartners3[kPartner];
 		if((fEvt+en3)->fTracks[k].fPt < fMinPt) continue; 
 		if((fEvt+en3)->fTracks[k].fPt > fMaxPt) continue;
 
@@ -3655,30 +3629,14 @@ void AliFourPion::UserExec(Option_t *)
 		
 		
 		/////////////////////////////////////////////////////////////
-		for (Int_t l=k+1; l<(fEvt+en4)->fNtracks; l++) {// 4th particle
-		  if(en4==0){
-		    if(fLowQPairSwitch_E0E0[i]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E0E0[j]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E0E0[k]->At(l)=='0') continue;
-		  }else if(en4==1){
-		    if(en3==0){
-		      if(fLowQPairSwitch_E0E1[i]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E0E1[j]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E0E1[k]->At(l)=='0') continue;
-		    }else{ 
-		      if(fLowQPairSwitch_E0E1[i]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E0E1[j]->At(l)=='0') continue;
-		      if(fLowQPairSwitch_E1E1[k]->At(l)=='0') continue;
-		    }
-		  }else if(en4==2){
-		    if(fLowQPairSwitch_E0E2[i]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E0E2[j]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E1E2[k]->At(l)=='0') continue;
-		  }else{
-		    if(fLowQPairSwitch_E0E3[i]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E1E3[j]->At(l)=='0') continue;
-		    if(fLowQPairSwitch_E2E3[k]->At(l)=='0') continue;
-		  }
+		// common low-q partners l > k of particles i, j and k
+		if(en4==0) AliLowQPairGraph::Intersect(*lowQCandidates4, fLowQPairs_E0E0, k, k, lowQPartners4);
+		else if(en4==1 && en3==0) AliLowQPairGraph::Intersect(*lowQCandidates4, fLowQPairs_E0E1, k, k, lowQPartners4);
+		else if(en4==1) AliLowQPairGraph::Intersect(*lowQCandidates4, fLowQPairs_E1E1, k, k, lowQPartners4);
+		else if(en4==2) AliLowQPairGraph::Intersect(*lowQCandidates4, fLowQPairs_E1E2, k, k, lowQPartners4);
+		else AliLowQPairGraph::Intersect(*lowQCandidates4, fLowQPairs_E2E3, k, k, lowQPartners4);
+		for (UInt_t lPartner=0; lPartner<lowQPartners4.size(); lPartner++) {// 4th particle
+		  Int_t l = lowQPartners4[lPartner];
 		  if((fEvt+en4)->fTracks[l].fPt < fMinPt) continue; 
 		  if((fEvt+en4)->fTracks[l].fPt > fMaxPt) continue;
 		  
@@ -4376,6 +4334,19 @@ void AliFourPion::Shuffle(Int_t *iarr, Int_t i1, Int_t i2)
 }
 
 
+//________________________________________________________________________
+AliLowQPairGraph *AliFourPion::GetLowQPairGraph(Int_t en1, Int_t en2)
+{
+  // low-q pairs between particles of event en1 (1st) and event en2 (2nd)
+  if(en1==0 && en2==0) return &fLowQPairs_E0E0;
+  if(en1==0 && en2==1) return &fLowQPairs_E0E1;
+  if(en1==0 && en2==2) return &fLowQPairs_E0E2;
+  if(en1==0 && en2==3) return &fLowQPairs_E0E3;
+  if(en1==1 && en2==1) return &fLowQPairs_E1E1;
+  if(en1==1 && en2==2) return &fLowQPairs_E1E2;
+  if(en1==1 && en2==3) return &fLowQPairs_E1E3;
+  return &fLowQPairs_E2E3;
+}
 //________________________________________________________________________
 Float_t AliFourPion::GetQinv(Float_t track1[], Float_t track2[]){
   
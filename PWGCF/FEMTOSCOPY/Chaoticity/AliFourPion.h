@@ -31,6 +31,7 @@ class AliESDpid;
 #include "AliESDpid.h"
 #include "AliAODPid.h"
 #include "AliFourPionEventCollection.h"
+#include "AliLowQPairGraph.h"
 #include "AliCentrality.h"
 
 class AliFourPion : public AliAnalysisTaskSE {
@@ -132,6 +133,7 @@ class AliFourPion : public AliAnalysisTaskSE {
   Float_t Gamov(Int_t, Int_t, Float_t);
   void Shuffle(Int_t*, Int_t, Int_t);
   Float_t GetQinv(Float_t[], Float_t[]);
+  AliLowQPairGraph *GetLowQPairGraph(Int_t, Int_t);
   void GetQosl(Float_t[], Float_t[], Float_t&, Float_t&, Float_t&);
   void GetWeight(Float_t[], Float_t[], Float_t&, Float_t&);
   Float_t FSICorrelation(Int_t, Int_t, Float_t);
@@ -380,14 +382,14 @@ class AliFourPion : public AliAnalysisTaskSE {
   
   //
   Char_t fDefaultsCharSwitch[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E0[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E1[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E2[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E0E3[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E1E1[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E1E2[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E1E3[kMultLimitPbPb];//!
-  TArrayC *fLowQPairSwitch_E2E3[kMultLimitPbPb];//!
+  AliLowQPairGraph fLowQPairs_E0E0;//!
+  AliLowQPairGraph fLowQPairs_E0E1;//!
+  AliLowQPairGraph fLowQPairs_E0E2;//!
+  AliLowQPairGraph fLowQPairs_E0E3;//!
+  AliLowQPairGraph fLowQPairs_E1E1;//!
+  AliLowQPairGraph fLowQPairs_E1E2;//!
+  AliLowQPairGraph fLowQPairs_E1E3;//!
+  AliLowQPairGraph fLowQPairs_E2E3;//!
   //
   TArrayC *fNormQPairSwitch_E0E0[kMultLimitPbPb];//!
   TArrayC *fNormQPairSwitch_E0E1[kMultLimitPbPb];//!
@@ -418,7 +420,7 @@ class AliFourPion : public AliAnalysisTaskSE {
   TF1 *ExchangeAmp[7][50][2];
 
  
-  ClassDef(AliFourPion, 1); 
+  ClassDef(AliFourPion, 2); 
 };
 
 #endif
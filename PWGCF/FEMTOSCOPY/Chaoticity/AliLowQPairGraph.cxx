@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Sparse storage of the low-q pairs between the tracks of two events,
+//  see AliLowQPairGraph.h
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include "AliLowQPairGraph.h"
+
+AliLowQPairGraph::AliLowQPairGraph():
+  fNRows(0),
+  fLastRow(-1),
+  fRowStart(1,0),
+  fPartners()
+{
+}
+//_____________________________________________________________________________
+void AliLowQPairGraph::Reset(Int_t nRows)
+{
+  // forget all pairs, nRows rows will be filled
+  fNRows = nRows > 0 ? nRows : 0;
+  fLastRow = -1;
+  fRowStart.assign(fNRows+1, 0);
+  fPartners.clear();
+}
+//_____________________________________________________________________________
+void AliLowQPairGraph::AddPair(Int_t i, Int_t j)
+{
+  // rows have to be filled in increasing order, partners in increasing order within a row
+  if(i < fLastRow || i >= fNRows) return;
+  for(Int_t row=fLastRow+1; row<=i; row++) fRowStart[row] = fPartners.size();
+  fLastRow = i;
+  fPartners.push_back(j);
+}
+//_____________________________________________________________________________
+void AliLowQPairGraph::Finish()
+{
+  // close the rows after the last one with pairs
+  for(Int_t row=fLastRow+1; row<=fNRows; row++) fRowStart[row] = fPartners.size();
+  fLastRow = fNRows;
+}
+//_____________________________________________________________________________
+Bool_t AliLowQPairGraph::IsPair(Int_t i, Int_t j) const
+{
+  const Int_t n = GetNPartners(i);
+  if(!n) return kFALSE;
+  const Int_t *partners = GetPartners(i);
+  return std::binary_search(partners, partners+n, j);
+}
+//_____________________________________________________________________________
+Int_t AliLowQPairGraph::Intersect(const AliLowQPairGraph &g1, Int_t i1, const AliLowQPairGraph &g2, Int_t i2, Int_t min, std::vector<Int_t> &common)
+{
+  // partners > min common to row i1 of g1 and row i2 of g2, in increasing order
+  common.clear();
+  Int_t n1 = g1.GetNPartners(i1), n2 = g2.GetNPartners(i2);
+  if(!n1 || !n2) return 0;
+  const Int_t *p1 = g1.GetPartners(i1), *end1 = p1 + n1;
+  const Int_t *p2 = g2.GetPartners(i2), *end2 = p2 + n2;
+  p1 = std::upper_bound(p1, end1, min);
+  p2 = std::upper_bound(p2, end2, min);
+  while(p1 != end1 && p2 != end2){
+    if(*p1 < *p2) p1++;
+    else if(*p2 < *p1) p2++;
+    else {common.push_back(*p1); p1++; p2++;}
+  }
+  return common.size();
+}
+//_____________________________________________________________________________
+Int_t AliLowQPairGraph::Intersect(const std::vector<Int_t> &candidates, const AliLowQPairGraph &g, Int_t i, Int_t min, std::vector<Int_t> &common)
+{
+  // candidates (in increasing order) > min which are partners of row i of g, in increasing order
+  // (e.g. the common partners of two particles intersected with those of a third one)
+  common.clear();
+  Int_t n = g.GetNPartners(i);
+  if(!n || candidates.empty()) return 0;
+  const Int_t *p = g.GetPartners(i), *end = p + n;
+  std::vector<Int_t>::const_iterator c = std::upper_bound(candidates.begin(), candidates.end(), min);
+  p = std::upper_bound(p, end, min);
+  while(c != candidates.end() && p != end){
+    if(*c < *p) c++;
+    else if(*p < *c) p++;
+    else {common.push_back(*c); c++; p++;}
+  }
+  return common.size();
+}
@@ -0,0 +1,46 @@
+#ifndef ALILOWQPAIRGRAPH
+#define ALILOWQPAIRGRAPH
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Sparse storage of the low-q pairs between the tracks of two events
+//  (compressed rows: for each track of the 1st event the sorted list of
+//  low-q partners in the 2nd event), used to enumerate the triplets and
+//  quadruplets of multi-pion correlation analyses in which all pairs are
+//  at low relative momentum by intersecting neighbour lists
+//
+//  The pairs have to be added row by row, in increasing order of the
+//  partner within a row, as in the usual i < j pair loops.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "Rtypes.h"
+
+class AliLowQPairGraph {
+  
+ public:
+  AliLowQPairGraph();
+  virtual ~AliLowQPairGraph() {}
+
+  void Reset(Int_t nRows);
+  void AddPair(Int_t i, Int_t j);
+  void Finish();
+
+  Int_t GetNRows() const {return fNRows;}
+  Int_t GetNPairs() const {return fPartners.size();}
+  Int_t GetNPartners(Int_t i) const {return (i < 0 || i >= fNRows) ? 0 : fRowStart[i+1] - fRowStart[i];}
+  const Int_t *GetPartners(Int_t i) const {return GetNPartners(i) ? &fPartners[fRowStart[i]] : 0;}
+  Bool_t IsPair(Int_t i, Int_t j) const;
+
+  static Int_t Intersect(const AliLowQPairGraph &g1, Int_t i1, const AliLowQPairGraph &g2, Int_t i2, Int_t min, std::vector<Int_t> &common);
+  static Int_t Intersect(const std::vector<Int_t> &candidates, const AliLowQPairGraph &g, Int_t i, Int_t min, std::vector<Int_t> &common);
+
+ private:
+  Int_t fNRows;                  // rows (tracks of the 1st event)
+  Int_t fLastRow;                // last row with pairs added
+  std::vector<Int_t> fRowStart;  // first partner of each row, fNRows+1 entries
+  std::vector<Int_t> fPartners;  // partners of all rows
+};
+
+#endif
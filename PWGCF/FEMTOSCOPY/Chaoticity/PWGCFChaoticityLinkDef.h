@@ -16,3 +16,4 @@
 #pragma link C++ class AliFourPionEventStruct+;
 #pragma link C++ class AliFourPionTrackStruct+;
 #pragma link C++ class AliFourPionMCStruct+;
+#pragma link C++ class AliLowQPairGraph+;
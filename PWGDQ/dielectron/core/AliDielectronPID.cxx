@@ -35,6 +35,7 @@ Detailed description
 #include <AliLog.h>
 #include <AliExternalTrackParam.h>
 #include <AliPIDResponse.h>
+#include <AliPIDResponseCache.h>
 #include <AliTRDPIDResponse.h>
 #include <AliESDtrack.h> //!!!!! Remove once Eta correction is treated in the tender
 #include <AliAODTrack.h>
@@ -364,7 +365,7 @@ Bool_t AliDielectronPID::IsSelected(TObject* track)
 
     // check if fFunSigma is set, then check if 'part' is in sigma range of the function
     if(fFunSigma[icut]){
-        val= fPIDResponse->NumberOfSigmasTPC(part, fPartType[icut]);
+        val= AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, part, fPartType[icut]);
         if (fPartType[icut]==AliPID::kElectron){
             val-=fgCorr;
         }
@@ -443,7 +444,7 @@ Bool_t AliDielectronPID::IsSelectedITS(AliVTrack * const part, Int_t icut)
 
   Double_t mom=part->P();
   
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasITS(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::Instance()->NumberOfSigmasITS(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
@@ -472,7 +473,7 @@ Bool_t AliDielectronPID::IsSelectedTPC(AliVTrack * const part, Int_t icut, Doubl
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
   
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasTPC(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::Instance()->NumberOfSigmasTPC(fPIDResponse, part, fPartType[icut]);
 
   // post pid corrections ("eta corrections")
   if (fPartType[icut]==AliPID::kElectron){
@@ -569,7 +570,7 @@ Bool_t AliDielectronPID::IsSelectedTOF(AliVTrack * const part, Int_t icut)
   if (fRequirePIDbit[icut]==AliDielectronPID::kRequire&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kFALSE;
   if (fRequirePIDbit[icut]==AliDielectronPID::kIfAvailable&&(pidStatus!=AliPIDResponse::kDetPidOk)) return kTRUE;
 
-  Float_t numberOfSigmas=fPIDResponse->NumberOfSigmasTOF(part, fPartType[icut]);
+  Float_t numberOfSigmas=AliPIDResponseCache::Instance()->NumberOfSigmasTOF(fPIDResponse, part, fPartType[icut]);
   
   Bool_t selected=((numberOfSigmas>=fNsigmaLow[icut])&&(numberOfSigmas<=fNsigmaUp[icut]))^fExclude[icut];
   return selected;
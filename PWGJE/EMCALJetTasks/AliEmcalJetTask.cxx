@@ -70,6 +70,8 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fAddJetAlgos(),
+  fAddRadii(),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -79,7 +81,9 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fJets(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
-  fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask")
+  fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
+  fAddJets(),
+  fAddFastJetWrappers()
 {
 }
 
@@ -105,6 +109,8 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fTrackEfficiencyOnlyForEmbedding(kFALSE),
   fUtilities(0),
   fLocked(0),
+  fAddJetAlgos(),
+  fAddRadii(),
   fJetsName(),
   fIsInit(0),
   fIsPSelSet(0),
@@ -114,7 +120,9 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fJets(0),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
-  fFastJetWrapper(name,name)
+  fFastJetWrapper(name,name),
+  fAddJets(),
+  fAddFastJetWrappers()
 {
 }
 
@@ -123,6 +131,7 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+  for (UInt_t i = 0; i < fAddFastJetWrappers.size(); i++) delete fAddFastJetWrappers[i];
 }
 
 /**
@@ -208,9 +217,11 @@ Bool_t AliEmcalJetTask::Run()
   fJets->Delete();
   Int_t n = FindJets();
 
-  if (n == 0) return kFALSE;
+  if (n > 0) FillJetBranch();
+
+  FindAdditionalJets();
 
-  FillJetBranch();
+  if (n == 0) return kFALSE;
 
   return kTRUE;
 }
@@ -280,6 +291,32 @@ Int_t AliEmcalJetTask::FindJets()
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * This method runs the jet finder for the additional jet definitions on the input vectors
+ * of the main jet definition (see FindJets()), and fills the corresponding jet branches.
+ * The ghost generator is reset to the state it had before the main jet definition,
+ * therefore all jet definitions share the same ghosts.
+ */
+void AliEmcalJetTask::FindAdditionalJets()
+{
+  for (UInt_t idef = 0; idef < fAddFastJetWrappers.size(); idef++) {
+    if (!fAddJets[idef]) continue;
+    fAddJets[idef]->Delete();
+
+    AliFJWrapper *wrapper = fAddFastJetWrappers[idef];
+    wrapper->Clear();
+    if (fFastJetWrapper.GetInputVectors().size() == 0) continue;
+    wrapper->AddInputVectors(fFastJetWrapper.GetInputVectors());
+
+    // same ghosts as the main jet definition: start from the state its area spec had
+    wrapper->SetGhostRandomStatus(fFastJetWrapper.GetGhostRandomStatus());
+    wrapper->Run();
+
+    if (wrapper->GetInclusiveJets().size() == 0) continue;
+    FillJetBranch(*wrapper, fAddJets[idef], fAddRadii[idef], kFALSE);
+  }
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -287,10 +324,22 @@ Int_t AliEmcalJetTask::FindJets()
  */
 void AliEmcalJetTask::FillJetBranch()
 {
-  PrepareUtilities();
+  FillJetBranch(fFastJetWrapper, fJets, fRadius, kTRUE);
+}
+
+/**
+ * Fill a jet output branch with the jets found by a FastJet wrapper.
+ * @param wrapper FastJet wrapper after running the jet finder
+ * @param jets Output jet branch
+ * @param radius Jet radius, used for the fiducial acceptance
+ * @param doUtilities If kTRUE the utilities are executed
+ */
+void AliEmcalJetTask::FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, Bool_t doUtilities)
+{
+  if (doUtilities) PrepareUtilities();
 
   // loop over fastjet jets
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper.GetInclusiveJets();
+  std::vector<fastjet::PseudoJet> jets_incl = wrapper.GetInclusiveJets();
   // sort jets according to jet pt
   static Int_t indexes[9999] = {-1};
   GetSortedArray(indexes, jets_incl);
@@ -298,27 +347,27 @@ void AliEmcalJetTask::FillJetBranch()
   AliDebug(1,Form("%d jets found", (Int_t)jets_incl.size()));
   for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
     Int_t ij = indexes[ijet];
-    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), fFastJetWrapper.GetJetArea(ij)));
+    AliDebug(3,Form("Jet pt = %f, area = %f", jets_incl[ij].perp(), wrapper.GetJetArea(ij)));
 
     if (jets_incl[ij].perp() < fMinJetPt) continue;
-    if (fFastJetWrapper.GetJetArea(ij) < fMinJetArea) continue;
+    if (wrapper.GetJetArea(ij) < fMinJetArea) continue;
     if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
         (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
       continue;
 
-    AliEmcalJet *jet = new ((*fJets)[jetCount])
+    AliEmcalJet *jet = new ((*jets)[jetCount])
     		          AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
     jet->SetLabel(ij);
 
-    fastjet::PseudoJet area(fFastJetWrapper.GetJetAreaVector(ij));
+    fastjet::PseudoJet area(wrapper.GetJetAreaVector(ij));
     jet->SetArea(area.perp());
     jet->SetAreaEta(area.eta());
     jet->SetAreaPhi(area.phi());
     jet->SetAreaE(area.E());
-    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), fRadius));
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), radius));
 
     // Fill constituent info
-    std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper.GetJetConstituents(ij));
+    std::vector<fastjet::PseudoJet> constituents(wrapper.GetJetConstituents(ij));
     FillJetConstituents(jet, constituents, constituents);
 
     if (fGeom) {
@@ -329,13 +378,13 @@ void AliEmcalJetTask::FillJetBranch()
         jet->SetAxisInEmcal(kTRUE);
     }
 
-    ExecuteUtilities(jet, ij);
+    if (doUtilities) ExecuteUtilities(jet, ij);
 
     AliDebug(2,Form("Added jet n. %d, pt = %f, area = %f, constituents = %d", jetCount, jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
     jetCount++;
   }
 
-  TerminateUtilities();
+  if (doUtilities) TerminateUtilities();
 }
 
 /**
@@ -401,6 +450,29 @@ void AliEmcalJetTask::ExecOnce()
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
 
+  // additional jet definitions
+  for (UInt_t idef = 0; idef < fAddRadii.size(); idef++) {
+    EJetAlgo_t algo = static_cast<EJetAlgo_t>(fAddJetAlgos[idef]);
+    TString jetsName = AliJetContainer::GenerateJetName(fJetType, algo, fRecombScheme, fAddRadii[idef], GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+    TClonesArray *jets = 0;
+    if (InputEvent()->FindListObject(jetsName)) {
+      AliError(Form("%s: Object with name %s already in event! Skipping this jet definition", GetName(), jetsName.Data()));
+    }
+    else {
+      jets = new TClonesArray("AliEmcalJet");
+      jets->SetName(jetsName);
+      ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", jetsName.Data());
+      InputEvent()->AddObject(jets);
+    }
+    fAddJets.push_back(jets);
+
+    AliFJWrapper *wrapper = new AliFJWrapper(jetsName, jetsName);
+    wrapper->CopySettingsFrom(fFastJetWrapper);
+    wrapper->SetR(fAddRadii[idef]);
+    wrapper->SetAlgorithm(ConvertToFJAlgo(algo));
+    fAddFastJetWrappers.push_back(wrapper);
+  }
+
   InitUtilities();
 
   AliAnalysisTaskEmcal::ExecOnce();
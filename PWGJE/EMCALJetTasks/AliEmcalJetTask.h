@@ -44,6 +44,19 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional jet definitions (algorithm and radius) can be added via AddJetDefinition(). The
+ * input vectors are then built only once per event and clustered for each definition, using the
+ * same set of ghosts for the area calculation. Each additional definition fills its own jet
+ * branch, named as the branch of a separate task with the same settings would be. Utilities
+ * are only executed for the main jet definition.
+ * ~~~{.cxx}
+ * AliEmcalJetTask *jetTask = AliEmcalJetTask::AddTaskEmcalJet("usedefault", "", AliJetContainer::antikt_algorithm, 0.2,
+ *     AliJetContainer::kChargedJet, 0.15, 0.30, 0.005, AliJetContainer::pt_scheme, "Jet", 0., kFALSE);
+ * jetTask->AddJetDefinition(AliJetContainer::antikt_algorithm, 0.4);
+ * jetTask->AddJetDefinition(AliJetContainer::kt_algorithm, 0.4);
+ * jetTask->SetLocked();
+ * ~~~
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -79,6 +92,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetLegacyMode(Bool_t mode)                 { if (IsLocked()) return; fLegacyMode       = mode  ; }
   void                   SetFillGhost(Bool_t b=kTRUE)               { if (IsLocked()) return; fFillGhost        = b     ; }
   void                   SetRadius(Double_t r)                      { if (IsLocked()) return; fRadius           = r     ; }
+  void                   AddJetDefinition(EJetAlgo_t a, Double_t r) { if (IsLocked()) return; fAddJetAlgos.push_back(a); fAddRadii.push_back(r); }
 
   void                   SetEtaRange(Double_t emi, Double_t ema);
   void                   SetMinJetClusPt(Double_t min);
@@ -107,6 +121,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 GetTrackEfficiencyOnlyForEmbedding() { return fTrackEfficiencyOnlyForEmbedding; }
 
   TClonesArray*          GetJets()                        { return fJets              ; }
+  UInt_t                 GetNAdditionalJetDefinitions()   { return fAddRadii.size()   ; }
+  TClonesArray*          GetAdditionalJets(UInt_t i)      { return i < fAddJets.size() ? fAddJets[i] : 0; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
@@ -143,7 +159,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  protected:
 
   Int_t                  FindJets();
+  void                   FindAdditionalJets();
   void                   FillJetBranch();
+  void                   FillJetBranch(AliFJWrapper& wrapper, TClonesArray* jets, Double_t radius, Bool_t doUtilities);
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -173,6 +191,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   TObjArray             *fUtilities;              // jet utilities (gen subtractor, constituent subtractor etc.)
   Bool_t                 fTrackEfficiencyOnlyForEmbedding; // Apply aritificial tracking inefficiency only for embedded tracks
   Bool_t                 fLocked;                 // true if lock is set
+  std::vector<Int_t>     fAddJetAlgos;            // algorithms of the additional jet definitions
+  std::vector<Double_t>  fAddRadii;               // radii of the additional jet definitions
 
   TString                fJetsName;               //!name of jet collection
   Bool_t                 fIsInit;                 //!=true if already initialized
@@ -183,6 +203,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   TClonesArray          *fJets;                   //!jet collection
   AliFJWrapper           fFastJetWrapper;         //!fastjet wrapper
+  std::vector<TClonesArray*> fAddJets;            //!jet collections of the additional jet definitions
+  std::vector<AliFJWrapper*> fAddFastJetWrappers; //!fastjet wrappers of the additional jet definitions
 
   static const Int_t     fgkConstIndexShift;      //!contituent index shift
 
@@ -197,7 +219,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 24);
+  ClassDef(AliEmcalJetTask, 25);
   /// \endcond
 };
 #endif
@@ -123,6 +123,12 @@ class AliFJWrapper
   void SetMinJetPt(Double_t MinPt) {fMinJetPt=MinPt;}
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fUseMaxDelR = kTRUE; fMaxDelR = r;}
+  // cluster without ghosts (FastJet 3 only): all jet areas are 0 and the constituents are the input vectors only
+  void SetNoGhosts(Bool_t b = kTRUE)    { fNoGhosts = b; }
+  // state of the ghost random generator of the area spec of the last Run(), before the ghosts were placed
+  const std::vector<int>& GetGhostRandomStatus() const { return fGhostRandomStatus; }
+  // start the ghost random generator of the area spec of the following Run() calls from this state
+  void SetGhostRandomStatus(const std::vector<int>& status) { fFixedGhostRandomStatus = status; }
 
  protected:
   TString                                fName;               //!
@@ -174,6 +180,9 @@ class AliFJWrapper
   Bool_t                                 fEventSub;
   Bool_t                                 fUseMaxDelR;
   Double_t                               fMaxDelR;
+  Bool_t                                 fNoGhosts;           //!
+  std::vector<int>                       fGhostRandomStatus;  //!
+  std::vector<int>                       fFixedGhostRandomStatus; //!
 #ifdef FASTJET_VERSION
   fastjet::JetMedianBackgroundEstimator   *fBkrdEstimator;    //!
   //from contrib package
@@ -226,6 +235,27 @@ class AliFJWrapper
 
 namespace fj = fastjet;
 
+#ifdef FASTJET_VERSION
+//_________________________________________________________________________________________________
+class AliFJNoGhostSelector : public fj::SelectorWorker
+{
+  // Rejects all ghosts. The rapidity extent is the one of SelectorAbsRapMax(maxrap),
+  // as required for the placement of the ghosts by fj::GhostedAreaSpec.
+
+ public:
+  AliFJNoGhostSelector(Double_t maxrap) : fMaxRap(maxrap) {}
+
+  virtual bool pass(const fj::PseudoJet&) const { return false; }
+  virtual std::string description() const { return "no ghosts"; }
+  virtual void get_rapidity_extent(double& rapmin, double& rapmax) const { rapmin = -fMaxRap; rapmax = fMaxRap; }
+  virtual bool is_geometric() const { return true; }
+  virtual fj::SelectorWorker* copy() { return new AliFJNoGhostSelector(*this); }
+
+ private:
+  Double_t fMaxRap;
+};
+#endif
+
 //_________________________________________________________________________________________________
 AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   :
@@ -270,6 +300,9 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fEventSub          (kFALSE)
   , fUseMaxDelR        (kFALSE)
   , fMaxDelR           (0.4)
+  , fNoGhosts          (kFALSE)
+  , fGhostRandomStatus ( )
+  , fFixedGhostRandomStatus ( )
 #ifdef FASTJET_VERSION
   , fBkrdEstimator     (0)
   , fGenSubtractor     (0)
@@ -359,6 +392,7 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fUseExternalBkg   = wrapper.fUseExternalBkg;
   fRho              = wrapper.fRho;
   fRhom             = wrapper.fRhom;
+  fNoGhosts         = wrapper.fNoGhosts;
 }
 
 //_________________________________________________________________________________________________
@@ -663,6 +697,19 @@ Int_t AliFJWrapper::Run()
     fVorAreaSpec = new fj::VoronoiAreaSpec(1.);
     fAreaDef     = new fj::AreaDefinition(*fVorAreaSpec);
   } else {
+#ifdef FASTJET_VERSION
+    if (fNoGhosts) {
+      fGhostedAreaSpec = new fj::GhostedAreaSpec(fj::Selector(new AliFJNoGhostSelector(fMaxRap)),
+                                                 fNGhostRepeats,
+                                                 fGhostArea,
+                                                 fGridScatter,
+                                                 fKtScatter,
+                                                 fMeanGhostKt);
+    }
+    else
+#else
+    if (fNoGhosts) AliWarning("Clustering without ghosts requires FastJet 3, ghosts are placed in the full acceptance");
+#endif
     fGhostedAreaSpec = new fj::GhostedAreaSpec(fMaxRap,
                                                fNGhostRepeats,
                                                fGhostArea,
@@ -670,6 +717,10 @@ Int_t AliFJWrapper::Run()
                                                fKtScatter,
                                                fMeanGhostKt);
 
+    // set and record the state of the ghost generator on the spec that is passed to the
+    // clustering, before the area definition copies it
+    if (!fFixedGhostRandomStatus.empty()) fGhostedAreaSpec->set_random_status(fFixedGhostRandomStatus);
+    fGhostedAreaSpec->get_random_status(fGhostRandomStatus);
     fAreaDef = new fj::AreaDefinition(*fGhostedAreaSpec, fAreaType);
   }
 
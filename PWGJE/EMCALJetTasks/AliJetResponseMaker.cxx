@@ -19,6 +19,8 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
@@ -45,6 +47,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fUseFastMatching(kTRUE),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -134,6 +137,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar1(0),
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
+  fUseFastMatching(kTRUE),
   fMinJetMCPt(1),
   fEmbeddingQA(),
   fHistoType(0),
@@ -1426,22 +1430,155 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  // The fast matching requires that resetting a jet1 does not affect jets already matched as jet2
+  if (!fUseFastMatching || jets1->GetArray() == jets2->GetArray() ||
+      (fMatching == kSameCollections && fUseCellsToMatch && fCaloCells)) {
+    jets2->ResetCurrentID();
+    while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+
+    jets1->ResetCurrentID();
+    while ((jet1 = jets1->GetNextJet())) {
+      jet1->ResetMatching();
+
+      if (jet1->MCPt() < fMinJetMCPt) continue;
+
+      jets2->ResetCurrentID();
+      while ((jet2 = jets2->GetNextJet())) {
+        SetMatchingLevel(jet1, jet2, fMatching);
+      } // jet2 loop
+    } // jet1 loop
+    return;
+  }
+
+  // Same closest and second closest jets as the loop over all pairs above,
+  // for the jets in the same order
+  std::vector<AliEmcalJet*> selJets1, selJets2;
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    selJets2.push_back(jet2);
+  }
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
     jet1->ResetMatching();
-
     if (jet1->MCPt() < fMinJetMCPt) continue;
+    selJets1.push_back(jet1);
+  }
 
-    jets2->ResetCurrentID();
-    while ((jet2 = jets2->GetNextJet())) {
-      SetMatchingLevel(jet1, jet2, fMatching);
+  if (fMatching == kGeometrical && DoGeometricalJetLoop(selJets1, selJets2)) return;
+
+  JetConstituentIndex index;
+  for (UInt_t ijet1 = 0; ijet1 < selJets1.size(); ijet1++) {
+    jet1 = selJets1[ijet1];
+    if (fMatching == kMCLabel) BuildMCLabelIndex(jet1, index);
+    else if (fMatching == kSameCollections) BuildSameCollectionsIndex(jet1, index);
+
+    for (UInt_t ijet2 = 0; ijet2 < selJets2.size(); ijet2++) {
+      jet2 = selJets2[ijet2];
+      Double_t d1 = -1;
+      Double_t d2 = -1;
+      switch (fMatching) {
+      case kGeometrical:
+        GetGeometricalMatchingLevel(jet1,jet2,d1);
+        d2 = d1;
+        break;
+      case kMCLabel:
+        GetMCLabelMatchingLevel(jet1,jet2,index,d1,d2);
+        break;
+      case kSameCollections:
+        GetSameCollectionsMatchingLevel(jet1,jet2,index,d1,d2);
+        break;
+      default:
+        ;
+      }
+      UpdateClosestJets(jet1, jet2, d1, d2);
     } // jet2 loop
   } // jet1 loop
 }
 
+//________________________________________________________________________
+Bool_t AliJetResponseMaker::DoGeometricalJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2) const
+{
+  // Geometrical matching with jets sorted in eta. For each jet the jets of the other
+  // collection are visited in order of increasing |delta eta|, until |delta eta| exceeds
+  // the distance of the second closest jet found so far: the distance is never smaller than
+  // |delta eta|, so none of the remaining jets can be among the two closest ones.
+  // Returns kFALSE (nothing done) if any jet has a non-finite position.
+
+  std::vector<Double_t> eta1(jets1.size()), eta2(jets2.size());
+  for (UInt_t i = 0; i < jets1.size(); i++) {
+    eta1[i] = jets1[i]->Eta();
+    if (!TMath::Finite(eta1[i]) || !TMath::Finite(jets1[i]->Phi())) return kFALSE;
+  }
+  for (UInt_t i = 0; i < jets2.size(); i++) {
+    eta2[i] = jets2[i]->Eta();
+    if (!TMath::Finite(eta2[i]) || !TMath::Finite(jets2[i]->Phi())) return kFALSE;
+  }
+
+  std::vector<Int_t> order1(jets1.size()), order2(jets2.size());
+  for (UInt_t i = 0; i < order1.size(); i++) order1[i] = i;
+  for (UInt_t i = 0; i < order2.size(); i++) order2[i] = i;
+  std::sort(order1.begin(), order1.end(), [&eta1](Int_t a, Int_t b) { return eta1[a] < eta1[b] || (eta1[a] == eta1[b] && a < b); });
+  std::sort(order2.begin(), order2.end(), [&eta2](Int_t a, Int_t b) { return eta2[a] < eta2[b] || (eta2[a] == eta2[b] && a < b); });
+
+  std::vector<Double_t> sortedEta1(jets1.size()), sortedEta2(jets2.size());
+  for (UInt_t i = 0; i < order1.size(); i++) sortedEta1[i] = eta1[order1[i]];
+  for (UInt_t i = 0; i < order2.size(); i++) sortedEta2[i] = eta2[order2[i]];
+
+  for (UInt_t i = 0; i < jets1.size(); i++) FindClosestJets(jets1[i], kTRUE, jets2, sortedEta2, order2);
+  for (UInt_t i = 0; i < jets2.size(); i++) FindClosestJets(jets2[i], kFALSE, jets1, sortedEta1, order1);
+
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::FindClosestJets(AliEmcalJet *jet, Bool_t isJet1, const std::vector<AliEmcalJet*> &partners,
+                                          const std::vector<Double_t> &partnerEta, const std::vector<Int_t> &partnerOrder) const
+{
+  // Find the closest and second closest jets among partners (sorted in eta with partnerEta and partnerOrder).
+  // As in SetMatchingLevel(), jets at the same distance are ranked by their position in the container
+  // and the distance is always calculated as jet1->DeltaR(jet2).
+
+  const Double_t eta = jet->Eta();
+  Int_t closest[2] = {-1, -1};
+  Double_t dist[2] = {jet->ClosestJetDistance(), jet->SecondClosestJetDistance()};
+
+  Int_t hi = std::lower_bound(partnerEta.begin(), partnerEta.end(), eta) - partnerEta.begin();
+  Int_t lo = hi - 1;
+  const Int_t n = partnerEta.size();
+  while (lo >= 0 || hi < n) {
+    Int_t pos = -1;
+    if (lo < 0) pos = hi++;
+    else if (hi >= n) pos = lo--;
+    else if (partnerEta[hi] - eta < eta - partnerEta[lo]) pos = hi++;
+    else pos = lo--;
+
+    // Lower bound of the distance, computed as in AliEmcalJet::DeltaR()
+    Double_t dEta = eta - partnerEta[pos];
+    if (closest[1] >= 0 && TMath::Sqrt(dEta * dEta) > dist[1]) break;
+
+    const Int_t ipartner = partnerOrder[pos];
+    AliEmcalJet *partner = partners[ipartner];
+    Double_t d = isJet1 ? jet->DeltaR(partner) : partner->DeltaR(jet);
+    if (!(d >= 0)) continue;
+
+    if (d < dist[0] || (d == dist[0] && closest[0] >= 0 && ipartner < closest[0])) {
+      closest[1] = closest[0];
+      dist[1] = dist[0];
+      closest[0] = ipartner;
+      dist[0] = d;
+    }
+    else if (d < dist[1] || (d == dist[1] && closest[1] >= 0 && ipartner < closest[1])) {
+      closest[1] = ipartner;
+      dist[1] = d;
+    }
+  }
+
+  if (closest[0] >= 0) jet->SetClosestJet(partners[closest[0]], dist[0]);
+  if (closest[1] >= 0) jet->SetSecondClosestJet(partners[closest[1]], dist[1]);
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -1865,6 +2002,263 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
     d2 = -1;
 }
 
+//________________________________________________________________________
+void AliJetResponseMaker::BuildMCLabelIndex(AliEmcalJet *jet1, JetConstituentIndex &index) const
+{
+  // Index the constituents of jet1 by the position of their MC particle in the jet2 particle container,
+  // so that GetMCLabelMatchingLevel() does not loop over all jet1 constituents for each jet2 track.
+  // The constituents without MC particle are removed from the jet1 pt as in GetMCLabelMatchingLevel().
+
+  index.fMatched.clear();
+  index.fTracks.clear();
+  index.fClusters.clear();
+  index.fD1 = -1;
+  index.fTotalPt1 = -1;
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
+
+  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+
+  Double_t d1 = jet1->Pt();
+  Double_t totalPt1 = d1;
+
+  // remove completely tracks that are not MC particles (label == 0)
+  if (tracks1 && tracks1->GetArray()) {
+    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+      AliVParticle *track = jet1->Track(iTrack);
+      if (!track) continue;
+      Int_t MClabel = TMath::Abs(track->GetLabel());
+      MClabel -= fMCLabelShift;
+      if (MClabel != 0) continue;
+      totalPt1 -= track->Pt();
+      d1 -= track->Pt();
+    }
+  }
+
+  MatchedConstituent constituent;
+
+  // tracks associated with MC particles
+  for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+    AliVParticle *track = jet1->Track(iTrack);
+    if (!track) {
+      AliWarning(Form("Could not find track %d!", iTrack));
+      continue;
+    }
+    Int_t MClabel = TMath::Abs(track->GetLabel());
+    MClabel -= fMCLabelShift;
+    if (MClabel <= 0) continue;
+    Int_t index2 = tracks2->GetIndexFromLabel(MClabel);
+    if (index2 < 0) continue;
+    constituent.fPt1 = track->Pt();
+    constituent.fFrac2 = 1;
+    index.fMatched[index2].push_back(constituent);
+  }
+
+  // clusters (or cells) associated with MC particles, after the tracks as in GetMCLabelMatchingLevel()
+  for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+    AliVCluster *clus = jet1->Cluster(iClus);
+    if (!clus) {
+      AliWarning(Form("Could not find cluster %d!", iClus));
+      continue;
+    }
+    AliTLorentzVector part;
+    clus->GetMomentum(part, fVertex);
+
+    if (fUseCellsToMatch && fCaloCells) {
+      for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+        Int_t cellId = clus->GetCellAbsId(iCell);
+        Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
+
+        Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
+        MClabel -= fMCLabelShift;
+        if (MClabel == 0) {
+          totalPt1 -= part.Pt() * cellFrac;
+          d1 -= part.Pt() * cellFrac;
+          continue;
+        }
+        if (MClabel < 0) continue;
+        Int_t index2 = tracks2->GetIndexFromLabel(MClabel);
+        if (index2 < 0) continue;
+        constituent.fPt1 = part.Pt() * cellFrac;
+        constituent.fFrac2 = cellFrac;
+        index.fMatched[index2].push_back(constituent);
+      }
+    }
+    else {
+      Int_t MClabel = TMath::Abs(clus->GetLabel());
+      MClabel -= fMCLabelShift;
+      if (MClabel == 0) {
+        totalPt1 -= part.Pt();
+        d1 -= part.Pt();
+        continue;
+      }
+      if (MClabel < 0) continue;
+      Int_t index2 = tracks2->GetIndexFromLabel(MClabel);
+      if (index2 < 0) continue;
+      constituent.fPt1 = part.Pt();
+      constituent.fFrac2 = 1;
+      index.fMatched[index2].push_back(constituent);
+    }
+  }
+
+  index.fD1 = d1;
+  index.fTotalPt1 = totalPt1;
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, const JetConstituentIndex &index, Double_t &d1, Double_t &d2) const
+{
+  // Same as GetMCLabelMatchingLevel(jet1, jet2, d1, d2), with the constituents of jet1
+  // taken from the index built by BuildMCLabelIndex().
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
+
+  d1 = index.fD1;
+  d2 = jet2->Pt();
+  Double_t totalPt1 = index.fTotalPt1;
+
+  for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
+    std::unordered_map<Int_t, std::vector<MatchedConstituent> >::const_iterator it = index.fMatched.find(jet2->TrackAt(iTrack2));
+    if (it == index.fMatched.end()) continue;
+
+    const std::vector<MatchedConstituent> &constituents = it->second;
+    for (UInt_t i = 0; i < constituents.size(); i++) {
+      // found common particle
+      d1 -= constituents[i].fPt1;
+      if (i == 0) {
+        AliVParticle *MCpart = jet2->Track(iTrack2);
+        d2 -= MCpart->Pt() * constituents[i].fFrac2;
+      }
+    }
+  }
+
+  if (d1 < 0)
+    d1 = 0;
+
+  if (d2 < 0)
+    d2 = 0;
+
+  if (totalPt1 < 1)
+    d1 = -1;
+  else
+    d1 /= totalPt1;
+
+  if (jet2->Pt() < 1)
+    d2 = -1;
+  else
+    d2 /= jet2->Pt();
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::BuildSameCollectionsIndex(AliEmcalJet *jet1, JetConstituentIndex &index) const
+{
+  // Index the track and cluster constituents of jet1 by their position in the container.
+  // Only the first occurrence is kept, as the loop in GetSameCollectionsMatchingLevel() stops there.
+
+  index.fMatched.clear();
+  index.fTracks.clear();
+  index.fClusters.clear();
+
+  for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
+    index.fTracks.insert(std::make_pair(jet1->TrackAt(iTrack1), iTrack1));
+  }
+  for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
+    index.fClusters.insert(std::make_pair(jet1->ClusterAt(iClus1), iClus1));
+  }
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, const JetConstituentIndex &index, Double_t &d1, Double_t &d2) const
+{
+  // Same as GetSameCollectionsMatchingLevel(jet1, jet2, d1, d2) when clusters (not cells) are
+  // used, with the constituents of jet1 taken from the index built by BuildSameCollectionsIndex().
+
+  AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+  AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
+
+  if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
+
+  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+  AliClusterContainer  *clusters1 = jets1->GetClusterContainer();
+  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+  AliClusterContainer  *clusters2 = jets2->GetClusterContainer();
+
+  d1 = jet1->Pt();
+  d2 = jet2->Pt();
+
+  if (tracks1 && tracks2) {
+    for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
+      Int_t index2 = jet2->TrackAt(iTrack2);
+      std::unordered_map<Int_t, Int_t>::const_iterator it = index.fTracks.find(index2);
+      if (it == index.fTracks.end()) continue;
+
+      // found common particle
+      AliVParticle *part1 = jet1->Track(it->second);
+      if (!part1) {
+        AliWarning(Form("Could not find track %d!", index2));
+        continue;
+      }
+      AliVParticle *part2 = jet2->Track(iTrack2);
+      if (!part2) {
+        AliWarning(Form("Could not find track %d!", index2));
+        continue;
+      }
+
+      d1 -= part1->Pt();
+      d2 -= part2->Pt();
+    }
+  }
+
+  if (clusters1 && clusters2) {
+    for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) {
+      Int_t index2 = jet2->ClusterAt(iClus2);
+      std::unordered_map<Int_t, Int_t>::const_iterator it = index.fClusters.find(index2);
+      if (it == index.fClusters.end()) continue;
+
+      // found common particle
+      AliVCluster *clus1 = jet1->Cluster(it->second);
+      if (!clus1) {
+        AliWarning(Form("Could not find cluster %d!", index2));
+        continue;
+      }
+      AliVCluster *clus2 =  jet2->Cluster(iClus2);
+      if (!clus2) {
+        AliWarning(Form("Could not find cluster %d!", index2));
+        continue;
+      }
+      TLorentzVector part1, part2;
+      clus1->GetMomentum(part1, fVertex);
+      clus2->GetMomentum(part2, fVertex);
+
+      d1 -= part1.Pt();
+      d2 -= part2.Pt();
+    }
+  }
+
+  if (d1 < 0)
+    d1 = 0;
+
+  if (d2 < 0)
+    d2 = 0;
+
+  if (jet1->Pt() > 0)
+    d1 /= jet1->Pt();
+  else
+    d1 = -1;
+
+  if (jet2->Pt() > 0)
+    d2 /= jet2->Pt();
+  else
+    d2 = -1;
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching) 
 {
@@ -1886,6 +2280,12 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
+  UpdateClosestJets(jet1, jet2, d1, d2);
+}
+
+//________________________________________________________________________
+void AliJetResponseMaker::UpdateClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2) const
+{
   if (d1 >= 0) {
 
     if (d1 < jet1->ClosestJetDistance()) {
@@ -24,6 +24,11 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <vector>
+#include <unordered_map>
+#endif
+
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
@@ -46,6 +51,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetMatching(MatchingType t, Double_t p1=1, Double_t p2=1)       { fMatching = t; fMatchingPar1 = p1; fMatchingPar2 = p2; }
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
+  void                        SetUseFastMatching(Bool_t b)                                    { fUseFastMatching   = b         ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
@@ -75,11 +81,38 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        AllocateTH2();
   void                        AllocateTHnSparse();
   Double_t                    GetRelativeEPAngle(Double_t jetAngle, Double_t epAngle) const;
+  void                        UpdateClosestJets(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t d1, Double_t d2) const;
+
+#if !(defined(__CINT__) || defined(__MAKECINT__))
+  // Constituent of jet1 associated with a particle of the jet2 particle container (MC label matching)
+  struct MatchedConstituent {
+    Double_t                  fPt1;                                    // pt removed from jet1 (track or cluster pt, or cell fraction of the cluster pt)
+    Double_t                  fFrac2;                                  // fraction of the particle pt removed from jet2 (1 for tracks and clusters)
+  };
+
+  // Constituent index of a jet1, built once and used for all jet2 candidates
+  struct JetConstituentIndex {
+    Double_t                  fD1;                                     // jet1 pt after removing the constituents without MC label
+    Double_t                  fTotalPt1;                               // cleaned jet1 pt used for the normalization
+    std::unordered_map<Int_t, std::vector<MatchedConstituent> > fMatched; // constituents by index in the jet2 particle container, in the order of the pair loop
+    std::unordered_map<Int_t, Int_t> fTracks;                          // first position in jet1 of each track index (same collections)
+    std::unordered_map<Int_t, Int_t> fClusters;                        // first position in jet1 of each cluster index (same collections)
+  };
+
+  Bool_t                      DoGeometricalJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2) const;
+  void                        FindClosestJets(AliEmcalJet *jet, Bool_t isJet1, const std::vector<AliEmcalJet*> &partners,
+                                              const std::vector<Double_t> &partnerEta, const std::vector<Int_t> &partnerOrder) const;
+  void                        BuildMCLabelIndex(AliEmcalJet *jet1, JetConstituentIndex &index) const;
+  void                        BuildSameCollectionsIndex(AliEmcalJet *jet1, JetConstituentIndex &index) const;
+  void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, const JetConstituentIndex &index, Double_t &d1, Double_t &d2) const;
+  void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, const JetConstituentIndex &index, Double_t &d1, Double_t &d2) const;
+#endif
 
   MatchingType                fMatching;                               // matching type
   Double_t                    fMatchingPar1;                           // matching parameter for jet1-jet2 matching
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
+  Bool_t                      fUseFastMatching;                        // eta sweep (geometrical) and constituent indices (MC label, same collections) instead of the loop over all pairs
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
@@ -174,6 +207,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
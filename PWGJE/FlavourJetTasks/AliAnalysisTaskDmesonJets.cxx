@@ -13,6 +13,10 @@
 * provided "as is" without express or implied warranty.                  *
 **************************************************************************/
 
+// C++
+#include <algorithm>
+#include <vector>
+
 // Root
 #include <TClonesArray.h>
 #include <TDatabasePDG.h>
@@ -747,6 +751,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine() :
   fMaxPt(100),
   fRandomGen(0),
   fTrackEfficiency(0),
+  fReclusterNeighbourhood(kFALSE),
   fDataSlotNumber(-1),
   fTree(0),
   fCurrentDmesonJetInfo(0),
@@ -791,6 +796,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(ECandidateType_t type,
   fMaxPt(100),
   fRandomGen(0),
   fTrackEfficiency(0),
+  fReclusterNeighbourhood(kFALSE),
   fDataSlotNumber(-1),
   fTree(0),
   fCurrentDmesonJetInfo(0),
@@ -832,6 +838,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(const AliAnalysisTaskD
   fMaxPt(source.fMaxPt),
   fRandomGen(source.fRandomGen),
   fTrackEfficiency(source.fTrackEfficiency),
+  fReclusterNeighbourhood(source.fReclusterNeighbourhood),
   fDataSlotNumber(-1),
   fTree(0),
   fCurrentDmesonJetInfo(0),
@@ -1476,6 +1483,8 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Pron
     }
   }
 
+  if (fReclusterNeighbourhood) SelectNeighbourhood(jetDef.fRadius);
+
   // run jet finder
   fFastJetWrapper->Run();
 
@@ -1544,6 +1553,89 @@ void AliAnalysisTaskDmesonJets::AnalysisEngine::AddInputVectors(AliEmcalContaine
   }
 }
 
+/// Restricts the input of the jet finder to the neighbourhood of the D meson candidate
+/// (the input vector with user index 0, always added first).
+///
+/// Particles are separated from the candidate if they are on the other side of a gap
+/// larger than the jet radius in rapidity or (cyclically) in azimuth; this is repeated
+/// on the remaining particles until nothing changes. Since two objects are merged only
+/// if \f$\Delta R < R\f$ and a recombined object lies between the objects it is made of,
+/// no algorithm of the kt family can ever merge a separated particle with the selected
+/// ones: the D meson jet is found with the same constituents as from the full event.
+/// This only holds without ghosts, which fill the acceptance without any gap, therefore
+/// it is used only if the jet area is not calculated (see SetJetArea()).
+///
+/// \param r Jet radius
+void AliAnalysisTaskDmesonJets::AnalysisEngine::SelectNeighbourhood(Double_t r)
+{
+  const std::vector<fastjet::PseudoJet> inputs(fFastJetWrapper->GetInputVectors());
+  const UInt_t n = inputs.size();
+  if (n == 0) return;
+
+  // Small margin for the rounding of the rapidity and azimuth of recombined objects
+  const Double_t minGap = r * (1. + 1e-6);
+
+  std::vector<Double_t> rap(n), phi(n);
+  std::vector<UInt_t> sel(n);
+  for (UInt_t i = 0; i < n; i++) {
+    rap[i] = inputs[i].rap();
+    phi[i] = inputs[i].phi();
+    sel[i] = i;
+  }
+  auto byRap = [&rap](UInt_t a, UInt_t b) { return rap[a] < rap[b] || (rap[a] == rap[b] && a < b); };
+  auto byPhi = [&phi](UInt_t a, UInt_t b) { return phi[a] < phi[b] || (phi[a] == phi[b] && a < b); };
+
+  Bool_t changed = kTRUE;
+  while (changed && sel.size() > 1) {
+    changed = kFALSE;
+
+    // Rapidity: keep the particles connected to the candidate by gaps not larger than R
+    std::sort(sel.begin(), sel.end(), byRap);
+    UInt_t m = sel.size();
+    UInt_t pos = std::find(sel.begin(), sel.end(), 0u) - sel.begin();
+    UInt_t first = pos, last = pos;
+    while (first > 0 && rap[sel[first]] - rap[sel[first - 1]] <= minGap) first--;
+    while (last + 1 < m && rap[sel[last + 1]] - rap[sel[last]] <= minGap) last++;
+    if (last - first + 1 < m) {
+      sel = std::vector<UInt_t>(sel.begin() + first, sel.begin() + last + 1);
+      changed = kTRUE;
+    }
+
+    // Azimuth: the same cyclically, nothing is separated with less than two large gaps
+    m = sel.size();
+    if (m < 2) break;
+    std::sort(sel.begin(), sel.end(), byPhi);
+    std::vector<Double_t> gaps(m);
+    UInt_t nLargeGaps = 0;
+    for (UInt_t i = 0; i < m; i++) {
+      gaps[i] = phi[sel[(i + 1) % m]] - phi[sel[i]];
+      if (i == m - 1) gaps[i] += TMath::TwoPi();
+      if (gaps[i] > minGap) nLargeGaps++;
+    }
+    if (nLargeGaps < 2) continue;
+    pos = std::find(sel.begin(), sel.end(), 0u) - sel.begin();
+    first = pos;
+    last = pos;
+    while (gaps[(first + m - 1) % m] <= minGap) first = (first + m - 1) % m;
+    while (gaps[last] <= minGap) last = (last + 1) % m;
+    std::vector<UInt_t> block;
+    for (UInt_t i = first; ; i = (i + 1) % m) {
+      block.push_back(sel[i]);
+      if (i == last) break;
+    }
+    sel.swap(block);
+    changed = kTRUE;
+  }
+
+  // The input vectors are added again in their original order
+  std::vector<Bool_t> keep(n, kFALSE);
+  for (UInt_t i = 0; i < sel.size(); i++) keep[sel[i]] = kTRUE;
+  fFastJetWrapper->Clear();
+  for (UInt_t i = 0; i < n; i++) {
+    if (keep[i]) fFastJetWrapper->AddInputVector(inputs[i], inputs[i].user_index());
+  }
+}
+
 /// Run a particle level analysis
 void AliAnalysisTaskDmesonJets::AnalysisEngine::RunParticleLevelAnalysis()
 {
@@ -2132,6 +2224,8 @@ AliAnalysisTaskDmesonJets::AliAnalysisTaskDmesonJets() :
   fApplyKinematicCuts(kTRUE),
   fNOutputTrees(0),
   fTrackEfficiency(0),
+  fJetArea(kTRUE),
+  fReclusterNeighbourhood(kFALSE),
   fMCContainer(0),
   fAodEvent(0),
   fFastJetWrapper(0)
@@ -2151,6 +2245,8 @@ AliAnalysisTaskDmesonJets::AliAnalysisTaskDmesonJets(const char* name, Int_t nOu
   fApplyKinematicCuts(kTRUE),
   fNOutputTrees(nOutputTrees),
   fTrackEfficiency(0),
+  fJetArea(kTRUE),
+  fReclusterNeighbourhood(kFALSE),
   fMCContainer(0),
   fAodEvent(0),
   fFastJetWrapper(0)
@@ -2507,6 +2603,12 @@ void AliAnalysisTaskDmesonJets::ExecOnce()
   // TODO: make this settable
   fFastJetWrapper->SetAreaType(fastjet::active_area_explicit_ghosts);
   fFastJetWrapper->SetGhostArea(0.005);
+  if (!fJetArea) fFastJetWrapper->SetNoGhosts();
+
+  if (fReclusterNeighbourhood && fJetArea) {
+    AliWarning(Form("The neighbourhood of the D meson candidates can only be reclustered without jet area (Task '%s'). All particles are clustered.", GetName()));
+    fReclusterNeighbourhood = kFALSE;
+  }
 
   if (!fAodEvent) {
      AliError(Form("This task need an AOD event (Task '%s'). Expect troubles...", GetName()));
@@ -2526,6 +2628,7 @@ void AliAnalysisTaskDmesonJets::ExecOnce()
     params.fAodEvent = fAodEvent;
     params.fFastJetWrapper = fFastJetWrapper;
     params.fTrackEfficiency = fTrackEfficiency;
+    params.fReclusterNeighbourhood = fReclusterNeighbourhood;
     params.fRandomGen = rnd;
 
     for (auto &jetdef: params.fJetDefinitions) {
@@ -446,6 +446,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Bool_t FillTree(Bool_t applyKinCuts);
 
     void SetTrackEfficiency(Double_t t)      { fTrackEfficiency       = t; }
+    void SetReclusterNeighbourhood(Bool_t b) { fReclusterNeighbourhood = b; }
     void AssignDataSlot(Int_t n)             { fDataSlotNumber        = n; }
     Int_t GetDataSlotNumber() const          { return fDataSlotNumber    ; }
 
@@ -490,6 +491,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Float_t                            fMaxPt                 ; ///<  Histogram pt limit
     TRandom                           *fRandomGen             ; //!<! Random number generator
     Double_t                           fTrackEfficiency       ; //!<! Artificial tracking inefficiency (0...1) -> set automatically at ExecOnce by AliAnalysisTaskDmesonJets
+    Bool_t                             fReclusterNeighbourhood; //!<! Recluster only the neighbourhood of the D meson candidate -> set automatically at ExecOnce by AliAnalysisTaskDmesonJets
     Int_t                              fDataSlotNumber        ; //!<! Data slot where the tree output is posted
     TTree                             *fTree                  ; //!<! Output tree
     AliDmesonInfoSummary              *fCurrentDmesonJetInfo  ; //!<! Current D meson jet info
@@ -508,6 +510,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   private:
 
     void                AddInputVectors(AliEmcalContainer* cont, Int_t offset, TH2* rejectHist=0, Double_t eff=0.);
+    void                SelectNeighbourhood(Double_t r);
     void                SetCandidateProperties(Double_t range);
     AliAODMCParticle*   MatchToMC() const;
     void                RunDetectorLevelAnalysis();
@@ -519,7 +522,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Bool_t              FindJet(AliAODRecoDecayHF2Prong* Dcand, AliDmesonJetInfo& DmesonJet, AliHFJetDefinition& jetDef);
 
     /// \cond CLASSIMP
-    ClassDef(AnalysisEngine, 2);
+    ClassDef(AnalysisEngine, 3);
     /// \endcond
   };
 
@@ -544,6 +547,8 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   void SetApplyKinematicCuts(Bool_t b)            { fApplyKinematicCuts = b ; }
   void SetOutputType(EOutputType_t b)             { SetOutputTypeInternal(b); }
   void SetTrackEfficiency(Double_t t)             { fTrackEfficiency    = t ; }
+  void SetJetArea(Bool_t b)                       { fJetArea            = b ; }
+  void SetReclusterNeighbourhood(Bool_t b = kTRUE){ fReclusterNeighbourhood = b ; }
 
   virtual void         UserCreateOutputObjects();
   virtual void         ExecOnce();
@@ -573,6 +578,8 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   Bool_t               fApplyKinematicCuts        ; ///<  Apply jet kinematic cuts
   Int_t                fNOutputTrees              ; ///<  Maximum number of output trees
   Double_t             fTrackEfficiency           ; ///<  Artificial tracking inefficiency (0...1)
+  Bool_t               fJetArea                   ; ///<  Calculate the jet area (with ghosts), otherwise the area and rho-corrected pt are not available
+  Bool_t               fReclusterNeighbourhood    ; ///<  Recluster only the neighbourhood of each D meson candidate (same tagged jets, faster), requires fJetArea = kFALSE
   AliHFAODMCParticleContainer* fMCContainer       ; //!<! MC particle container
   AliAODEvent         *fAodEvent                  ; //!<! AOD event
   AliFJWrapper        *fFastJetWrapper            ; //!<! Fastjet wrapper
@@ -583,7 +590,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   AliAnalysisTaskDmesonJets& operator=(const AliAnalysisTaskDmesonJets& source);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskDmesonJets, 7);
+  ClassDef(AliAnalysisTaskDmesonJets, 8);
   /// \endcond
 };
 
@@ -206,90 +206,114 @@ AliFMDCorrector::Correct(AliForwardUtil::Histos& hists,
   //    true on successs 
   //
   DGUARD(fDebug, 1, "Correct histograms of AliFMDCorrector");
-  AliForwardCorrectionManager& fcm = AliForwardCorrectionManager::Instance();
 
   UShort_t uvb = vtxbin;
   for (UShort_t d=1; d<=3; d++) { 
     UShort_t nr = (d == 1 ? 1 : 2);
     for (UShort_t q=0; q<nr; q++) { 
-      Char_t      r  = (q == 0 ? 'I' : 'O');
-      TH2D*       h  = hists.Get(d,r);
-      RingHistos* rh = GetRingHistos(d,r);
-
-      if (fUseSecondaryMap) {
-        TH2D*  bg = fcm.GetSecondaryMap()->GetCorrection(d, r, uvb);
-        if (!bg) {
-          AliWarning(Form("No secondary correction for FMDM%d%c "
-			  "in vertex bin %d", d, r, uvb));
-          continue;
-        }
-        // Divide by primary/total ratio
-	DivideMap(h, bg, false);
-      }
-      if (fUseVertexBias) {
-        TH2D*  ef = fcm.GetVertexBias()->GetCorrection(r, uvb);
-        if (!ef) {
-          AliWarning(Form("No event %s vertex bias correction in vertex bin %d",
-                          (r == 'I' || r == 'i' ? "inner" : "outer"), uvb));
-          continue;
-        }
-        // Divide by the event selection efficiency
-	DivideMap(h, ef, false);
-      }
-      if (fUseAcceptance) {
-        TH2D*  ac = fcm.GetAcceptance()->GetCorrection(d, r, uvb);
-        if (!ac) {
-          AliWarning(Form("No acceptance correction for FMD%d%c in "
-			  "vertex bin %d", d, r, uvb));
-          continue;
-        }
-	// Fill overflow bin with ones 
-	for (Int_t i = 1; i <= h->GetNbinsX(); i++) 
-	  h->SetBinContent(i, h->GetNbinsY()+1, 1);
-
-        // Divide by the acceptance correction - 
-	DivideMap(h, ac, fcm.GetAcceptance()->HasOverflow());
-      }
+      Char_t r = (q == 0 ? 'I' : 'O');
+      if (!CorrectRing(hists, d, r, uvb)) return kFALSE;
+    }
+  }
+  
+  return kTRUE;
+}
 
-      if (fUseMergingEfficiency) {
-	if (!fcm.GetMergingEfficiency()) { 
-	  AliWarning("No merging efficiencies");
-	  continue;
-	}
-	TH1D* sf = fcm.GetMergingEfficiency()->GetCorrection(d,r,uvb);
-	if (!fcm.GetMergingEfficiency()->GetCorrection(d,r,uvb)) { 
-	  AliWarning(Form("No merging efficiency for FMD%d%c at vertex bin %d",
-			  d, r, uvb));
+//____________________________________________________________________
+Bool_t
+AliFMDCorrector::CorrectRing(AliForwardUtil::Histos& hists,
+			     UShort_t                d, 
+			     Char_t                  r, 
+			     UShort_t                uvb)
+{
+  // 
+  // Do the calculations for a single ring.  Called for each ring
+  // in turn by Correct.
+  // 
+  // Parameters:
+  //    hists    Cache of histograms 
+  //    d        Detector 
+  //    r        Ring 
+  //    uvb      Vertex bin 
+  // 
+  // Return:
+  //    true on successs 
+  //
+  AliForwardCorrectionManager& fcm = AliForwardCorrectionManager::Instance();
+  TH2D*       h  = hists.Get(d,r);
+  RingHistos* rh = GetRingHistos(d,r);
+
+  if (fUseSecondaryMap) {
+    TH2D*  bg = fcm.GetSecondaryMap()->GetCorrection(d, r, uvb);
+    if (!bg) {
+      AliWarning(Form("No secondary correction for FMDM%d%c "
+		      "in vertex bin %d", d, r, uvb));
+      return kTRUE;
+    }
+    // Divide by primary/total ratio
+    DivideMap(h, bg, false);
+  }
+  if (fUseVertexBias) {
+    TH2D*  ef = fcm.GetVertexBias()->GetCorrection(r, uvb);
+    if (!ef) {
+      AliWarning(Form("No event %s vertex bias correction in vertex bin %d",
+		      (r == 'I' || r == 'i' ? "inner" : "outer"), uvb));
+      return kTRUE;
+    }
+    // Divide by the event selection efficiency
+    DivideMap(h, ef, false);
+  }
+  if (fUseAcceptance) {
+    TH2D*  ac = fcm.GetAcceptance()->GetCorrection(d, r, uvb);
+    if (!ac) {
+      AliWarning(Form("No acceptance correction for FMD%d%c in "
+		      "vertex bin %d", d, r, uvb));
+      return kTRUE;
+    }
+    // Fill overflow bin with ones 
+    for (Int_t i = 1; i <= h->GetNbinsX(); i++) 
+      h->SetBinContent(i, h->GetNbinsY()+1, 1);
+
+    // Divide by the acceptance correction - 
+    DivideMap(h, ac, fcm.GetAcceptance()->HasOverflow());
+  }
+
+  if (fUseMergingEfficiency) {
+    if (!fcm.GetMergingEfficiency()) { 
+      AliWarning("No merging efficiencies");
+      return kTRUE;
+    }
+    TH1D* sf = fcm.GetMergingEfficiency()->GetCorrection(d,r,uvb);
+    if (!fcm.GetMergingEfficiency()->GetCorrection(d,r,uvb)) { 
+      AliWarning(Form("No merging efficiency for FMD%d%c at vertex bin %d",
+		      d, r, uvb));
+      return kTRUE;
+    }
+    
+  
+    for (Int_t ieta = 1; ieta <= h->GetNbinsX(); ieta++) {
+      Float_t c  = sf->GetBinContent(ieta);
+      Float_t ec = sf->GetBinError(ieta);
+		
+      for (Int_t iphi = 1; iphi <= h->GetNbinsY(); iphi++) { 
+	if (c == 0) {
+	  h->SetBinContent(ieta,iphi,0);
+	  h->SetBinError(ieta,iphi,0);
 	  continue;
 	}
-	
+
+	Double_t m  = h->GetBinContent(ieta, iphi) / c;
+	Double_t em = h->GetBinError(ieta, iphi);
       
-	for (Int_t ieta = 1; ieta <= h->GetNbinsX(); ieta++) {
-	  Float_t c  = sf->GetBinContent(ieta);
-	  Float_t ec = sf->GetBinError(ieta);
-	  	  
-	  for (Int_t iphi = 1; iphi <= h->GetNbinsY(); iphi++) { 
-	    if (c == 0) {
-	      h->SetBinContent(ieta,iphi,0);
-	      h->SetBinError(ieta,iphi,0);
-	      continue;
-	    }
-
-	    Double_t m  = h->GetBinContent(ieta, iphi) / c;
-	    Double_t em = h->GetBinError(ieta, iphi);
-	  
-	    Double_t e  = TMath::Sqrt(em * em + (m * ec) * (m * ec));
-	    
-	    h->SetBinContent(ieta,iphi,m);
-	    h->SetBinError(ieta,iphi,e);
-	  }
-	}
+	Double_t e  = TMath::Sqrt(em * em + (m * ec) * (m * ec));
+	
+	h->SetBinContent(ieta,iphi,m);
+	h->SetBinError(ieta,iphi,e);
       }
-      
-      rh->fDensity->Add(h);
     }
   }
   
+  rh->fDensity->Add(h);
   return kTRUE;
 }
 
@@ -91,6 +91,20 @@ public:
    * @return true on successs 
    */
   virtual Bool_t Correct(AliForwardUtil::Histos& hists, UShort_t vtxBin);
+  /**
+   * Do the calculations for a single ring 
+   * 
+   * @param hists    Cache of histograms 
+   * @param d        Detector 
+   * @param r        Ring 
+   * @param vtxBin   Vertex bin 
+   * 
+   * @return true on successs 
+   */
+  virtual Bool_t CorrectRing(AliForwardUtil::Histos& hists, 
+                             UShort_t                d, 
+                             Char_t                  r, 
+                             UShort_t                vtxBin);
   /** 
    * Scale the histograms to the total number of events 
    * 
@@ -374,7 +374,6 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   //    true on successs 
   DGUARD(fDebug, 1, "Calculate density in FMD density calculator");
 
-  TStopwatch timer;
   TStopwatch totalT;
   
   // First measurements of timing
@@ -385,269 +384,296 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
   //  Copy to cache       : fraction of sum  3.9%   of total  2.2%
   //  Poisson calculation : fraction of sum 18.7%   of total 10.6%
   //  Diagnostics         : fraction of sum  3.7%   of total  2.1%
-  Double_t nPartTime  = 0;
-  Double_t corrTime   = 0;
-  Double_t rePhiTime  = 0;
-  Double_t copyTime   = 0;
-  Double_t poissonTime= 0;
-  Double_t diagTime   = 0;
   // Double_t ipPhi      = TMath::ATan2(ip.Y(),ip.X());
   // Double_t ipR        = TMath::Sqrt(TMath::Power(ip.X(),2)+
   //                       TMath::Power(ip.Y(),2));
   START_TIMER(totalT);
   
-  Double_t etaCache[20*512]; // Same number of strips per ring 
-  Double_t phiCache[20*512]; // whether it is inner our outer. 
-  // We do not use TArrayD because we do not wont a bounds check 
-  // TArrayD etaCache(20*512); // Same number of strips per ring
-  // TArrayD phiCache(20*512); // whether it is inner our outer. 
+  Double_t timing[6] = { 0, 0, 0, 0, 0, 0 };
   
   // --- Loop over detectors -----------------------------------------
   for (UShort_t d=1; d<=3; d++) { 
     UShort_t nr = (d == 1 ? 1 : 2);
     for (UShort_t q=0; q<nr; q++) { 
-      Char_t      r = (q == 0 ? 'I' : 'O');
-      UShort_t    ns= (q == 0 ?  20 :  40);
-      UShort_t    nt= (q == 0 ? 512 : 256);
-      TH2D*       h = hists.Get(d,r);
-      RingHistos* rh= GetRingHistos(d,r);
-      if (!rh) { 
-	AliError(Form("No ring histogram found for FMD%d%c", d, r));
-	fRingHistos.ls();
+      Char_t r = (q == 0 ? 'I' : 'O');
+      if (!CalculateRing(fmd, hists, d, r, lowFlux, ip, timing)) 
 	return false;
-      }
-      // rh->fPoisson.SetObject(d,r,vtxbin,cent);
-      rh->fPoisson.Reset(0);
-      rh->fTotal->Reset();
-      rh->fGood->Reset();
-      // rh->ResetPoissonHistos(h, fEtaLumping, fPhiLumping);
-
-      // Reset our eta cache 
-      // for (Int_t i = 0; i < 20*512; i++) 
-      // etaCache[i] = phiCache[i] = AliESDFMD::kInvalidEta;
-      memset(etaCache, 0, sizeof(Double_t)*20*512);
-      memset(phiCache, 0, sizeof(Double_t)*20*512);
-      // etaCache.Reset(AliESDFMD::kInvalidEta);
-      // phiCache.Reset(AliESDFMD::kInvalidEta);
-
-      // --- Loop over sectors and strips ----------------------------
-      for (UShort_t s=0; s<ns; s++) { 
-	for (UShort_t t=0; t<nt; t++) {
-	  
-	  Float_t  mult   = fmd.Multiplicity(d,r,s,t);
-	  Double_t phi    = fmd.Phi(d,r,s,t) * TMath::DegToRad();
-	  Double_t eta    = fmd.Eta(d,r,s,t);
-	  Double_t oldPhi = phi;
-	  Double_t oldEta = eta;
-	  START_TIMER(timer);
-	  if (fRecalculatePhi) {
-	    // Correct for (x,y) off set of the interaction point 
-	    // AliForwardUtil::GetEtaPhiFromStrip(r,t,eta,phi,ip.X(),ip.Y());
-	    if (!AliForwardUtil::GetEtaPhi(d,r,s,t,ip,eta,phi) ||
-		TMath::Abs(eta) < 1) {
-	      AliWarningF("FMD%d%c[%2d,%3d] (%f,%f,%f) eta=%f phi=%f (%f)",
-			  d, r, s, t, ip.X(), ip.Y(), ip.Z(), eta,
-			  phi, oldEta);
-	      eta = oldEta;
-	      phi = oldPhi;
-	    }
-	    DMSG(fDebug, 10, "IP(x,y,z)=%f,%f,%f Eta=%f -> %f Phi=%f -> %f",
-		 ip.X(), ip.Y(), ip.Z(), oldEta, eta, oldPhi, phi);
-	  }
-	  ADD_TIMER(timer,rePhiTime);
-	  START_TIMER(timer);
-	  etaCache[s*nt+t] = eta;
-	  phiCache[s*nt+t] = phi;
-
-	  // --- Check this strip ------------------------------------
-	  rh->fTotal->Fill(eta);
-	  if (mult == AliESDFMD::kInvalidMult) { //  || mult > 20) {
-	    // Do not count invalid stuff 
-	    rh->fELoss->Fill(-1);
-	    // rh->fEvsN->Fill(mult,-1);
-	    // rh->fEvsM->Fill(mult,-1);
-	    continue;
-	  }
-	  if (mult > 20) 
-	    AliWarningF("Raw multiplicity of FMD%d%c[%02d,%03d] = %f > 20",
-			d, r, s, t, mult);
-	  // --- Automatic calculation of acceptance -----------------
-	  rh->fGood->Fill(eta);
-
-	  // --- If we asked to re-calculate phi for (x,y) IP --------
-	  // START_TIMER(timer);
-	  // if (fRecalculatePhi) {
-	  // oldPhi = phi;
-	  //  phi = AliForwardUtil::GetPhiFromStrip(r, t, phi, ip.X(), ip.Y());
-	  // }
-	  // phiCache[s*nt+t] = phi;
-	  // ADD_TIMER(timer,rePhiTime);
-
-	  // --- Apply phi corner correction to eloss ----------------
-	  if (fUsePhiAcceptance == kPhiCorrectELoss) 
-	    mult *= AcceptanceCorrection(r,t);
-
-	  // --- Get the low multiplicity cut ------------------------
-	  Double_t cut  = 1024;
-	  if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
-	  else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
-			   d, r, s, t, eta);
-
-	  // --- Now caluculate Nch for this strip using fits --------
-	  START_TIMER(timer);
-	  Double_t n   = 0;
-	  if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
-	  rh->fELoss->Fill(mult);
-	  // rh->fEvsN->Fill(mult,n);
-	  // rh->fEtaVsN->Fill(eta, n);
-	  ADD_TIMER(timer,nPartTime);
-	  
-	  // --- Calculate correction if needed ----------------------
-	  START_TIMER(timer);
-	  // Temporary stuff - remove Correction call 
-	  Double_t c = 1;
-	  if (fUsePhiAcceptance == kPhiCorrectNch) 
-	    c = AcceptanceCorrection(r,t);
-	  // Double_t c = Correction(d,r,t,eta,lowFlux);
-	  ADD_TIMER(timer,corrTime);
-	  fCorrections->Fill(c);
-	  if (c > 0) n /= c;
-	  // rh->fEvsM->Fill(mult,n);
-	  // rh->fEtaVsM->Fill(eta, n);
-	  rh->fCorr  ->Fill(eta, c);
-	  
-	  // --- Accumulate Poisson statistics -----------------------
-	  Bool_t hit = (n > fHitThreshold && c > 0);
-	  if (hit) {
-	    rh->fELossUsed->Fill(mult);
-	    if (fRecalculatePhi) {
-	      rh->fPhiBefore->Fill(oldPhi);
-	      rh->fPhiAfter->Fill(phi);
-	      rh->fEtaBefore->Fill(oldEta);
-	      rh->fEtaAfter->Fill(oldEta);	      
-	    }
-	    rh->fSignal->Fill(eta, mult);
-	  }
-	  rh->fPoisson.Fill(t,s,hit,1./c);
-	  h->Fill(eta,phi,n);
-
-	  // --- If we use ELoss fits, apply now ---------------------
-	  if (!fUsePoisson) rh->fDensity->Fill(eta,phi,n);
-	} // for t
-      } // for s 
-
-      // --- Automatic acceptance - Calculate as an efficiency -------
-      // This is very fast, so we do not bother to time it 
-      rh->fGood->Divide(rh->fGood, rh->fTotal, 1, 1, "B");
-
-      // --- Make a copy and reset as needed -------------------------
+    } // for q
+  } // for d
+
+  if (fDoTiming) {
+    // fHTiming->Fill(1,reEtaTime);
+    fHTiming->Fill(2,timing[0]); // N_{particle}
+    fHTiming->Fill(3,timing[1]); // Correction
+    fHTiming->Fill(4,timing[2]); // Re-calculation
+    fHTiming->Fill(5,timing[3]); // Copy to cache
+    fHTiming->Fill(6,timing[4]); // Poisson calculation
+    fHTiming->Fill(7,timing[5]); // Diagnostics
+    fHTiming->Fill(8,totalT.CpuTime());
+  }
+
+  return kTRUE;
+}
+
+//____________________________________________________________________
+Bool_t
+AliFMDDensityCalculator::CalculateRing(const AliESDFMD&        fmd,
+				       AliForwardUtil::Histos& hists,
+				       UShort_t                d, 
+				       Char_t                  r, 
+				       Bool_t                  lowFlux,
+				       const TVector3&         ip,
+				       Double_t*               timing)
+{
+  // 
+  // Do the calculations for a single ring.  Called for each ring
+  // in turn by Calculate, which sums the timings of all rings.
+  // 
+  // Parameters:
+  //    fmd      AliESDFMD object (possibly) corrected for sharing
+  //    hists    Histogram cache
+  //    d        Detector 
+  //    r        Ring 
+  //    lowFlux  Low flux flag. 
+  //    ip       Interaction point 
+  //    timing   Accumulated timings (N_particle, correction, phi
+  //             re-calculation, copy, Poisson, diagnostics)
+  // 
+  // Return:
+  //    true on successs 
+  TStopwatch timer;
+  Double_t&  nPartTime   = timing[0];
+  Double_t&  corrTime    = timing[1];
+  Double_t&  rePhiTime   = timing[2];
+  Double_t&  copyTime    = timing[3];
+  Double_t&  poissonTime = timing[4];
+  Double_t&  diagTime    = timing[5];
+  
+  Double_t etaCache[20*512]; // Same number of strips per ring 
+  Double_t phiCache[20*512]; // whether it is inner our outer. 
+  // We do not use TArrayD because we do not wont a bounds check 
+
+  UShort_t    ns= (r == 'I' ?  20 :  40);
+  UShort_t    nt= (r == 'I' ? 512 : 256);
+  TH2D*       h = hists.Get(d,r);
+  RingHistos* rh= GetRingHistos(d,r);
+  if (!rh) { 
+    AliError(Form("No ring histogram found for FMD%d%c", d, r));
+    fRingHistos.ls();
+    return false;
+  }
+  // rh->fPoisson.SetObject(d,r,vtxbin,cent);
+  rh->fPoisson.Reset(0);
+  rh->fTotal->Reset();
+  rh->fGood->Reset();
+  // rh->ResetPoissonHistos(h, fEtaLumping, fPhiLumping);
+
+  // Note, the eta and phi caches need not be reset - all ns*nt
+  // entries are set in the strip loop below before being used.
+
+  // --- Loop over sectors and strips ----------------------------
+  for (UShort_t s=0; s<ns; s++) { 
+    for (UShort_t t=0; t<nt; t++) {
+      
+      Float_t  mult   = fmd.Multiplicity(d,r,s,t);
+      Double_t phi    = fmd.Phi(d,r,s,t) * TMath::DegToRad();
+      Double_t eta    = fmd.Eta(d,r,s,t);
+      Double_t oldPhi = phi;
+      Double_t oldEta = eta;
       START_TIMER(timer);
-      TH2D* hclone = fCache.Get(d,r);
-      // hclone->Reset();
-      // TH2D* hclone = static_cast<TH2D*>(h->Clone("hclone"));
-      if (!fUsePoisson) hclone->Reset();
-      else { 
-	for (Int_t i = 0; i <= h->GetNbinsX()+1; i++) { 
-	  for (Int_t j = 0; j <= h->GetNbinsY()+1; j++) {
-	    hclone->SetBinContent(i,j,h->GetBinContent(i,j));
-	    hclone->SetBinError(i,j,h->GetBinError(i,j));
-	  }
+      if (fRecalculatePhi) {
+	// Correct for (x,y) off set of the interaction point 
+	// AliForwardUtil::GetEtaPhiFromStrip(r,t,eta,phi,ip.X(),ip.Y());
+	if (!AliForwardUtil::GetEtaPhi(d,r,s,t,ip,eta,phi) ||
+	    TMath::Abs(eta) < 1) {
+	  AliWarningF("FMD%d%c[%2d,%3d] (%f,%f,%f) eta=%f phi=%f (%f)",
+		      d, r, s, t, ip.X(), ip.Y(), ip.Z(), eta,
+		      phi, oldEta);
+	  eta = oldEta;
+	  phi = oldPhi;
 	}
-	// hclone->Add(h); 
-	h->Reset(); 
+	DMSG(fDebug, 10, "IP(x,y,z)=%f,%f,%f Eta=%f -> %f Phi=%f -> %f",
+	     ip.X(), ip.Y(), ip.Z(), oldEta, eta, oldPhi, phi);
       }
-      ADD_TIMER(timer,copyTime);
-      
-      // --- Store Poisson result ------------------------------------
+      ADD_TIMER(timer,rePhiTime);
       START_TIMER(timer);
-      TH2D* poisson = rh->fPoisson.Result();
-      for (Int_t t=0; t < poisson->GetNbinsX(); t++) { 
-	for (Int_t s=0; s < poisson->GetNbinsY(); s++) { 
-	  
-	  Double_t poissonV = poisson->GetBinContent(t+1,s+1);
-	  // Use cached eta - since the calls to GetEtaFromStrip and
-	  // GetPhiFromStrip are _very_ expensive
-	  Double_t  phi  = phiCache[s*nt+t];
-	  Double_t  eta  = etaCache[s*nt+t]; 
-	  // Double_t  phi  = fmd.Phi(d,r,s,t) * TMath::DegToRad();
-	  // Double_t  eta  = fmd.Eta(d,r,s,t);
-	  if (fUsePoisson) {
-	    h->Fill(eta,phi,poissonV);
-	    rh->fDensity->Fill(eta, phi, poissonV);
-	  }
-	  else
-	    hclone->Fill(eta,phi,poissonV);
-	}
+      etaCache[s*nt+t] = eta;
+      phiCache[s*nt+t] = phi;
+
+      // --- Check this strip ------------------------------------
+      rh->fTotal->Fill(eta);
+      if (mult == AliESDFMD::kInvalidMult) { //  || mult > 20) {
+	// Do not count invalid stuff 
+	rh->fELoss->Fill(-1);
+	// rh->fEvsN->Fill(mult,-1);
+	// rh->fEvsM->Fill(mult,-1);
+	continue;
       }
-      ADD_TIMER(timer,poissonTime);
+      if (mult > 20) 
+	AliWarningF("Raw multiplicity of FMD%d%c[%02d,%03d] = %f > 20",
+		    d, r, s, t, mult);
+      // --- Automatic calculation of acceptance -----------------
+      rh->fGood->Fill(eta);
+
+      // --- If we asked to re-calculate phi for (x,y) IP --------
+      // START_TIMER(timer);
+      // if (fRecalculatePhi) {
+      // oldPhi = phi;
+      //  phi = AliForwardUtil::GetPhiFromStrip(r, t, phi, ip.X(), ip.Y());
+      // }
+      // phiCache[s*nt+t] = phi;
+      // ADD_TIMER(timer,rePhiTime);
+
+      // --- Apply phi corner correction to eloss ----------------
+      if (fUsePhiAcceptance == kPhiCorrectELoss) 
+	mult *= AcceptanceCorrection(r,t);
+
+      // --- Get the low multiplicity cut ------------------------
+      Double_t cut  = 1024;
+      if (eta != AliESDFMD::kInvalidEta) cut = GetMultCut(d, r, eta,false);
+      else AliWarningF("Eta for FMD%d%c[%02d,%03d] is invalid: %f", 
+		       d, r, s, t, eta);
+
+      // --- Now caluculate Nch for this strip using fits --------
+      START_TIMER(timer);
+      Double_t n   = 0;
+      if (cut > 0 && mult > cut) n = NParticles(mult,d,r,eta,lowFlux);
+      rh->fELoss->Fill(mult);
+      // rh->fEvsN->Fill(mult,n);
+      // rh->fEtaVsN->Fill(eta, n);
+      ADD_TIMER(timer,nPartTime);
       
-      // --- Make diagnostics - eloss vs poisson ---------------------
+      // --- Calculate correction if needed ----------------------
       START_TIMER(timer);
-      Int_t nY = h->GetNbinsY();
-      Int_t nIn  = 0; // Count non-outliers
-      Int_t nOut = 0; // Count outliers
-      for (Int_t ieta=1; ieta <= h->GetNbinsX(); ieta++) { 
-	// Set the overflow bin to contain the phi acceptance 
-	Double_t phiAcc  = rh->fGood->GetBinContent(ieta);
-	Double_t phiAccE = rh->fGood->GetBinError(ieta);
-	h->SetBinContent(ieta, nY+1, phiAcc);
-	h->SetBinError(ieta, nY+1, phiAccE);
-	Double_t eta     = h->GetXaxis()->GetBinCenter(ieta);
-	rh->fPhiAcc->Fill(eta, ip.Z(), phiAcc);
-	for (Int_t iphi=1; iphi<= nY; iphi++) { 
-	  
-	  Double_t poissonV =  0; //h->GetBinContent(,s+1);
-	  Double_t eLossV =  0;
-	  if(fUsePoisson) { 
-	    poissonV = h->GetBinContent(ieta,iphi);
-	    eLossV  = hclone->GetBinContent(ieta,iphi);
-	  }
-	  else { 
-	    poissonV = hclone->GetBinContent(ieta,iphi);
-	    eLossV  = h->GetBinContent(ieta,iphi);
-	  }
-	  
-	  if (poissonV < 1e-12 && eLossV < 1e-12) 
-	    // we do not care about trivially empty bins 
-	    continue;
-				      
-	  Bool_t   outlier = CheckOutlier(eLossV, poissonV, fOutlierCut);
-	  Double_t rel     = eLossV < 1e-12 ? 0 : (poissonV - eLossV) / eLossV;
-	  if (outlier) {
-	    rh->fELossVsPoissonOut->Fill(eLossV, poissonV);
-	    rh->fDiffELossPoissonOut->Fill(rel);
-	    nOut++;
+      // Temporary stuff - remove Correction call 
+      Double_t c = 1;
+      if (fUsePhiAcceptance == kPhiCorrectNch) 
+	c = AcceptanceCorrection(r,t);
+      // Double_t c = Correction(d,r,t,eta,lowFlux);
+      ADD_TIMER(timer,corrTime);
+      fCorrections->Fill(c);
+      if (c > 0) n /= c;
+      // rh->fEvsM->Fill(mult,n);
+      // rh->fEtaVsM->Fill(eta, n);
+      rh->fCorr  ->Fill(eta, c);
+      
+      // --- Accumulate Poisson statistics -----------------------
+      Bool_t hit = (n > fHitThreshold && c > 0);
+      if (hit) {
+	rh->fELossUsed->Fill(mult);
+	if (fRecalculatePhi) {
+	  rh->fPhiBefore->Fill(oldPhi);
+	  rh->fPhiAfter->Fill(phi);
+	  rh->fEtaBefore->Fill(oldEta);
+	  rh->fEtaAfter->Fill(oldEta);	      
 	}
-	  else {
-	    rh->fELossVsPoisson->Fill(eLossV, poissonV);
-	    rh->fDiffELossPoisson->Fill(rel);
-	    nIn++;
-	  } // if (outlier)
-	} // for (iphi)
-      } // for (ieta)
-      Int_t    nTotal   = (nIn+nOut);
-      Double_t outRatio = (nTotal > 0 ? Double_t(nOut) / nTotal : 0);
-      rh->fOutliers->Fill(outRatio);
-      if (outRatio < fMaxOutliers) rh->fPoisson.FillDiagnostics();
-      else                         h->SetBit(AliForwardUtil::kSkipRing);
-      ADD_TIMER(timer,diagTime);
-      // delete hclone;
+	rh->fSignal->Fill(eta, mult);
+      }
+      rh->fPoisson.Fill(t,s,hit,1./c);
+      h->Fill(eta,phi,n);
+
+      // --- If we use ELoss fits, apply now ---------------------
+      if (!fUsePoisson) rh->fDensity->Fill(eta,phi,n);
+    } // for t
+  } // for s 
+
+  // --- Automatic acceptance - Calculate as an efficiency -------
+  // This is very fast, so we do not bother to time it 
+  rh->fGood->Divide(rh->fGood, rh->fTotal, 1, 1, "B");
+
+  // --- Make a copy and reset as needed -------------------------
+  START_TIMER(timer);
+  TH2D* hclone = fCache.Get(d,r);
+  // hclone->Reset();
+  // TH2D* hclone = static_cast<TH2D*>(h->Clone("hclone"));
+  if (!fUsePoisson) hclone->Reset();
+  else { 
+    for (Int_t i = 0; i <= h->GetNbinsX()+1; i++) { 
+      for (Int_t j = 0; j <= h->GetNbinsY()+1; j++) {
+	hclone->SetBinContent(i,j,h->GetBinContent(i,j));
+	hclone->SetBinError(i,j,h->GetBinError(i,j));
+      }
+    }
+    // hclone->Add(h); 
+    h->Reset(); 
+  }
+  ADD_TIMER(timer,copyTime);
+  
+  // --- Store Poisson result ------------------------------------
+  START_TIMER(timer);
+  TH2D* poisson = rh->fPoisson.Result();
+  for (Int_t t=0; t < poisson->GetNbinsX(); t++) { 
+    for (Int_t s=0; s < poisson->GetNbinsY(); s++) { 
       
-    } // for q
-  } // for d
-
-  if (fDoTiming) {
-    // fHTiming->Fill(1,reEtaTime);
-    fHTiming->Fill(2,nPartTime);
-    fHTiming->Fill(3,corrTime);
-    fHTiming->Fill(4,rePhiTime);
-    fHTiming->Fill(5,copyTime);
-    fHTiming->Fill(6,poissonTime);
-    fHTiming->Fill(7,diagTime);
-    fHTiming->Fill(8,totalT.CpuTime());
+      Double_t poissonV = poisson->GetBinContent(t+1,s+1);
+      // Use cached eta - since the calls to GetEtaFromStrip and
+      // GetPhiFromStrip are _very_ expensive
+      Double_t  phi  = phiCache[s*nt+t];
+      Double_t  eta  = etaCache[s*nt+t]; 
+      // Double_t  phi  = fmd.Phi(d,r,s,t) * TMath::DegToRad();
+      // Double_t  eta  = fmd.Eta(d,r,s,t);
+      if (fUsePoisson) {
+	h->Fill(eta,phi,poissonV);
+	rh->fDensity->Fill(eta, phi, poissonV);
+      }
+      else
+	hclone->Fill(eta,phi,poissonV);
+    }
   }
-
-  return kTRUE;
+  ADD_TIMER(timer,poissonTime);
+  
+  // --- Make diagnostics - eloss vs poisson ---------------------
+  START_TIMER(timer);
+  Int_t nY = h->GetNbinsY();
+  Int_t nIn  = 0; // Count non-outliers
+  Int_t nOut = 0; // Count outliers
+  for (Int_t ieta=1; ieta <= h->GetNbinsX(); ieta++) { 
+    // Set the overflow bin to contain the phi acceptance 
+    Double_t phiAcc  = rh->fGood->GetBinContent(ieta);
+    Double_t phiAccE = rh->fGood->GetBinError(ieta);
+    h->SetBinContent(ieta, nY+1, phiAcc);
+    h->SetBinError(ieta, nY+1, phiAccE);
+    Double_t eta     = h->GetXaxis()->GetBinCenter(ieta);
+    rh->fPhiAcc->Fill(eta, ip.Z(), phiAcc);
+    for (Int_t iphi=1; iphi<= nY; iphi++) { 
+      
+      Double_t poissonV =  0; //h->GetBinContent(,s+1);
+      Double_t eLossV =  0;
+      if(fUsePoisson) { 
+	poissonV = h->GetBinContent(ieta,iphi);
+	eLossV  = hclone->GetBinContent(ieta,iphi);
+      }
+      else { 
+	poissonV = hclone->GetBinContent(ieta,iphi);
+	eLossV  = h->GetBinContent(ieta,iphi);
+      }
+      
+      if (poissonV < 1e-12 && eLossV < 1e-12) 
+	// we do not care about trivially empty bins 
+	continue;
+				  
+      Bool_t   outlier = CheckOutlier(eLossV, poissonV, fOutlierCut);
+      Double_t rel     = eLossV < 1e-12 ? 0 : (poissonV - eLossV) / eLossV;
+      if (outlier) {
+	rh->fELossVsPoissonOut->Fill(eLossV, poissonV);
+	rh->fDiffELossPoissonOut->Fill(rel);
+	nOut++;
+      }
+      else {
+	rh->fELossVsPoisson->Fill(eLossV, poissonV);
+	rh->fDiffELossPoisson->Fill(rel);
+	nIn++;
+      } // if (outlier)
+    } // for (iphi)
+  } // for (ieta)
+  Int_t    nTotal   = (nIn+nOut);
+  Double_t outRatio = (nTotal > 0 ? Double_t(nOut) / nTotal : 0);
+  rh->fOutliers->Fill(outRatio);
+  if (outRatio < fMaxOutliers) rh->fPoisson.FillDiagnostics();
+  else                         h->SetBit(AliForwardUtil::kSkipRing);
+  ADD_TIMER(timer,diagTime);
+  // delete hclone;
+  return true;
 }
 
 //_____________________________________________________________________
@@ -114,6 +114,27 @@ public:
 			   Bool_t   		   lowFlux, 
 			   Double_t  		   cent=-1, 
 			   const TVector3&         ip=TVector3(1024,1024,0));
+  /** 
+   * Do the calculations for a single ring.  Called for each ring
+   * in turn by Calculate.
+   * 
+   * @param fmd      AliESDFMD object (possibly) corrected for sharing
+   * @param hists    Histogram cache
+   * @param d        Detector 
+   * @param r        Ring 
+   * @param lowFlux  Low flux flag. 
+   * @param ip       Coordinates of interaction point
+   * @param timing   Array of 6 accumulated timings 
+   * 
+   * @return true on successs 
+   */
+  virtual Bool_t CalculateRing(const AliESDFMD&        fmd, 
+			       AliForwardUtil::Histos& hists, 
+			       UShort_t                d, 
+			       Char_t                  r, 
+			       Bool_t   	       lowFlux, 
+			       const TVector3&         ip, 
+			       Double_t*               timing);
   /** 
    * Scale the histograms to the total number of events 
    * 
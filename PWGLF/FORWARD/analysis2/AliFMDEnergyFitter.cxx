@@ -202,6 +202,8 @@ AliFMDEnergyFitter::CreateOutputObjects(TList* dir)
   d->Add(AliForwardUtil::MakeParameter("regCut",        fRegularizationCut));
   d->Add(AliForwardUtil::MakeParameter("deltaShift", 
 				       AliLandauGaus::EnableSigmaShift()));
+  d->Add(AliForwardUtil::MakeParameter("tabulated", 
+				       AliLandauGaus::EnableTable()));
 
   if (fRingHistos.GetEntries() <= 0) { 
     AliFatal("No ring histograms where defined - giving up!");
@@ -297,6 +299,12 @@ AliFMDEnergyFitter::SetEnableDeltaShift(Bool_t use)
 {
   AliLandauGaus::EnableSigmaShift(use ? 1 : 0);
 }
+//____________________________________________________________________
+void
+AliFMDEnergyFitter::SetUseTabulated(Bool_t use) 
+{
+  AliLandauGaus::EnableTable(use ? 1 : 0);
+}
 
 //____________________________________________________________________
 Bool_t
@@ -590,6 +598,7 @@ AliFMDEnergyFitter::Print(Option_t*) const
   case kResidualSquareDifference: r = "Square difference"; break;
   }
   PFV("Residuals", r);
+  PFB("Tabulated Landau-Gauss", AliLandauGaus::EnableTable());
   gROOT->DecreaseDirLevel();
 }
   
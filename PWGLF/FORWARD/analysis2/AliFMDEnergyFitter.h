@@ -299,6 +299,14 @@ public:
    * @param use If true, enable extra shift @f$\delta\Delta_p(\sigma/\xi)@f$  
    */
   void SetEnableDeltaShift(Bool_t use=true);
+  /**
+   * Whether to evaluate the Landau-Gauss functions from the
+   * precomputed table (AliLandauGausTable) rather than by numeric
+   * integration.  This speeds up the fits considerably.
+   *
+   * @param use If true, use the tabulated Landau-Gauss 
+   */
+  void SetUseTabulated(Bool_t use=true);
 
   /* @} */
   // -----------------------------------------------------------------
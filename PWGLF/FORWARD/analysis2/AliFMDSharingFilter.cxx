@@ -218,208 +218,8 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
   for(UShort_t d = 1; d <= 3; d++) {
     Int_t nRings = (d == 1 ? 1 : 2);
     for (UShort_t q = 0; q < nRings; q++) {
-      Char_t      r      = (q == 0 ? 'I' : 'O');
-      UShort_t    nsec   = (q == 0 ?  20 :  40);
-      UShort_t    nstr   = (q == 0 ? 512 : 256);
-      RingHistos* histos = GetRingHistos(d, r);
-      
-      for(UShort_t s = 0; s < nsec;  s++) {	
-	// `used' flags if the _current_ strip was used by _previous_ 
-	// iteration. 
-	Bool_t   used            = kFALSE;
-	// `eTotal' contains the current sum of merged signals so far 
-	Double_t eTotal          = -1;
-	// Int_t    nDistanceBefore = -1;
-	// Int_t    nDistanceAfter  = -1;
-	// `twoLow' flags if we saw two consequtive strips with a 
-	// signal between the two cuts. 
-	Bool_t   twoLow          = kFALSE;
-        Int_t    nStripsAboveCut = 0;
-	
-	for(UShort_t t = 0; t < nstr; t++) {
-	  // nDistanceBefore++;
-	  // nDistanceAfter++;
-
-	  output.SetMultiplicity(d,r,s,t,0.);
-	  Float_t mult         = SignalInStrip(input,d,r,s,t);
-	  Float_t multNext     = (t<nstr-1) ? SignalInStrip(input,d,r,s,t+1) :0;
-	  Float_t multNextNext = (t<nstr-2) ? SignalInStrip(input,d,r,s,t+2) :0;
-	  if (multNext     ==  AliESDFMD::kInvalidMult) multNext     = 0;
-	  if (multNextNext ==  AliESDFMD::kInvalidMult) multNextNext = 0;
-	  if(!fThreeStripSharing) multNextNext = 0;
-
-	  // Get the pseudo-rapidity 
-	  Double_t eta = input.Eta(d,r,s,t);
-	  Double_t phi = input.Phi(d,r,s,t) * TMath::Pi() / 180.;
-	  if (s == 0) output.SetEta(d,r,s,t,eta);
-	  
-	  // Keep dead-channel information - either from the ESD (but
-	  // see above for older data) or from the settings in the
-	  // ForwardAODConfig.C file.
-	  if (mult == AliESDFMD::kInvalidMult) {
-	    output.SetMultiplicity(d,r,s,t,AliESDFMD::kInvalidMult);
-	    histos->fBefore->Fill(-1);
-	    mult = AliESDFMD::kInvalidMult;
-	  }
-	  
-	  Double_t lowCut  = GetLowCut(d, r, eta);
-	  Double_t highCut = GetHighCut(d, r, eta, false);
-	  if (mult != AliESDFMD::kInvalidMult && mult > lowCut) {
-	    // Always fill the ESD sum histogram 
-	    histos->fSumESD->Fill(eta, phi, mult);
-	  }
-
-	  // If no signal or dead strip, go on. 
-	  if (mult == AliESDFMD::kInvalidMult || mult == 0) {
-	    if (mult == 0) histos->fSum->Fill(eta,phi,mult);
-	    // Flush a possible signal 
-	    if (eTotal > 0 && t > 0) 
-	      output.SetMultiplicity(d,r,s,t-1,eTotal);
-	    // Reset states so we do not try to merge over a dead strip. 
-	    eTotal = -1;
-	    used   = false;
-	    twoLow = false;
-	    if (t > 0)	
-	      histos->fNConsecutive->Fill(nStripsAboveCut);
-	    if (mult == AliESDFMD::kInvalidMult)
-	      // Why not fill immidiately here? 
-	      nStripsAboveCut = -1;
-	    else
-	      // Why not fill immidiately here? 
-	      nStripsAboveCut = 0;	
-	    continue;
-	  }
-
-	  // Fill the diagnostics histogram 
-	  histos->fBefore->Fill(mult);
-
-	  Double_t mergedEnergy = mult;
-	  // it seems to me that this logic could be condensed a bit
-          if(mult > lowCut) {		  
-	    if(nStripsAboveCut < 1) {
-	      if(t > 0)
-		histos->fNConsecutive->Fill(nStripsAboveCut);
-	      nStripsAboveCut=0;
-	    }
-	    nStripsAboveCut++;
-	  }	
-	  else {
-	    if (t > 0)
-	      histos->fNConsecutive->Fill(nStripsAboveCut);
-	    nStripsAboveCut=0;
-	  }		
-
-	  if (!fMergingDisabled) {
-	    mergedEnergy = 0;
-
-	    // The current sum
-	    Float_t etot = 0;
-	  
-	    // Fill in neighbor information
-	    if (t < nstr-1) histos->fNeighborsBefore->Fill(mult,multNext);
-
-	    Bool_t thisValid = mult     > lowCut;
-	    Bool_t nextValid = multNext > lowCut;
-	    Bool_t thisSmall = mult     < highCut;
-	    Bool_t nextSmall = multNext < highCut;
-	  
-	    // If this strips signal is above the high cut, reset distance
-	    // if (!thisSmall) {
-	    //    histos->fDistanceBefore->Fill(nDistanceBefore);
-	    //    nDistanceBefore = -1;
-	    // }
-	  
-	    // If the total signal in the past 1 or 2 strips are non-zero
-	    // we need to check 
-	    if (eTotal > 0) {
-	      // Here, we have already flagged one strip as a candidate 
-	    
-	      // If 3-strip merging is enabled, then check the next 
-	      // strip to see that it falls within cut, or if we have 
-	      // two low signals 
-	      if (fThreeStripSharing && nextValid && (nextSmall || twoLow)) {
-		eTotal = eTotal + multNext;
-		used = kTRUE;
-		histos->fTriple->Fill(eTotal);
-		nTriple++;
-		twoLow = kFALSE;
-	      }
-	      // Otherwise, we got a double hit before, and that 
-	      // should be stored. 
-	      else {
-		used = kFALSE;
-		histos->fDouble->Fill(eTotal);
-		nDouble++;
-	      }
-	      // Store energy loss and reset sum 
-	      etot   = eTotal;
-	      eTotal = -1;
-	    } // if (eTotal>0)
-	    else {
-	      // If we have no current sum 
-	    
-	      // Check if this is marked as used, and if so, continue
-	      if (used) {used = kFALSE; continue; }
-	    
-	      // If the signal is abvoe the cut, set current
-	      if (thisValid) etot = mult;
-	    
-	      // If the signal is abiove the cut, and so is the next 
-	      // signal and either of them are below the high cut, 
-	      if (thisValid  && nextValid  && (thisSmall || nextSmall)) {
-	      
-		// If this is below the high cut, and the next is too, then 
-		// we have two low signals 
-		if (thisSmall && nextSmall) twoLow = kTRUE;
-	      
-		// If this signal is bigger than the next, and the 
-		// one after that is below the low-cut, then update 
-		// the sum
-		if (mult>multNext && multNextNext < lowCut) {
-		  etot = mult + multNext;
-		  used = kTRUE;
-		  histos->fDouble->Fill(etot);
-		  nDouble++;
-		}
-		// Otherwise, we may need to merge with a third strip
-		else {
-		  etot   = 0;
-		  eTotal = mult + multNext;
-		}
-	      }
-	      // This is a signle hit 
-	      else if(etot > 0) {
-		histos->fSingle->Fill(etot);
-		histos->fSinglePerStrip->Fill(etot,t);
-		nSingle++;
-	      }
-	    } // else if (etotal >= 0)
-	  
-	    mergedEnergy = etot;
-	    // if (mergedEnergy > GetHighCut(d, r, eta ,false)) {
-	    //   histos->fDistanceAfter->Fill(nDistanceAfter);
-	    //   nDistanceAfter    = -1;
-	    // }
-	    //if(mult>0 && multNext >0)
-	    //  std::cout<<mult<<"  "<<multNext<<"  "<<mergedEnergy<<std::endl;
-	  } // if (!fMergingDisabled)
-
-	  if (!fCorrectAngles)
-	    mergedEnergy = AngleCorrect(mergedEnergy, eta);
-	  // if (mergedEnergy > 0) histos->Incr();
-	  
-	  if (t != 0) 
-	    histos->fNeighborsAfter->Fill(output.Multiplicity(d,r,s,t-1), 
-					  mergedEnergy);
-	  histos->fBeforeAfter->Fill(mult, mergedEnergy);
-	  if(mergedEnergy > 0)
-	    histos->fAfter->Fill(mergedEnergy);
-	  histos->fSum->Fill(eta,phi,mergedEnergy);
-	  
-	  output.SetMultiplicity(d,r,s,t,mergedEnergy);
-	} // for strip
-	histos->fNConsecutive->Fill(nStripsAboveCut); // fill the last sector 
-      } // for sector
+      Char_t r = (q == 0 ? 'I' : 'O');
+      FilterRing(input, output, d, r, nSingle, nDouble, nTriple);
     } // for ring 
   } // for detector
   DMSG(fDebug, 3,"single=%9d, double=%9d, triple=%9d", 
@@ -430,6 +230,238 @@ AliFMDSharingFilter::Filter(const AliESDFMD& input,
   return kTRUE;
 }
 
+
+//_____________________________________________________________________
+void
+AliFMDSharingFilter::FilterRing(const AliESDFMD& input, 
+				AliESDFMD&       output, 
+				UShort_t         d, 
+				Char_t           r, 
+				Int_t&           nSingle, 
+				Int_t&           nDouble, 
+				Int_t&           nTriple)
+{
+  // 
+  // Filter a single ring of the input AliESDFMD object.  Called
+  // for each ring in turn by Filter.
+  // 
+  // Parameters:
+  //    input     Input 
+  //    output    Output AliESDFMD object 
+  //    d         Detector
+  //    r         Ring 
+  //    nSingle   Incremented by number of single hits 
+  //    nDouble   Incremented by number of double hits 
+  //    nTriple   Incremented by number of triple hits 
+  //
+  UShort_t    nsec   = (r == 'I' ?  20 :  40);
+  UShort_t    nstr   = (r == 'I' ? 512 : 256);
+  RingHistos* histos = GetRingHistos(d, r);
+  Float_t     signals[512]; // Signals of current sector
+      
+  for(UShort_t s = 0; s < nsec;  s++) {
+    // Read (and possibly (de-)angle correct) each strip once 
+    for(UShort_t t = 0; t < nstr; t++) 
+      signals[t] = SignalInStrip(input,d,r,s,t);
+
+    // `used' flags if the _current_ strip was used by _previous_ 
+    // iteration. 
+    Bool_t   used            = kFALSE;
+    // `eTotal' contains the current sum of merged signals so far 
+    Double_t eTotal          = -1;
+    // Int_t    nDistanceBefore = -1;
+    // Int_t    nDistanceAfter  = -1;
+    // `twoLow' flags if we saw two consequtive strips with a 
+    // signal between the two cuts. 
+    Bool_t   twoLow          = kFALSE;
+    Int_t    nStripsAboveCut = 0;
+    
+    for(UShort_t t = 0; t < nstr; t++) {
+      // nDistanceBefore++;
+      // nDistanceAfter++;
+
+      output.SetMultiplicity(d,r,s,t,0.);
+      Float_t mult         = signals[t];
+      Float_t multNext     = (t<nstr-1) ? signals[t+1] : 0;
+      Float_t multNextNext = (t<nstr-2) ? signals[t+2] : 0;
+      if (multNext     ==  AliESDFMD::kInvalidMult) multNext     = 0;
+      if (multNextNext ==  AliESDFMD::kInvalidMult) multNextNext = 0;
+      if(!fThreeStripSharing) multNextNext = 0;
+
+      // Get the pseudo-rapidity 
+      Double_t eta = input.Eta(d,r,s,t);
+      Double_t phi = input.Phi(d,r,s,t) * TMath::Pi() / 180.;
+      if (s == 0) output.SetEta(d,r,s,t,eta);
+      
+      // Keep dead-channel information - either from the ESD (but
+      // see above for older data) or from the settings in the
+      // ForwardAODConfig.C file.
+      if (mult == AliESDFMD::kInvalidMult) {
+	output.SetMultiplicity(d,r,s,t,AliESDFMD::kInvalidMult);
+	histos->fBefore->Fill(-1);
+	mult = AliESDFMD::kInvalidMult;
+      }
+      
+      Double_t lowCut  = GetLowCut(d, r, eta);
+      Double_t highCut = GetHighCut(d, r, eta, false);
+      if (mult != AliESDFMD::kInvalidMult && mult > lowCut) {
+	// Always fill the ESD sum histogram 
+	histos->fSumESD->Fill(eta, phi, mult);
+      }
+
+      // If no signal or dead strip, go on. 
+      if (mult == AliESDFMD::kInvalidMult || mult == 0) {
+	if (mult == 0) histos->fSum->Fill(eta,phi,mult);
+	// Flush a possible signal 
+	if (eTotal > 0 && t > 0) 
+	  output.SetMultiplicity(d,r,s,t-1,eTotal);
+	// Reset states so we do not try to merge over a dead strip. 
+	eTotal = -1;
+	used   = false;
+	twoLow = false;
+	if (t > 0)	
+	  histos->fNConsecutive->Fill(nStripsAboveCut);
+	if (mult == AliESDFMD::kInvalidMult)
+	  // Why not fill immidiately here? 
+	  nStripsAboveCut = -1;
+	else
+	  // Why not fill immidiately here? 
+	  nStripsAboveCut = 0;	
+	continue;
+      }
+
+      // Fill the diagnostics histogram 
+      histos->fBefore->Fill(mult);
+
+      Double_t mergedEnergy = mult;
+      // it seems to me that this logic could be condensed a bit
+      if(mult > lowCut) {		  
+	if(nStripsAboveCut < 1) {
+	  if(t > 0)
+	    histos->fNConsecutive->Fill(nStripsAboveCut);
+	  nStripsAboveCut=0;
+	}
+	nStripsAboveCut++;
+      }	
+      else {
+	if (t > 0)
+	  histos->fNConsecutive->Fill(nStripsAboveCut);
+	nStripsAboveCut=0;
+      }		
+
+      if (!fMergingDisabled) {
+	mergedEnergy = 0;
+
+	// The current sum
+	Float_t etot = 0;
+      
+	// Fill in neighbor information
+	if (t < nstr-1) histos->fNeighborsBefore->Fill(mult,multNext);
+
+	Bool_t thisValid = mult     > lowCut;
+	Bool_t nextValid = multNext > lowCut;
+	Bool_t thisSmall = mult     < highCut;
+	Bool_t nextSmall = multNext < highCut;
+      
+	// If this strips signal is above the high cut, reset distance
+	// if (!thisSmall) {
+	//    histos->fDistanceBefore->Fill(nDistanceBefore);
+	//    nDistanceBefore = -1;
+	// }
+      
+	// If the total signal in the past 1 or 2 strips are non-zero
+	// we need to check 
+	if (eTotal > 0) {
+	  // Here, we have already flagged one strip as a candidate 
+	
+	  // If 3-strip merging is enabled, then check the next 
+	  // strip to see that it falls within cut, or if we have 
+	  // two low signals 
+	  if (fThreeStripSharing && nextValid && (nextSmall || twoLow)) {
+	    eTotal = eTotal + multNext;
+	    used = kTRUE;
+	    histos->fTriple->Fill(eTotal);
+	    nTriple++;
+	    twoLow = kFALSE;
+	  }
+	  // Otherwise, we got a double hit before, and that 
+	  // should be stored. 
+	  else {
+	    used = kFALSE;
+	    histos->fDouble->Fill(eTotal);
+	    nDouble++;
+	  }
+	  // Store energy loss and reset sum 
+	  etot   = eTotal;
+	  eTotal = -1;
+	} // if (eTotal>0)
+	else {
+	  // If we have no current sum 
+	
+	  // Check if this is marked as used, and if so, continue
+	  if (used) {used = kFALSE; continue; }
+	
+	  // If the signal is abvoe the cut, set current
+	  if (thisValid) etot = mult;
+	
+	  // If the signal is abiove the cut, and so is the next 
+	  // signal and either of them are below the high cut, 
+	  if (thisValid  && nextValid  && (thisSmall || nextSmall)) {
+	  
+	    // If this is below the high cut, and the next is too, then 
+	    // we have two low signals 
+	    if (thisSmall && nextSmall) twoLow = kTRUE;
+	  
+	    // If this signal is bigger than the next, and the 
+	    // one after that is below the low-cut, then update 
+	    // the sum
+	    if (mult>multNext && multNextNext < lowCut) {
+	      etot = mult + multNext;
+	      used = kTRUE;
+	      histos->fDouble->Fill(etot);
+	      nDouble++;
+	    }
+	    // Otherwise, we may need to merge with a third strip
+	    else {
+	      etot   = 0;
+	      eTotal = mult + multNext;
+	    }
+	  }
+	  // This is a signle hit 
+	  else if(etot > 0) {
+	    histos->fSingle->Fill(etot);
+	    histos->fSinglePerStrip->Fill(etot,t);
+	    nSingle++;
+	  }
+	} // else if (etotal >= 0)
+      
+	mergedEnergy = etot;
+	// if (mergedEnergy > GetHighCut(d, r, eta ,false)) {
+	//   histos->fDistanceAfter->Fill(nDistanceAfter);
+	//   nDistanceAfter    = -1;
+	// }
+	//if(mult>0 && multNext >0)
+	//  std::cout<<mult<<"  "<<multNext<<"  "<<mergedEnergy<<std::endl;
+      } // if (!fMergingDisabled)
+
+      if (!fCorrectAngles)
+	mergedEnergy = AngleCorrect(mergedEnergy, eta);
+      // if (mergedEnergy > 0) histos->Incr();
+      
+      if (t != 0) 
+	histos->fNeighborsAfter->Fill(output.Multiplicity(d,r,s,t-1), 
+				      mergedEnergy);
+      histos->fBeforeAfter->Fill(mult, mergedEnergy);
+      if(mergedEnergy > 0)
+	histos->fAfter->Fill(mergedEnergy);
+      histos->fSum->Fill(eta,phi,mergedEnergy);
+      
+      output.SetMultiplicity(d,r,s,t,mergedEnergy);
+    } // for strip
+    histos->fNConsecutive->Fill(nStripsAboveCut); // fill the last sector 
+  } // for sector
+}
+
 //_____________________________________________________________________
 Double_t 
 AliFMDSharingFilter::SignalInStrip(const AliESDFMD& input, 
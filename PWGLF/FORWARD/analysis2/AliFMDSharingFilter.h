@@ -341,6 +341,25 @@ protected:
 			 Char_t   r,
 			 UShort_t s,
 			 UShort_t t) const;
+  /** 
+   * Filter a single ring.  Called for each ring in turn by
+   * Filter.
+   * 
+   * @param input     Input 
+   * @param output    Output AliESDFMD object 
+   * @param d         Detector
+   * @param r         Ring 
+   * @param nSingle   Incremented by the number of single hits 
+   * @param nDouble   Incremented by the number of double hits 
+   * @param nTriple   Incremented by the number of triple hits 
+   */
+  void FilterRing(const AliESDFMD& input, 
+		  AliESDFMD&       output, 
+		  UShort_t         d, 
+		  Char_t           r, 
+		  Int_t&           nSingle, 
+		  Int_t&           nDouble, 
+		  Int_t&           nTriple);
   /** 
    * Angle correct the signal 
    * 
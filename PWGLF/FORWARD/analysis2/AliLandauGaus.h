@@ -13,6 +13,8 @@
 #include <TObject.h>
 #include <TF1.h>
 #include <TMath.h>
+#include <TArrayD.h>
+#include <TError.h>
 
 /** 
  * This class contains static member functions to calculate the energy
@@ -94,6 +96,19 @@
  * Landau with a Gaussian (see LandauGaus), and @f$ a@f$ is a vector of
  * weights for each @f$ f_i@f$. Note that @f$ a_1 = 1@f$.
  *
+ * Since the energy loss fits evaluate these functions very many
+ * times, the convolution @f$ f@f$ can be taken from a precomputed
+ * table (see AliLandauGausTable and EnableTable) rather than from the
+ * numeric integration.  The table is parameterised in the reduced
+ * variables @f$ t=(x-\Delta_p)/\xi@f$ and @f$ r=\sigma'/\xi@f$,
+ * since
+ *
+ * @f[
+ *   f(x;\Delta_p,\xi,\sigma') = \frac{1}{\xi} f(t;0,1,r)
+ * @f]
+ *
+ * Outside the tabulated region the numeric integration is used.
+ *
  * Everything is defined in this header file to make it easy to move
  * this code around. Nothing here's meant to be persistent, so we
  * can easily do that. 
@@ -211,6 +226,22 @@ public:
   static Double_t F(Double_t x, Double_t delta, Double_t xi, 
 		    Double_t sigma, Double_t sigma_n);
   //------------------------------------------------------------------
+  /** 
+   * Calculate the value of a Landau convolved with a Gaussian by
+   * numeric integration.  This is what F evaluates when the table is
+   * not enabled, or the arguments fall outside the table.
+   * 
+   * @param x         where to evaluate @f$ f@f$
+   * @param delta     @f$ \Delta_p@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param xi        @f$ \xi@f$ of @f$ f(x;\Delta_p,\xi,\sigma')@f$
+   * @param sigma     @f$ \sigma@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * @param sigma_n   @f$ \sigma_n@f$ of @f$\sigma'^2=\sigma^2-\sigma_n^2 @f$
+   * 
+   * @return @f$ f@f$ evaluated at @f$ x@f$.  
+   */
+  static Double_t FExact(Double_t x, Double_t delta, Double_t xi, 
+			 Double_t sigma, Double_t sigma_n);
+  //------------------------------------------------------------------
   /** 
    * Evaluate 
    * @f[ 
@@ -283,6 +314,28 @@ public:
   static Double_t Fn(Double_t x, Double_t delta, Double_t xi, 
 		     Double_t sigma, Double_t sigma_n, Int_t n, 
 		     const Double_t* a);
+  //------------------------------------------------------------------
+  /** 
+   * Evaluate @f$ f_N@f$ (see Fn) for an array of @f$ x@f$ values.
+   * The parameters of each @f$ f_i@f$ and the table interpolation
+   * weights in @f$ r@f$ are calculated once for all @f$ x@f$, and the
+   * inner loop over @f$ x@f$ only interpolates in @f$ t@f$.
+   * 
+   * @param nx       Number of points 
+   * @param x        Array of @f$ x@f$ values (size @a nx)
+   * @param y        On return, @f$ f_N@f$ at each @f$ x@f$ (size @a nx)
+   * @param delta    @f$ \Delta_1@f$ 
+   * @param xi       @f$ \xi_1@f$
+   * @param sigma    @f$ \sigma_1@f$ 
+   * @param sigma_n  @f$ \sigma_n@f$ 
+   * @param n        @f$ N@f$ 
+   * @param a        Array of size @f$ N-1@f$ of the weights @f$ a_i@f$ for 
+   *                 @f$ i > 1@f$ 
+   */
+  static void FnVector(Int_t nx, const Double_t* x, Double_t* y, 
+		       Double_t delta, Double_t xi, 
+		       Double_t sigma, Double_t sigma_n, Int_t n, 
+		       const Double_t* a);
   /** 
    * Get parameters for the @f$ i@f$ particle response.
    *
@@ -308,6 +361,15 @@ public:
    * @return whether the sigma shift is enabled or not 
    */
   static Bool_t EnableSigmaShift(Short_t val=-1);
+  /** 
+   * Set and check if the tabulated Landau-Gauss (AliLandauGausTable)
+   * is used in F.  The table is built on first use.
+   * 
+   * @param val if <0, then only check.  Otherwise set enabled (>0) or not (=0)
+   * 
+   * @return whether the table is enabled or not 
+   */
+  static Bool_t EnableTable(Short_t val=-1);
   /** 
    * Get the shift of the MPV due to convolution with a Gaussian. 
    *
@@ -475,6 +537,150 @@ public:
   static Double_t CompFunc(Double_t* xp, Double_t* pp);
   /* @} */
 };
+
+//____________________________________________________________________
+/** 
+ * Table of the Landau-Gauss convolution in reduced variables 
+ *
+ * @f[
+ *   g(t;r) = f(t;0,1,r) \quad t = \frac{x-\Delta_p}{\xi}, 
+ *   r = \frac{\sigma'}{\xi} 
+ * @f]
+ *
+ * tabulated on an equidistant grid in @f$ t@f$ and in @f$\log r@f$,
+ * and evaluated by bi-cubic (Catmull-Rom) interpolation.  When the
+ * table is built, the interpolation is checked against the numeric
+ * integration in the middle of the grid cells, and the largest
+ * deviation relative to the peak value of @f$ g(t;r)@f$ is stored
+ * (see MaxError).  A warning is issued if it exceeds Tolerance.
+ *
+ * @ingroup pwglf_forward 
+ */
+class AliLandauGausTable 
+{
+public:
+  /** 
+   * Get the table - built on first call 
+   *
+   * @return Static table
+   */
+  static const AliLandauGausTable& Instance();
+  /** 
+   * @return Least @f$ t@f$ tabulated 
+   */
+  static Double_t TMin() { return -20; }
+  /** 
+   * @return Largest @f$ t@f$ tabulated 
+   */
+  static Double_t TMax() { return 100; }
+  /** 
+   * @return Number of @f$ t@f$ grid points 
+   */
+  static Int_t NT() { return 2401; }
+  /** 
+   * @return Least @f$ r@f$ tabulated 
+   */
+  static Double_t RMin() { return 0.01; }
+  /** 
+   * @return Largest @f$ r@f$ tabulated 
+   */
+  static Double_t RMax() { return 5; }
+  /** 
+   * @return Number of @f$\log r@f$ grid points 
+   */
+  static Int_t NR() { return 161; }
+  /** 
+   * @return Maximum accepted relative interpolation error 
+   */
+  static Double_t Tolerance() { return 1e-3; }
+  /** 
+   * Check if @f$ r@f$ is inside the table 
+   * 
+   * @param r @f$ r=\sigma'/\xi@f$
+   * 
+   * @return true if inside 
+   */
+  Bool_t InRangeR(Double_t r) const 
+  { 
+    return r >= fRLow && r < fRHigh; 
+  }
+  /** 
+   * Check if @f$ t@f$ is inside the table 
+   * 
+   * @param t @f$ t=(x-\Delta_p)/\xi@f$
+   * 
+   * @return true if inside 
+   */
+  Bool_t InRangeT(Double_t t) const 
+  { 
+    return t >= fTLow && t < fTHigh; 
+  }
+  /** 
+   * Calculate the interpolation weights in @f$ r@f$.  
+   *
+   * @param r   @f$ r=\sigma'/\xi@f$ - must be InRangeR 
+   * @param ir  On return, first row to use 
+   * @param w   On return, weights of the rows @a ir, ..., @a ir+3 
+   */
+  void RWeights(Double_t r, Int_t& ir, Double_t* w) const;
+  /** 
+   * Interpolate the table at @f$ t@f$ for rows and weights calculated
+   * by RWeights
+   * 
+   * @param t  @f$ t=(x-\Delta_p)/\xi@f$ - must be InRangeT 
+   * @param ir First row 
+   * @param w  Row weights 
+   * 
+   * @return @f$ g(t;r)@f$ 
+   */
+  Double_t Eval(Double_t t, Int_t ir, const Double_t* w) const;
+  /** 
+   * Interpolate the table 
+   * 
+   * @param t  @f$ t=(x-\Delta_p)/\xi@f$ - must be InRangeT 
+   * @param r  @f$ r=\sigma'/\xi@f$ - must be InRangeR 
+   * 
+   * @return @f$ g(t;r)@f$ 
+   */
+  Double_t Eval(Double_t t, Double_t r) const;
+  /** 
+   * @return Largest interpolation error (relative to peak) found
+   * when building the table
+   */
+  Double_t MaxError() const { return fMaxError; }
+protected:
+  /** 
+   * Constructor - builds the table 
+   */
+  AliLandauGausTable();
+  /** 
+   * Calculate the Catmull-Rom weights for the fraction @a u 
+   * 
+   * @param u  Fraction within grid cell 
+   * @param w  On return, the 4 weights
+   */
+  static void Weights(Double_t u, Double_t* w);
+  /** 
+   * Fill the table and check the interpolation error 
+   */
+  void Build();
+  /** Step in @f$ t@f$ */
+  Double_t fDT;
+  /** Step in @f$ \log r@f$ */
+  Double_t fDLogR;
+  /** Least @f$ t@f$ that can be interpolated */
+  Double_t fTLow;
+  /** Largest @f$ t@f$ that can be interpolated */
+  Double_t fTHigh;
+  /** Least @f$ r@f$ that can be interpolated */
+  Double_t fRLow;
+  /** Largest @f$ r@f$ that can be interpolated */
+  Double_t fRHigh;
+  /** Largest interpolation error */
+  Double_t fMaxError;
+  /** The values, row (@f$ r@f$) major */
+  TArrayD  fValues;
+};
 //____________________________________________________________________
 inline Bool_t
 AliLandauGaus::EnableSigmaShift(Short_t val)
@@ -484,6 +690,14 @@ AliLandauGaus::EnableSigmaShift(Short_t val)
   return enabled;
 }
 //____________________________________________________________________
+inline Bool_t
+AliLandauGaus::EnableTable(Short_t val)
+{
+  static Bool_t enabled = false;
+  if (val >= 0) enabled = val == 1;
+  return enabled;
+}
+//____________________________________________________________________
 inline void
 AliLandauGaus::IPars(Int_t i, Double_t& delta, Double_t& xi, Double_t& sigma)
 {
@@ -528,6 +742,23 @@ AliLandauGaus::F(Double_t x, Double_t delta, Double_t xi,
 		 Double_t sigma, Double_t sigmaN)
 {
   if (xi <= 0) return 0;
+  if (EnableTable()) { 
+    const AliLandauGausTable& table = AliLandauGausTable::Instance();
+    const Double_t sigma1 = (sigmaN == 0 ? sigma : 
+			     TMath::Sqrt(sigmaN*sigmaN + sigma*sigma));
+    const Double_t t      = (x - delta) / xi;
+    const Double_t r      = sigma1 / xi;
+    if (table.InRangeR(r) && table.InRangeT(t)) 
+      return table.Eval(t, r) / xi;
+  }
+  return FExact(x, delta, xi, sigma, sigmaN);
+}
+//____________________________________________________________________
+inline Double_t 
+AliLandauGaus::FExact(Double_t x, Double_t delta, Double_t xi,
+		      Double_t sigma, Double_t sigmaN)
+{
+  if (xi <= 0) return 0;
 
   const Int_t    nSteps = NSteps();
   const Double_t nSigma = NSigma();
@@ -574,6 +805,49 @@ AliLandauGaus::Fn(Double_t x, Double_t delta, Double_t xi,
     result += a[i-2] * Fi(x,delta,xi,sigma,sigmaN,i);
   return result;
 }
+//____________________________________________________________________
+inline void
+AliLandauGaus::FnVector(Int_t nx, const Double_t* x, Double_t* y, 
+			Double_t delta, Double_t xi, 
+			Double_t sigma, Double_t sigmaN, Int_t n, 
+			const Double_t* a)
+{
+  for (Int_t j = 0; j < nx; j++) y[j] = 0;
+  if (xi <= 0) return;
+
+  const Bool_t useTable = EnableTable();
+  for (Int_t i = 1; i <= n; i++) { 
+    const Double_t ai     = (i == 1 ? 1 : a[i-2]);
+    Double_t       deltaI = delta;
+    Double_t       xiI    = xi;
+    Double_t       sigmaI = sigma;
+    IPars(i, deltaI, xiI, sigmaI);
+    if (ai == 0) continue;
+    if (sigmaI < 1e-10) { 
+      // Fall back to landau 
+      for (Int_t j = 0; j < nx; j++) y[j] += ai * Fl(x[j], deltaI, xiI);
+      continue;
+    }
+    const Double_t sigma1 = (sigmaN == 0 ? sigmaI : 
+			     TMath::Sqrt(sigmaN*sigmaN + sigmaI*sigmaI));
+    const Double_t r      = sigma1 / xiI;
+    if (!useTable || !AliLandauGausTable::Instance().InRangeR(r)) { 
+      for (Int_t j = 0; j < nx; j++) 
+	y[j] += ai * FExact(x[j], deltaI, xiI, sigmaI, sigmaN);
+      continue;
+    }
+    const AliLandauGausTable& table = AliLandauGausTable::Instance();
+    const Double_t invXi = 1 / xiI;
+    Int_t    ir;
+    Double_t w[4];
+    table.RWeights(r, ir, w);
+    for (Int_t j = 0; j < nx; j++) { 
+      const Double_t t = (x[j] - deltaI) * invXi;
+      y[j] += ai * (table.InRangeT(t) ? table.Eval(t, ir, w) * invXi : 
+		    FExact(x[j], deltaI, xiI, sigmaI, sigmaN));
+    }
+  }
+}
 
 //____________________________________________________________________
 inline Double_t 
@@ -632,6 +906,107 @@ AliLandauGaus::DFidPar(Double_t x,
 }
 
 
+//____________________________________________________________________
+inline const AliLandauGausTable&
+AliLandauGausTable::Instance()
+{
+  static AliLandauGausTable table;
+  return table;
+}
+//____________________________________________________________________
+inline 
+AliLandauGausTable::AliLandauGausTable()
+  : fDT((TMax()-TMin())/(NT()-1)),
+    fDLogR((TMath::Log(RMax())-TMath::Log(RMin()))/(NR()-1)),
+    fTLow(TMin()+fDT),
+    fTHigh(TMax()-fDT),
+    fRLow(RMin()*TMath::Exp(fDLogR)),
+    fRHigh(RMax()*TMath::Exp(-fDLogR)),
+    fMaxError(0),
+    fValues(NT()*NR())
+{
+  Build();
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::Weights(Double_t u, Double_t* w)
+{
+  const Double_t u2 = u * u;
+  const Double_t u3 = u2 * u;
+  w[0] = -0.5 * u3 +       u2 - 0.5 * u;
+  w[1] =  1.5 * u3 - 2.5 * u2 + 1;
+  w[2] = -1.5 * u3 + 2.0 * u2 + 0.5 * u;
+  w[3] =  0.5 * u3 - 0.5 * u2;
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::RWeights(Double_t r, Int_t& ir, Double_t* w) const
+{
+  const Double_t v = (TMath::Log(r) - TMath::Log(RMin())) / fDLogR;
+  const Int_t    k = TMath::Min(Int_t(v), NR() - 3);
+  ir               = k - 1;
+  Weights(v - k, w);
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGausTable::Eval(Double_t t, Int_t ir, const Double_t* w) const
+{
+  const Int_t    nt = NT();
+  const Double_t v  = (t - TMin()) / fDT;
+  const Int_t    k  = TMath::Min(Int_t(v), nt - 3);
+  Double_t wt[4];
+  Weights(v - k, wt);
+  
+  const Double_t* p   = fValues.GetArray() + ir * nt + k - 1;
+  Double_t        ret = 0;
+  for (Int_t j = 0; j < 4; j++, p += nt) 
+    ret += w[j] * (wt[0]*p[0] + wt[1]*p[1] + wt[2]*p[2] + wt[3]*p[3]);
+  // Interpolation can undershoot in the far tails 
+  return ret < 0 ? 0 : ret;
+}
+//____________________________________________________________________
+inline Double_t
+AliLandauGausTable::Eval(Double_t t, Double_t r) const
+{
+  Int_t    ir;
+  Double_t w[4];
+  RWeights(r, ir, w);
+  return Eval(t, ir, w);
+}
+//____________________________________________________________________
+inline void
+AliLandauGausTable::Build()
+{
+  const Int_t nt = NT();
+  const Int_t nr = NR();
+  for (Int_t ir = 0; ir < nr; ir++) { 
+    const Double_t r = RMin() * TMath::Exp(ir * fDLogR);
+    for (Int_t it = 0; it < nt; it++) 
+      fValues[ir*nt+it] = AliLandauGaus::FExact(TMin()+it*fDT, 0, 1, r, 0);
+  }
+
+  // Check the interpolation half-way between the nodes. Every 4th
+  // row and every 8th column is enough to get the largest error.
+  fMaxError = 0;
+  for (Int_t ir = 1; ir < nr - 2; ir += 4) { 
+    const Double_t r    = RMin() * TMath::Exp((ir + .5) * fDLogR);
+    Double_t       peak = 0;
+    for (Int_t it = 0; it < nt; it++) 
+      peak = TMath::Max(peak, fValues[ir*nt+it]);
+    if (peak <= 0) continue;
+    for (Int_t it = 1; it < nt - 2; it += 8) { 
+      const Double_t t     = TMin() + (it + .5) * fDT;
+      const Double_t exact = AliLandauGaus::FExact(t, 0, 1, r, 0);
+      const Double_t err   = TMath::Abs(Eval(t, r) - exact) / peak;
+      fMaxError            = TMath::Max(fMaxError, err);
+    }
+  }
+  if (fMaxError > Tolerance()) 
+    ::Warning("AliLandauGausTable::Build", 
+	      "Largest interpolation error %g exceeds tolerance %g",
+	      fMaxError, Tolerance());
+}
+
 //____________________________________________________________________
 inline Color_t
 AliLandauGaus::GetIColor(Int_t i) 
@@ -5,8 +5,12 @@
 // It must be prepared by adding all required single cuts,
 // and then with a logical expression which combines all cuts
 // with the "AND", "OR" and "NOT" operators.
+// The expression is compiled once into a flat program, which
+// evaluates each cut only when its result is needed.
 //
 
+#include <string.h>
+
 #include "AliLog.h"
 
 #include "AliRsnExpression.h"
@@ -27,13 +31,22 @@ AliRsnCutSet::AliRsnCutSet() :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fShortCircuit(kTRUE),
+   fUseTiming(kFALSE),
+   fProgram(),
+   fEvaluated(),
+   fNCalls(0),
+   fNPassed(0),
+   fNCutCalls(0),
+   fTimer()
 {
 //
 // Constructor without name (not recommended)
 //
 
    fBoolValues = new Bool_t[1];
+   fTimer.Reset();
    AliRsnExpression::fgCutSet = this;
 }
 
@@ -48,7 +61,15 @@ AliRsnCutSet::AliRsnCutSet(const char *name, RSNTARGET target) :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fShortCircuit(kTRUE),
+   fUseTiming(kFALSE),
+   fProgram(),
+   fEvaluated(),
+   fNCalls(0),
+   fNPassed(0),
+   fNCutCalls(0),
+   fTimer()
 {
 //
 // Constructor with argument name (recommended)
@@ -56,6 +77,7 @@ AliRsnCutSet::AliRsnCutSet(const char *name, RSNTARGET target) :
 
    fBoolValues = new Bool_t[1];
    fExpression = 0;
+   fTimer.Reset();
    AliRsnExpression::fgCutSet = this;
 }
 
@@ -68,12 +90,21 @@ AliRsnCutSet::AliRsnCutSet(const AliRsnCutSet &copy) :
    fCutSchemeIndexed(copy.fCutSchemeIndexed),
    fBoolValues(0),
    fIsScheme(copy.fIsScheme),
-   fExpression(copy.fExpression),
+   fExpression(0),
    fMonitors(copy.fMonitors),
-   fUseMonitor(copy.fUseMonitor)
+   fUseMonitor(copy.fUseMonitor),
+   fShortCircuit(copy.fShortCircuit),
+   fUseTiming(copy.fUseTiming),
+   fProgram(),
+   fEvaluated(),
+   fNCalls(0),
+   fNPassed(0),
+   fNCutCalls(0),
+   fTimer()
 {
 //
-// Copy constructor
+// Copy constructor.
+// The expression is not shared, it is compiled again when needed.
 //
 
    Int_t i;
@@ -82,6 +113,7 @@ AliRsnCutSet::AliRsnCutSet(const AliRsnCutSet &copy) :
       fBoolValues[i] = copy.fBoolValues[i];
    }
 
+   fTimer.Reset();
    AliRsnExpression::fgCutSet = this;
 }
 
@@ -101,9 +133,13 @@ AliRsnCutSet &AliRsnCutSet::operator=(const AliRsnCutSet &copy)
    fCutScheme = copy.fCutScheme;
    fCutSchemeIndexed = copy.fCutSchemeIndexed;
    fIsScheme = copy.fIsScheme;
-   fExpression = copy.fExpression;
+   delete fExpression;
+   fExpression = 0;
+   fProgram.clear();
    fMonitors = copy.fMonitors;
    fUseMonitor = copy.fUseMonitor;
+   fShortCircuit = copy.fShortCircuit;
+   fUseTiming = copy.fUseTiming;
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -151,6 +187,7 @@ void AliRsnCutSet::AddCut(AliRsnCut *cut)
    AliInfo(Form("====> Adding a new cut: [%s]", cut->GetName()));
    //cut->Print();
    fNumOfCuts++;
+   fProgram.clear();
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -182,20 +219,34 @@ Bool_t AliRsnCutSet::IsSelected(TObject *object)
 {
 //
 // Checks an object according to the cut expression defined here.
+// With a cut scheme, by default only the cuts needed to decide
+// are evaluated (e.g. none after the first failed one in "a&b&c"),
+// the values of the others in fBoolValues are not meaningful.
+// SetShortCircuit(kFALSE) evaluates all cuts for every object.
 //
 
    Int_t i;
 
    if (!fNumOfCuts) return kTRUE;
 
+   fNCalls++;
+   if (fUseTiming) fTimer.Start(kFALSE);
+
    Bool_t boolReturn = kTRUE;
-   AliRsnCut *cut;
-   for (i = 0; i < fNumOfCuts; i++) {
-      cut = (AliRsnCut *)fCuts.At(i);
-      fBoolValues[i] = cut->IsSelected(object);
+   if (fIsScheme && fShortCircuit) {
+      if (fProgram.empty()) Compile();
+      memset(&fEvaluated[0], 0, fNumOfCuts);
+      boolReturn = Run(object);
+   } else {
+      AliRsnCut *cut;
+      for (i = 0; i < fNumOfCuts; i++) {
+         cut = (AliRsnCut *)fCuts.UncheckedAt(i);
+         fBoolValues[i] = cut->IsSelected(object);
+      }
+      fNCutCalls += fNumOfCuts;
+      if (fIsScheme) boolReturn = Passed();
    }
-
-   if (fIsScheme) boolReturn = Passed();
+   if (boolReturn) fNPassed++;
 
    // fill monitoring info
    if (boolReturn && fUseMonitor) {
@@ -208,6 +259,7 @@ Bool_t AliRsnCutSet::IsSelected(TObject *object)
       }
    }
 
+   if (fUseTiming) fTimer.Stop();
    return boolReturn;
 }
 
@@ -224,6 +276,9 @@ void AliRsnCutSet::SetCutScheme(const char *theValue)
    fCutScheme = theValue;
    SetCutSchemeIndexed(theValue);
    fIsScheme = kTRUE;
+   delete fExpression;
+   fExpression = 0;
+   fProgram.clear();
    AliDebug(AliLog::kDebug, "->");
 }
 
@@ -264,7 +319,23 @@ Bool_t AliRsnCutSet::Passed()
 {
 //
 // Combines the cuts according to expression
-// and gives a global response to the cut check
+// and gives a global response to the cut check,
+// using the values already stored in fBoolValues
+//
+
+   if (fProgram.empty()) Compile();
+
+   if (fCuts.IsEmpty()) return kTRUE;
+
+   return Run(0);
+}
+
+//_____________________________________________________________________________
+void AliRsnCutSet::Compile()
+{
+//
+// Parses the cut expression and compiles it into a flat program
+// (see AliRsnExpression::Compile), which is executed by Run()
 //
 
    AliRsnExpression::fgCutSet = this;
@@ -273,9 +344,65 @@ Bool_t AliRsnCutSet::Passed()
       AliDebug(AliLog::kDebug, "fExpression was created.");
    }
 
-   if (fCuts.IsEmpty()) return kTRUE;
+   fProgram.clear();
+   if (!fExpression->Compile(fProgram, fNumOfCuts))
+      AliError(Form("Cut scheme '%s' of cut set '%s' is not valid, invalid parts are false", fCutScheme.Data(), GetName()));
+   fEvaluated.assign(fNumOfCuts > 0 ? fNumOfCuts : 1, 0);
+}
+
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::Run(TObject *object)
+{
+//
+// Executes the compiled cut scheme.
+// With an object, each cut is evaluated on it when its value is
+// needed for the first time, otherwise the values in fBoolValues are used.
+//
+
+   const Int_t *prg = &fProgram[0];
+   const Int_t  n   = fProgram.size();
+   Bool_t result = kFALSE;
+
+   for (Int_t ip = 0; ip < n; ip += 2) {
+      switch (prg[ip]) {
+         case AliRsnExpression::kPrgLoad : {
+            Int_t icut = prg[ip + 1];
+            if (object && !fEvaluated[icut]) {
+               fBoolValues[icut] = ((AliRsnCut *)fCuts.UncheckedAt(icut))->IsSelected(object);
+               fEvaluated[icut] = 1;
+               fNCutCalls++;
+            }
+            result = fBoolValues[icut];
+            break;
+         }
+         case AliRsnExpression::kPrgNot :
+            result = !result;
+            break;
+         case AliRsnExpression::kPrgJumpIfFalse :
+            if (!result) ip = prg[ip + 1] - 2;
+            break;
+         case AliRsnExpression::kPrgJumpIfTrue :
+            if (result) ip = prg[ip + 1] - 2;
+            break;
+         default :
+            result = kFALSE;
+      }
+   }
+
+   return result;
+}
+
+//_____________________________________________________________________________
+void AliRsnCutSet::ResetCounters()
+{
+//
+// Resets the counters of checked objects, cut evaluations and the timer
+//
 
-   return fExpression->Value(*GetCuts());
+   fNCalls = 0;
+   fNPassed = 0;
+   fNCutCalls = 0;
+   fTimer.Reset();
 }
 
 //_____________________________________________________________________________
@@ -360,6 +487,10 @@ void AliRsnCutSet::PrintSetInfo()
       cut = (AliRsnCut *) fCuts.At(i);
       if (cut) AliInfo(Form("%d %d", i, fBoolValues[i]));
    }
+   AliInfo(Form("Checked: %lld, selected: %lld, cut evaluations: %lld (%.2f per object)",
+                fNCalls, fNPassed, fNCutCalls, (fNCalls ? (Double_t)fNCutCalls / fNCalls : 0.)));
+   if (fUseTiming)
+      AliInfo(Form("Time in IsSelected: cpu %.3f s, real %.3f s", fTimer.CpuTime(), fTimer.RealTime()));
    AliInfo("========== END Rsn Cut Mgr info ==============");
 }
 
@@ -5,6 +5,8 @@
 // It must be prepared by adding all required single cuts,
 // and then with a logical expression which combines all cuts
 // with the "AND", "OR" and "NOT" operators.
+// The expression is compiled once into a flat program, which
+// evaluates each cut only when its result is needed.
 //
 // author: M. Vala (martin.vala@cern.ch)
 //
@@ -12,8 +14,10 @@
 #ifndef ALIRSNCUTSET_H
 #define ALIRSNCUTSET_H
 
+#include <vector>
 #include <TNamed.h>
 #include <TObjArray.h>
+#include <TStopwatch.h>
 
 #include "AliRsnTarget.h"
 #include "AliRsnListOutput.h"
@@ -62,8 +66,22 @@ public:
 
    void UseMonitor(Bool_t useMonitor=kTRUE) { fUseMonitor = useMonitor; }
 
+   void SetShortCircuit(Bool_t value = kTRUE) { fShortCircuit = value; }
+   Bool_t IsShortCircuit() const { return fShortCircuit; }
+   void SetTiming(Bool_t value = kTRUE) { fUseTiming = value; }
+
+   Long64_t GetNCalls() const { return fNCalls; }
+   Long64_t GetNPassed() const { return fNPassed; }
+   Long64_t GetNCutCalls() const { return fNCutCalls; }
+   Double_t GetCpuTime() { return fTimer.CpuTime(); }
+   Double_t GetRealTime() { return fTimer.RealTime(); }
+   void     ResetCounters();
+
 private:
 
+   void      Compile();
+   Bool_t    Run(TObject *object);
+
    TObjArray         fCuts;                  // array of cuts
    Int_t             fNumOfCuts;             // number of cuts
    TString           fCutScheme;             // cut scheme
@@ -75,8 +93,17 @@ private:
    AliRsnExpression *fExpression;            // pointer to AliRsnExpression
    TObjArray         fMonitors;              // array of monitor object
    Bool_t            fUseMonitor;            // flag if monitoring should be used
+   Bool_t            fShortCircuit;          // evaluate the cuts only when needed by the scheme
+   Bool_t            fUseTiming;             // flag if the time spent in IsSelected should be measured
+
+   std::vector<Int_t>  fProgram;             //! compiled cut scheme (see AliRsnExpression::EProgramOp)
+   std::vector<Char_t> fEvaluated;           //! cuts already evaluated for the current object
+   Long64_t          fNCalls;                //! number of checked objects
+   Long64_t          fNPassed;               //! number of selected objects
+   Long64_t          fNCutCalls;             //! number of single cut evaluations
+   TStopwatch        fTimer;                 //! time spent in IsSelected (with SetTiming)
 
-   ClassDef(AliRsnCutSet, 3)   // ROOT dictionary
+   ClassDef(AliRsnCutSet, 4)   // ROOT dictionary
 };
 
 #endif
@@ -133,6 +133,60 @@ Bool_t AliRsnExpression::Value(TObjArray &vars)
    return kFALSE;
 }
 
+//______________________________________________________________________________
+Bool_t AliRsnExpression::Compile(std::vector<Int_t> &program, Int_t nVars) const
+{
+   // Append to the program the instructions giving the same result as Value(),
+   // with short-circuit evaluation of '&' and '|'.
+   // Returns kFALSE if the expression (or a part of it) is not valid.
+
+   if (fArg2 == 0 && fVname.IsNull()) {
+      AliError("Expression undefined.");
+      program.push_back(kPrgFalse);
+      program.push_back(0);
+      return kFALSE;
+   }
+
+   switch (fOperator) {
+
+      case kOpOR :
+      case kOpAND : {
+         Bool_t ok = fArg1->Compile(program, nVars);
+         program.push_back(fOperator == kOpAND ? kPrgJumpIfFalse : kPrgJumpIfTrue);
+         program.push_back(0);
+         Int_t jump = program.size() - 1;
+         ok = fArg2->Compile(program, nVars) && ok;
+         program[jump] = program.size();
+         return ok;
+      }
+
+      case kOpNOT : {
+         Bool_t ok = fArg2->Compile(program, nVars);
+         program.push_back(kPrgNot);
+         program.push_back(0);
+         return ok;
+      }
+
+      case 0 : {
+         Int_t index = fVname.Atoi();
+         if (index < 0 || index >= nVars) {
+            AliError(Form("Unknown variable '%s' in expression.", fVname.Data()));
+            program.push_back(kPrgFalse);
+            program.push_back(0);
+            return kFALSE;
+         }
+         program.push_back(kPrgLoad);
+         program.push_back(index);
+         return kTRUE;
+      }
+
+      default:
+         AliError("Illegal operator in expression!");
+   }
+   program.push_back(kPrgFalse);
+   program.push_back(0);
+   return kFALSE;
+}
 
 //______________________________________________________________________________
 TString AliRsnExpression::Unparse() const
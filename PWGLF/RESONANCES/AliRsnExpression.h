@@ -10,6 +10,7 @@
 #ifndef ALIRSNEXPRESSION_H
 #define ALIRSNEXPRESSION_H
 
+#include <vector>
 #include <TObject.h>
 
 class TObjArray;
@@ -27,6 +28,16 @@ public:
       kOpNOT      // Unary negation '!'
    };
 
+   // instructions of a compiled expression (see AliRsnCutSet),
+   // each one followed by its argument
+   enum EProgramOp {
+      kPrgLoad,        // result = value of cut <argument>
+      kPrgNot,         // result = !result
+      kPrgJumpIfFalse, // skip to instruction <argument> if result is false
+      kPrgJumpIfTrue,  // skip to instruction <argument> if result is true
+      kPrgFalse        // result = false
+   };
+
    AliRsnExpression() : fVname(0), fArg1(0), fArg2(0), fOperator(0)  {}
    AliRsnExpression(TString exp);
    virtual    ~AliRsnExpression();
@@ -35,6 +46,7 @@ public:
 
    virtual Bool_t     Value(TObjArray &vars);
    virtual TString     Unparse() const;
+   Bool_t              Compile(std::vector<Int_t> &program, Int_t nVars) const;
 
    void SetCutSet(AliRsnCutSet *const theValue) { fgCutSet = theValue; }
    AliRsnCutSet *GetCutSet() const { return fgCutSet; }
@@ -13,10 +13,15 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <Riostream.h>
 
 #include <TH1.h>
+#include <THnSparse.h>
 #include <TList.h>
+#include <TROOT.h>
 #include <TTree.h>
 #include <TStopwatch.h>
 #include "TRandom.h"
@@ -27,6 +32,7 @@
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
+#include "AliPIDResponseCache.h"
 #include "AliAnalysisUtils.h"
 
 #include "AliESDtrackCuts.h"
@@ -42,6 +48,7 @@
 #include "AliQnCorrectionsQnVector.h"
 
 #include "AliRsnCutSet.h"
+#include "AliRsnMiniAxis.h"
 #include "AliRsnMiniPair.h"
 #include "AliRsnMiniEvent.h"
 #include "AliRsnMiniParticle.h"
@@ -88,8 +95,14 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
+   fEvStore(),
+   fEvBufferVz(),
+   fEvBufferMult(),
+   fEvBufferAngle(),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
+   fMixInMemory(kFALSE),
+   fMixNThreads(1),
    fCheckDecay(kTRUE),
    fMaxNDaughters(-1),
    fCheckP(kFALSE),
@@ -144,8 +157,14 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const char *name, Bool_t useMC) :
    fTriggerAna(0x0),
    fESDtrackCuts(0x0),
    fMiniEvent(0x0),
+   fEvStore(),
+   fEvBufferVz(),
+   fEvBufferMult(),
+   fEvBufferAngle(),
    fBigOutput(kFALSE),
    fMixPrintRefresh(-1),
+   fMixInMemory(kFALSE),
+   fMixNThreads(1),
    fCheckDecay(kTRUE),
    fMaxNDaughters(-1),
    fCheckP(kFALSE),
@@ -205,8 +224,14 @@ AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask(const AliRsnMiniAnalysisTask &cop
    fTriggerAna(copy.fTriggerAna),
    fESDtrackCuts(copy.fESDtrackCuts),
    fMiniEvent(0x0),
+   fEvStore(),
+   fEvBufferVz(),
+   fEvBufferMult(),
+   fEvBufferAngle(),
    fBigOutput(copy.fBigOutput),
    fMixPrintRefresh(copy.fMixPrintRefresh),
+   fMixInMemory(copy.fMixInMemory),
+   fMixNThreads(copy.fMixNThreads),
    fCheckDecay(copy.fCheckDecay),
    fMaxNDaughters(copy.fMaxNDaughters),
    fCheckP(copy.fCheckP),
@@ -270,6 +295,8 @@ AliRsnMiniAnalysisTask &AliRsnMiniAnalysisTask::operator=(const AliRsnMiniAnalys
    fESDtrackCuts = copy.fESDtrackCuts;
    fBigOutput = copy.fBigOutput;
    fMixPrintRefresh = copy.fMixPrintRefresh;
+   fMixInMemory = copy.fMixInMemory;
+   fMixNThreads = copy.fMixNThreads;
    fCheckDecay = copy.fCheckDecay;
    fMaxNDaughters = copy.fMaxNDaughters;
    fCheckP = copy.fCheckP;
@@ -298,6 +325,7 @@ AliRsnMiniAnalysisTask::~AliRsnMiniAnalysisTask()
       delete fOutput;
       delete fEvBuffer;
    }
+   ClearEventStore();
 }
 
 //__________________________________________________________________________________________________
@@ -402,6 +430,10 @@ void AliRsnMiniAnalysisTask::UserCreateOutputObjects()
    if (fMiniEvent) delete fMiniEvent;
    fEvBuffer = new TTree("EventBuffer", "Temporary buffer for mini events");
    fEvBuffer->Branch("events", "AliRsnMiniEvent", &fMiniEvent);
+   ClearEventStore();
+   fEvBufferVz.clear();
+   fEvBufferMult.clear();
+   fEvBufferAngle.clear();
 
    // create one histogram per each stored definition (event histograms)
    Int_t i, ndef = fHistograms.GetEntries();
@@ -458,10 +490,16 @@ void AliRsnMiniAnalysisTask::UserExec(Option_t *)
    if (fMiniEvent->IsEmpty()) {
       AliDebugClass(2, Form("Rejecting empty event #%d", fEvNum));
    } else {
-      Int_t id = fEvBuffer->GetEntries();
+      Int_t id = (fMixInMemory ? (Int_t)fEvStore.size() : (Int_t)fEvBuffer->GetEntries());
       AliDebugClass(2, Form("Adding event #%d with ID = %d", fEvNum, id));
       fMiniEvent->ID() = id;
-      fEvBuffer->Fill();
+      if (fMixInMemory)
+         fEvStore.push_back(new AliRsnMiniEvent(*fMiniEvent));
+      else
+         fEvBuffer->Fill();
+      fEvBufferVz.push_back(fMiniEvent->Vz());
+      fEvBufferMult.push_back(fMiniEvent->Mult());
+      fEvBufferAngle.push_back(fMiniEvent->Angle());
    }
 
    // post data for computed stuff
@@ -478,16 +516,39 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
 // Here a loop is done on each of these events, and both single-event and mixing are computed
 //
 
+   // usage of the n-sigma values shared by the PID cuts of the event loop
+   AliPIDResponseCache *pidCache = AliPIDResponseCache::Instance();
+   if (pidCache->IsEnabled())
+      AliDebugClass(1, Form("[%s] PID n-sigma cache: %lld hits, %lld misses, %lld not cached", GetName(), pidCache->GetNHits(), pidCache->GetNMisses(), pidCache->GetNUncached()));
+
    // security code: reassign the buffer to the mini-event cursor
    fEvBuffer->SetBranchAddress("events", &fMiniEvent);
    TStopwatch timer;
    // prepare variables
-   Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
+   Int_t ievt, nEvents = (fMixInMemory ? (Int_t)fEvStore.size() : (Int_t)fEvBuffer->GetEntries());
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill;
    AliRsnMiniOutput *def = 0x0;
+   AliRsnMiniEvent *event = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
+   // outputs with the same pair loop are filled together, with the pairs of the first of them
+   std::vector<Bool_t> pairLoopShared(nDefs, kFALSE);
+   std::vector<std::vector<AliRsnMiniOutput *> > pairLoopOutputs(nDefs);
+   std::vector<std::vector<Int_t> > pairLoopIndices(nDefs);
+   for (idef = 0; idef < nDefs; idef++) {
+      def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def || pairLoopShared[idef]) continue;
+      for (Int_t jdef = idef + 1; jdef < nDefs; jdef++) {
+         AliRsnMiniOutput *other = (AliRsnMiniOutput *)fHistograms[jdef];
+         if (pairLoopShared[jdef] || !def->HasSamePairLoop(other)) continue;
+         AliDebugClass(1, Form("Output '%s' is filled in the pair loop of '%s'", other->GetName(), def->GetName()));
+         pairLoopOutputs[idef].push_back(other);
+         pairLoopIndices[idef].push_back(jdef);
+         pairLoopShared[jdef] = kTRUE;
+      }
+   }
+
    Int_t printNum = fMixPrintRefresh;
    if (printNum < 0) {
       if (nEvents>1e5) printNum=nEvents/100;
@@ -502,7 +563,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
-      fEvBuffer->GetEntry(ievt);
+      event = GetBufferedEvent(ievt);
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -510,30 +571,30 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       // fill
       for (idef = 0; idef < nDefs; idef++) {
          def = (AliRsnMiniOutput *)fHistograms[idef];
-         if (!def) continue;
+         if (!def || pairLoopShared[idef]) continue;
          compType = def->GetComputation();
          // execute computation in the appropriate way
          switch (compType) {
             case AliRsnMiniOutput::kEventOnly:
                //AliDebugClass(1, Form("Event %d, def '%s': event-value histogram filling", ievt, def->GetName()));
                ifill = 1;
-               def->FillEvent(fMiniEvent, &fValues);
+               def->FillEvent(event, &fValues);
                break;
             case AliRsnMiniOutput::kTruePair:
                //AliDebugClass(1, Form("Event %d, def '%s': true-pair histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues, kTRUE, &pairLoopOutputs[idef]);
                break;
             case AliRsnMiniOutput::kTrackPair:
                //AliDebugClass(1, Form("Event %d, def '%s': pair-value histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues, kTRUE, &pairLoopOutputs[idef]);
                break;
             case AliRsnMiniOutput::kTrackPairRotated1:
                //AliDebugClass(1, Form("Event %d, def '%s': rotated (1) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues, kTRUE, &pairLoopOutputs[idef]);
                break;
             case AliRsnMiniOutput::kTrackPairRotated2:
                //AliDebugClass(1, Form("Event %d, def '%s': rotated (2) background histogram filling", ievt, def->GetName()));
-               ifill = def->FillPair(fMiniEvent, fMiniEvent, &fValues);
+               ifill = def->FillPair(event, event, &fValues, kTRUE, &pairLoopOutputs[idef]);
                break;
             default:
                // other kinds are processed elsewhere
@@ -548,89 +609,85 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // if no mixing is required, stop here and post the output
    if (fNMix < 1) {
       AliDebugClass(2, "Stopping here, since no mixing is required");
+      ClearEventStore();
       PostData(1, fOutput);
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
+   // mixing partners of each event
+   std::vector<std::vector<Int_t> > matched;
 
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
-   // search for good matchings
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
-      }
-      if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
-         // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
-         // check that the found good events has not enough matches already
-         if (nmatched[imix] >= fNMix) continue;
-         // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
-         nmatched[ievt]++;
-         nmatched[imix]++;
-         if (nmatched[ievt] >= fNMix) break;
+   // mixing variables of the buffered events, normally collected in UserExec
+   if ((Int_t)fEvBufferVz.size() != nEvents || (Int_t)fEvBufferMult.size() != nEvents || (Int_t)fEvBufferAngle.size() != nEvents) {
+      fEvBufferVz.resize(nEvents);
+      fEvBufferMult.resize(nEvents);
+      fEvBufferAngle.resize(nEvents);
+      for (ievt = 0; ievt < nEvents; ievt++) {
+         event = GetBufferedEvent(ievt);
+         fEvBufferVz[ievt]    = event->Vz();
+         fEvBufferMult[ievt]  = event->Mult();
+         fEvBufferAngle[ievt] = event->Angle();
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
    }
 
+   // search for good matchings
+   FindMixingPartners(matched, printNum, timer);
+
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
-   // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
-      }
-      ifill = 0;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
-         fEvBuffer->GetEntry(imix);
-         for (idef = 0; idef < nDefs; idef++) {
-            def = (AliRsnMiniOutput *)fHistograms[idef];
-            if (!def) continue;
-            if (!def->IsTrackPairMix()) continue;
-            ifill += def->FillPair(&evMain, fMiniEvent, &fValues, kTRUE);
-            if (!def->IsSymmetric()) {
-               AliDebugClass(2, "Reflecting non symmetric pair");
-               ifill += def->FillPair(fMiniEvent, &evMain, &fValues, kFALSE);
+   // perform mixing, in several threads if requested and possible
+   Int_t nThreads = (fMixNThreads > 0 ? fMixNThreads : (Int_t)std::thread::hardware_concurrency());
+   nThreads = TMath::Max(1, TMath::Min(nThreads, nEvents));
+   if (nThreads > 1 && !fMixInMemory) {
+      AliWarning(Form("[%s] Mixed-pair filling in %d threads requires the mini-events in memory (SetMixInMemory), using one thread", GetName(), nThreads));
+      nThreads = 1;
+   }
+   if (nThreads > 1 && !IsMixingThreadSafe()) {
+      AliWarning(Form("[%s] Mixing outputs with pair cuts or with PhiV cannot be filled in several threads, using one thread", GetName()));
+      nThreads = 1;
+   }
+   if (nThreads > 1) {
+      AliInfo(Form("[%s] EventMixing in %d threads",GetName(),nThreads));
+      FillMixingParallel(matched, pairLoopShared, pairLoopIndices, nThreads);
+   } else {
+      UInt_t ipartner;
+      AliRsnMiniEvent *evMain = 0x0, *evCopy = 0x0;
+      for (ievt = 0; ievt < nEvents; ievt++) {
+         if (printNum&&(ievt%printNum==0)) {
+            AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
+            timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+         }
+         if (matched[ievt].empty()) continue;
+         ifill = 0;
+         // the cursor of the buffer tree is overwritten by the partners, keep a copy of the main event
+         evMain = GetBufferedEvent(ievt);
+         if (!fMixInMemory) evMain = evCopy = new AliRsnMiniEvent(*evMain);
+         for (ipartner = 0; ipartner < matched[ievt].size(); ipartner++) {
+            imix = matched[ievt][ipartner];
+            event = GetBufferedEvent(imix);
+            for (idef = 0; idef < nDefs; idef++) {
+               def = (AliRsnMiniOutput *)fHistograms[idef];
+               if (!def || pairLoopShared[idef]) continue;
+               if (!def->IsTrackPairMix()) continue;
+               ifill += def->FillPair(evMain, event, &fValues, kTRUE, &pairLoopOutputs[idef]);
+               if (!def->IsSymmetric()) {
+                  AliDebugClass(2, "Reflecting non symmetric pair");
+                  ifill += def->FillPair(event, evMain, &fValues, kFALSE, &pairLoopOutputs[idef]);
+               }
             }
          }
+         delete evCopy;
+         evCopy = 0x0;
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
+   ClearEventStore();
 
    /*
    OLD
@@ -1422,33 +1479,43 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
 //
 
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const
+{
+//
+// Check if two events are compatible, given their mixing variables.
+//
+
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
+         //AliDebugClass(2, Form("Events don't match due to a too large diff in Vz = %f", dv));
          return kFALSE;
       }
       if (dm > fMaxDiffMult ) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Mult = %f", event1->ID(), event2->ID(), dm));
+         //AliDebugClass(2, Form("Events don't match due to a too large diff in Mult = %f", dm));
          return kFALSE;
       }
       if (da > fMaxDiffAngle) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Angle = %f", event1->ID(), event2->ID(), da));
+         //AliDebugClass(2, Form("Events don't match due to a too large diff in Angle = %f", da));
          return kFALSE;
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1456,6 +1523,235 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FindMixingPartners(std::vector<std::vector<Int_t> > &matched, Int_t printNum, TStopwatch &timer) const
+{
+//
+// Search the mixing partners of the buffered events, using their mixing variables.
+// For each event, the following events are tested (restarting from the first after the last),
+// and the first ones matching and not yet mixed enough times are taken.
+// The events are sorted into buckets of multiplicity, of the size of the allowed difference
+// (or of the multiplicity bin for binned mixing), and within each bucket by position,
+// so that only the events in the neighbouring buckets have to be tested, in the same order.
+//
+
+   Int_t ievt, imix, nEvents = fEvBufferMult.size();
+   std::vector<Int_t> nmatched(nEvents, 0);
+   matched.assign(nEvents, std::vector<Int_t>());
+
+   // bucket of each event; all events are in a single bucket if the multiplicities cannot be bucketed
+   // (the bucket size is slightly enlarged as the multiplicity difference is computed in single precision)
+   std::vector<std::pair<Double_t, Int_t> > keys(nEvents);
+   Bool_t useBuckets = fContinuousMix ? (fMaxDiffMult > 0. && TMath::Finite(fMaxDiffMult)) : kTRUE;
+   Double_t bucketSize = fMaxDiffMult * (1. + 1E-5);
+   for (ievt = 0; ievt < nEvents && useBuckets; ievt++) {
+      if (fContinuousMix)
+         keys[ievt].first = TMath::Floor(fEvBufferMult[ievt] / bucketSize);
+      else
+         keys[ievt].first = (Int_t)(fEvBufferMult[ievt] / fMaxDiffMult);
+      keys[ievt].second = ievt;
+      if (!TMath::Finite(keys[ievt].first)) useBuckets = kFALSE;
+   }
+   for (ievt = 0; ievt < nEvents && !useBuckets; ievt++) {
+      keys[ievt].first  = 0.;
+      keys[ievt].second = ievt;
+   }
+   std::sort(keys.begin(), keys.end());
+   std::vector<Int_t> order(nEvents), bucket(nEvents), bucketStart;
+   std::vector<Double_t> bucketKey;
+   for (Int_t i = 0; i < nEvents; i++) {
+      if (i == 0 || keys[i].first != keys[i-1].first) {
+         bucketKey.push_back(keys[i].first);
+         bucketStart.push_back(i);
+      }
+      order[i] = keys[i].second;
+      bucket[keys[i].second] = bucketKey.size() - 1;
+   }
+   bucketStart.push_back(nEvents);
+
+   // cursors on the buckets to be tested, each walking through its bucket
+   // starting after the main event and restarting from the beginning
+   const Int_t maxBuckets = 3;
+   Int_t nBuckets, ib, first[maxBuckets], size[maxBuckets], offset[maxBuckets], step[maxBuckets];
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      if (printNum&&(ievt%printNum==0)) {
+         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
+         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
+      }
+      if (nmatched[ievt] >= fNMix) continue;
+
+      nBuckets = 0;
+      for (Int_t jb = bucket[ievt] - 1; jb <= bucket[ievt] + 1; jb++) {
+         if (jb < 0 || jb >= (Int_t)bucketKey.size()) continue;
+         if (jb != bucket[ievt] && (!fContinuousMix || !useBuckets || TMath::Abs(bucketKey[jb] - bucketKey[bucket[ievt]]) > 1.)) continue;
+         first[nBuckets]  = bucketStart[jb];
+         size[nBuckets]   = bucketStart[jb + 1] - bucketStart[jb];
+         offset[nBuckets] = std::upper_bound(order.begin() + bucketStart[jb], order.begin() + bucketStart[jb + 1], ievt) - order.begin() - bucketStart[jb];
+         step[nBuckets]   = 0;
+         nBuckets++;
+      }
+
+      while (nmatched[ievt] < fNMix) {
+         // next event after the main one among all buckets
+         Int_t best = -1, bestDistance = nEvents;
+         for (ib = 0; ib < nBuckets; ib++) {
+            if (step[ib] >= size[ib]) continue;
+            Int_t candidate = order[first[ib] + (offset[ib] + step[ib]) % size[ib]];
+            Int_t distance  = candidate > ievt ? candidate - ievt : candidate - ievt + nEvents;
+            if (distance < bestDistance) {
+               best = ib;
+               bestDistance = distance;
+            }
+         }
+         if (best < 0) break;
+         imix = order[first[best] + (offset[best] + step[best]) % size[best]];
+         step[best]++;
+         if (imix == ievt) continue;
+         // skip if events are not matched
+         if (!EventsMatch(fEvBufferVz[ievt], fEvBufferMult[ievt], fEvBufferAngle[ievt], fEvBufferVz[imix], fEvBufferMult[imix], fEvBufferAngle[imix])) continue;
+         // check that the array of good matches for mixed does not already contain main event
+         if (std::find(matched[imix].begin(), matched[imix].end(), ievt) != matched[imix].end()) continue;
+         // check that the found good events has not enough matches already
+         if (nmatched[imix] >= fNMix) continue;
+         // add new mixing candidate
+         matched[ievt].push_back(imix);
+         nmatched[ievt]++;
+         nmatched[imix]++;
+      }
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
+   }
+}
+
+//__________________________________________________________________________________________________
+AliRsnMiniEvent *AliRsnMiniAnalysisTask::GetBufferedEvent(Int_t ievt)
+{
+//
+// Return the buffered mini-event 'ievt', either kept in memory
+// or read from the buffer tree into the mini-event cursor.
+//
+
+   if (fMixInMemory) return fEvStore[ievt];
+   fEvBuffer->GetEntry(ievt);
+   return fMiniEvent;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::ClearEventStore()
+{
+//
+// Delete the mini-events kept in memory
+//
+
+   for (UInt_t i = 0; i < fEvStore.size(); i++) delete fEvStore[i];
+   fEvStore.clear();
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniAnalysisTask::IsMixingThreadSafe()
+{
+//
+// Check if the mixing outputs can be filled in several threads:
+// pair cuts store the values of the checked pair in their data members,
+// and the PhiV value draws from gRandom.
+//
+
+   Int_t idef, nDefs = fHistograms.GetEntries(), iaxis, ival;
+   for (idef = 0; idef < nDefs; idef++) {
+      AliRsnMiniOutput *def = (AliRsnMiniOutput *)fHistograms[idef];
+      if (!def || !def->IsTrackPairMix()) continue;
+      if (def->GetPairCuts()) return kFALSE;
+      for (iaxis = 0; def->GetAxis(iaxis); iaxis++) {
+         ival = def->GetAxis(iaxis)->GetValueID();
+         if (ival < 0 || ival >= fValues.GetEntriesFast()) continue;
+         AliRsnMiniValue *val = (AliRsnMiniValue *)fValues[ival];
+         if (val && val->GetType() == AliRsnMiniValue::kPhiV) return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniAnalysisTask::FillMixingParallel(const std::vector<std::vector<Int_t> > &matched, const std::vector<Bool_t> &pairLoopShared,
+                                                const std::vector<std::vector<Int_t> > &pairLoopIndices, Int_t nThreads)
+{
+//
+// Fill the mixed pairs of the mini-events kept in memory in 'nThreads' threads.
+// Each thread takes blocks of main events and fills private copies of the mixing outputs,
+// which are added to the outputs at the end. All pairs are filled with unit weight,
+// so that the bin contents do not depend on the number of threads.
+//
+
+   Int_t ithread, idef, nDefs = fHistograms.GetEntries(), nEvents = fEvStore.size();
+   AliRsnMiniOutput *def = 0x0;
+
+   // private copies of the mixing definitions, filling private copies of their output objects
+   std::vector<std::vector<AliRsnMiniOutput *> > outputs(nThreads, std::vector<AliRsnMiniOutput *>(nDefs, (AliRsnMiniOutput *)0x0));
+   std::vector<TList *> lists(nThreads, (TList *)0x0);
+   for (ithread = 0; ithread < nThreads; ithread++) {
+      lists[ithread] = new TList;
+      lists[ithread]->SetOwner(kTRUE);
+      for (idef = 0; idef < nDefs; idef++) {
+         def = (AliRsnMiniOutput *)fHistograms[idef];
+         if (!def || !def->IsTrackPairMix() || !def->GetOutputObject()) continue;
+         TObject *copy = def->GetOutputObject()->Clone();
+         if (copy->InheritsFrom(TH1::Class())) {
+            ((TH1 *)copy)->SetDirectory(0);
+            ((TH1 *)copy)->Reset();
+         } else if (copy->InheritsFrom(THnBase::Class())) {
+            ((THnBase *)copy)->Reset();
+         }
+         lists[ithread]->Add(copy);
+         outputs[ithread][idef] = new AliRsnMiniOutput(*def);
+         outputs[ithread][idef]->SetOutputList(lists[ithread], lists[ithread]->GetEntries() - 1);
+      }
+   }
+
+   ROOT::EnableThreadSafety();
+   const Int_t blockSize = 16;
+   std::atomic<Int_t> nextBlock(0);
+   std::vector<std::thread> threads;
+   for (ithread = 0; ithread < nThreads; ithread++) {
+      threads.push_back(std::thread([&, ithread]() {
+         std::vector<AliRsnMiniOutput *> &defs = outputs[ithread];
+         std::vector<std::vector<AliRsnMiniOutput *> > shared(nDefs);
+         for (Int_t jdef = 0; jdef < nDefs; jdef++)
+            for (UInt_t k = 0; k < pairLoopIndices[jdef].size(); k++)
+               if (defs[pairLoopIndices[jdef][k]]) shared[jdef].push_back(defs[pairLoopIndices[jdef][k]]);
+         Int_t first, ievt, jdef;
+         while ((first = nextBlock.fetch_add(blockSize)) < nEvents) {
+            for (ievt = first; ievt < TMath::Min(first + blockSize, nEvents); ievt++) {
+               AliRsnMiniEvent *evMain = fEvStore[ievt];
+               for (UInt_t ipartner = 0; ipartner < matched[ievt].size(); ipartner++) {
+                  AliRsnMiniEvent *evMix = fEvStore[matched[ievt][ipartner]];
+                  for (jdef = 0; jdef < nDefs; jdef++) {
+                     if (!defs[jdef] || pairLoopShared[jdef]) continue;
+                     defs[jdef]->FillPair(evMain, evMix, &fValues, kTRUE, &shared[jdef]);
+                     if (!defs[jdef]->IsSymmetric())
+                        defs[jdef]->FillPair(evMix, evMain, &fValues, kFALSE, &shared[jdef]);
+                  }
+               }
+            }
+         }
+      }));
+   }
+   for (ithread = 0; ithread < nThreads; ithread++) threads[ithread].join();
+
+   // add the private copies to the outputs
+   for (ithread = 0; ithread < nThreads; ithread++) {
+      for (idef = 0; idef < nDefs; idef++) {
+         if (!outputs[ithread][idef]) continue;
+         TObject *obj = ((AliRsnMiniOutput *)fHistograms[idef])->GetOutputObject();
+         TObject *copy = outputs[ithread][idef]->GetOutputObject();
+         if (obj->InheritsFrom(TH1::Class()))
+            ((TH1 *)obj)->Add((TH1 *)copy);
+         else if (obj->InheritsFrom(THnBase::Class()))
+            ((THnBase *)obj)->Add((THnBase *)copy);
+         delete outputs[ithread][idef];
+      }
+      delete lists[ithread];
+   }
+}
+
 //---------------------------------------------------------------------
 Double_t AliRsnMiniAnalysisTask::ApplyCentralityPatchPbPb2011(){
   //This part rejects randomly events such that the centrality gets flat for LHC11h Pb-Pb data
@@ -12,6 +12,7 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 //
 
+#include <vector>
 #include <TString.h>
 #include <TClonesArray.h>
 
@@ -24,6 +25,7 @@
 #include "AliRsnCutPrimaryVertex.h"
 
 class TList;
+class TStopwatch;
 
 class AliTriggerAnalysis;
 class AliRsnMiniEvent;
@@ -59,6 +61,8 @@ public:
    void                SetMaxDiffAngle(Double_t val)      {fMaxDiffAngle = val;}
    void                SetEventCuts(AliRsnCutSet *cuts)   {fEventCuts    = cuts;}
    void                SetMixPrintRefresh(Int_t n)        {fMixPrintRefresh = n;}
+   void                SetMixInMemory(Bool_t b = kTRUE)   {fMixInMemory = b;}
+   void                SetMixNThreads(Int_t n = 1)        {fMixNThreads = n;}
    void                SetCheckDecay(Bool_t checkDecay = kTRUE) {fCheckDecay = checkDecay;}
    void                SetMaxNDaughters(Short_t n)        {fMaxNDaughters = n;}
    void                SetCheckMomentumConservation(Bool_t checkP) {fCheckP = checkP;}
@@ -100,6 +104,13 @@ private:
    void     FillTrueMotherAOD(AliRsnMiniEvent *event);
    void     StoreTrueMother(AliRsnMiniPair *pair, AliRsnMiniEvent *event);
    Bool_t   EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2);
+   Bool_t   EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const;
+   void     FindMixingPartners(std::vector<std::vector<Int_t> > &matched, Int_t printNum, TStopwatch &timer) const;
+   AliRsnMiniEvent *GetBufferedEvent(Int_t ievt);
+   void     ClearEventStore();
+   Bool_t   IsMixingThreadSafe();
+   void     FillMixingParallel(const std::vector<std::vector<Int_t> > &matched, const std::vector<Bool_t> &pairLoopShared,
+                               const std::vector<std::vector<Int_t> > &pairLoopIndices, Int_t nThreads);
    AliQnCorrectionsQnVector * GetQnVectorFromList(const TList *list,
                                                         const char *subdetector,
                                                         const char *expectedstep) const;
@@ -141,8 +152,14 @@ private:
    AliTriggerAnalysis  *fTriggerAna;      //! trigger analysis
    AliESDtrackCuts     *fESDtrackCuts;    //! quality cut for ESD tracks
    AliRsnMiniEvent     *fMiniEvent;       //! mini-event cursor
+   std::vector<AliRsnMiniEvent *> fEvStore; //! mini-events kept in memory, instead of fEvBuffer
+   std::vector<Float_t> fEvBufferVz;      //! mixing --> vz of the buffered mini-events
+   std::vector<Float_t> fEvBufferMult;    //! mixing --> multiplicity of the buffered mini-events
+   std::vector<Float_t> fEvBufferAngle;   //! mixing --> reaction plane angle of the buffered mini-events
    Bool_t               fBigOutput;       // flag if open file for output list
    Int_t                fMixPrintRefresh; // how often info in mixing part is printed
+   Bool_t               fMixInMemory;     // mixing --> keep the mini-events in memory instead of the buffer tree (off by default: all mini-events of the job stay in RAM)
+   Int_t                fMixNThreads;     // mixing --> threads for the mixed-pair filling (0: number of cores), needs fMixInMemory
    Bool_t               fCheckDecay;      // check if the mother decayed via the requested channel
    Short_t              fMaxNDaughters;   // maximum number of allowed mother's daughter
    Bool_t               fCheckP;          // flag to set in order to check the momentum conservation for mothers
@@ -156,7 +173,7 @@ private:
    Float_t              fMotherAcceptanceCutMaxEta;             // cut value to apply when selecting the mothers inside a defined acceptance
    Bool_t               fKeepMotherInAcceptance;                // flag to keep also mothers in acceptance
 
-   ClassDef(AliRsnMiniAnalysisTask, 13);   // AliRsnMiniAnalysisTask
+   ClassDef(AliRsnMiniAnalysisTask, 15);   // AliRsnMiniAnalysisTask
 };
 
 
@@ -44,6 +44,8 @@ AliRsnMiniOutput::AliRsnMiniOutput() :
    fComputed(0),
    fPair(),
    fList(0x0),
+   fOutputObject(0x0),
+   fOutputDim(-1),
    fSel1(0),
    fSel2(0),
    fMaxNSisters(-1),
@@ -77,6 +79,8 @@ AliRsnMiniOutput::AliRsnMiniOutput(const char *name, EOutputType type, EComputat
    fComputed(0),
    fPair(),
    fList(0x0),
+   fOutputObject(0x0),
+   fOutputDim(-1),
    fSel1(0),
    fSel2(0),
    fMaxNSisters(-1),
@@ -110,6 +114,8 @@ AliRsnMiniOutput::AliRsnMiniOutput(const char *name, const char *outType, const
    fComputed(0),
    fPair(),
    fList(0x0),
+   fOutputObject(0x0),
+   fOutputDim(-1),
    fSel1(0),
    fSel2(0),
    fMaxNSisters(-1),
@@ -192,15 +198,17 @@ AliRsnMiniOutput::AliRsnMiniOutput(const AliRsnMiniOutput &copy) :
    fComputed(copy.fComputed),
    fPair(),
    fList(copy.fList),
+   fOutputObject(0x0),
+   fOutputDim(-1),
    fSel1(0),
    fSel2(0),
-   fMaxNSisters(-1),
-   fCheckP(kFALSE),
-   fCheckFeedDown(kFALSE),
-   fOriginDselection(kFALSE),
-   fKeepDfromB(kFALSE),
-   fKeepDfromBOnly(kFALSE),
-   fRejectIfNoQuark(kFALSE),
+   fMaxNSisters(copy.fMaxNSisters),
+   fCheckP(copy.fCheckP),
+   fCheckFeedDown(copy.fCheckFeedDown),
+   fOriginDselection(copy.fOriginDselection),
+   fKeepDfromB(copy.fKeepDfromB),
+   fKeepDfromBOnly(copy.fKeepDfromBOnly),
+   fRejectIfNoQuark(copy.fRejectIfNoQuark),
    fCheckHistRange(copy.fCheckHistRange)
 {
 //
@@ -232,6 +240,8 @@ AliRsnMiniOutput &AliRsnMiniOutput::operator=(const AliRsnMiniOutput &copy)
    fAxes = copy.fAxes;
    fComputed = copy.fComputed;
    fList = copy.fList;
+   fOutputObject = 0x0;
+   fOutputDim = -1;
 
    Int_t i;
    for (i = 0; i < 2; i++) {
@@ -246,7 +256,7 @@ AliRsnMiniOutput &AliRsnMiniOutput::operator=(const AliRsnMiniOutput &copy)
    fCheckP = copy.fCheckP;
    fCheckFeedDown = copy.fCheckFeedDown;
    fOriginDselection = copy.fOriginDselection;
-   fKeepDfromB = copy.fOriginDselection;
+   fKeepDfromB = copy.fKeepDfromB;
    fKeepDfromBOnly = copy.fKeepDfromBOnly;
    fRejectIfNoQuark = copy.fRejectIfNoQuark;
    fCheckHistRange = copy.fCheckHistRange;
@@ -301,6 +311,8 @@ Bool_t AliRsnMiniOutput::Init(const char *prefix, TList *list)
    }
 
    fList = list;
+   fOutputObject = 0x0;
+   fOutputDim = -1;
    Int_t size = fAxes.GetEntries();
    if (size < 1) {
       AliWarning(Form("[%s] Cannot initialize histogram with less than 1 axis", GetName()));
@@ -474,13 +486,16 @@ Bool_t AliRsnMiniOutput::FillMotherInAcceptance(const AliRsnMiniPair *pair, AliR
 }
 
 //________________________________________________________________________________________
-Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst)
+Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst,
+                                 const std::vector<AliRsnMiniOutput *> *sharedOutputs)
 {
 //
 // Loops on the passed mini-event, and for each pair of particles
 // which satisfy the charge and cut requirements defined here, add an entry.
 // Returns the number of successful fillings.
-// Last argument tells if the reference event for event-based values is the first or the second.
+// Argument 'refFirst' tells if the reference event for event-based values is the first or the second.
+// The outputs in 'sharedOutputs', which must have the same pair loop as this one (see HasSamePairLoop),
+// are filled with the same pairs, so that the pairs are computed and selected only once.
 //
 
    // check computation type
@@ -498,6 +513,8 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
    // loop variables
    Int_t i1, i2, start, nadded = 0;
    AliRsnMiniParticle *p1, *p2;
+   UInt_t ishared, nshared = (sharedOutputs ? sharedOutputs->size() : 0);
+   AliRsnMiniEvent *refEvent = (refFirst ? event1 : event2);
 
    // it is necessary to know if criteria for the two daughters are the same
    // and if the two events are the same or not (mixing)
@@ -505,14 +522,16 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
    Bool_t sameCriteria = ((fCharge[0] == fCharge[1]) && (fDaughter[0] == fDaughter[1]));
    Bool_t sameEvent = (event1->ID() == event2->ID());
 
-   TString selList1  = "";
-   TString selList2  = "";
    Int_t   n1 = event1->CountParticles(fSel1, fCharge[0], fCutID[0]);
    Int_t   n2 = event2->CountParticles(fSel2, fCharge[1], fCutID[1]);
-   for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", fSel1[i1]));
-   for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", fSel2[i2]));
-   AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
-   AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   if (AliDebugLevelClass() >= 1) {
+      TString selList1  = "";
+      TString selList2  = "";
+      for (i1 = 0; i1 < n1; i1++) selList1.Append(Form("%d ", fSel1[i1]));
+      for (i2 = 0; i2 < n2; i2++) selList2.Append(Form("%d ", fSel2[i2]));
+      AliDebugClass(1, Form("[%10s] Part #1: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event1->ID(), fCharge[0], fCutID[0], n1, selList1.Data()));
+      AliDebugClass(1, Form("[%10s] Part #2: [%s] -- evID %6d -- charge = %c -- cut ID = %d --> %4d tracks (%s)", GetName(), (event1 == event2 ? "def" : "mix"), event2->ID(), fCharge[1], fCutID[1], n2, selList2.Data()));
+   }
    if (!n1 || !n2) {
       AliDebugClass(1, "No pairs to mix");
       return 0;
@@ -599,13 +618,73 @@ Int_t AliRsnMiniOutput::FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event
          }
          // get computed values & fill histogram
          nadded++;
-         if (refFirst) ComputeValues(event1, valueList); else ComputeValues(event2, valueList);
+         ComputeValues(refEvent, valueList);
          FillHistogram();
+         for (ishared = 0; ishared < nshared; ishared++) {
+            AliRsnMiniOutput *out = (*sharedOutputs)[ishared];
+            out->ComputeValues(refEvent, valueList, &fPair);
+            out->FillHistogram();
+         }
       } // end internal loop
    } // end external loop
 
    AliDebugClass(1, Form("Pairs added in total = %4d", nadded));
-   return nadded;
+   return nadded * (1 + nshared);
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniOutput::SetOutputList(TList *list, Int_t id)
+{
+//
+// Redirect the filling to the object in position 'id' of another list,
+// e.g. to a private copy of the output used by a separate thread.
+//
+
+   fList = list;
+   fOutputID = id;
+   fOutputObject = 0x0;
+   fOutputDim = -1;
+}
+
+//__________________________________________________________________________________________________
+TObject *AliRsnMiniOutput::GetOutputObject() const
+{
+//
+// Return the output object filled by this definition
+//
+
+   if (!fList) return 0x0;
+   return fList->At(fOutputID);
+}
+
+//__________________________________________________________________________________________________
+Bool_t AliRsnMiniOutput::HasSamePairLoop(const AliRsnMiniOutput *out) const
+{
+//
+// Returns true if the argument selects exactly the same pairs as this output, and computes
+// them in the same way, so that it can be filled from the pair loop of this one (see FillPair).
+// Only the axes and the histogram may differ.
+//
+
+   if (!out) return kFALSE;
+   if (fComputation != out->fComputation) return kFALSE;
+   if (fComputation != kTrackPair && fComputation != kTrackPairMix && fComputation != kTrackPairRotated1 &&
+       fComputation != kTrackPairRotated2 && fComputation != kTruePair) return kFALSE;
+   for (Int_t i = 0; i < 2; i++) {
+      if (fCutID[i] != out->fCutID[i]) return kFALSE;
+      if (fDaughter[i] != out->fDaughter[i]) return kFALSE;
+      if (fCharge[i] != out->fCharge[i]) return kFALSE;
+   }
+   if (fMotherPDG != out->fMotherPDG) return kFALSE;
+   if (fMotherMass != out->fMotherMass) return kFALSE;
+   if (fPairCuts != out->fPairCuts) return kFALSE;
+   if (fMaxNSisters != out->fMaxNSisters) return kFALSE;
+   if (fCheckP != out->fCheckP) return kFALSE;
+   if (fCheckFeedDown != out->fCheckFeedDown) return kFALSE;
+   if (fKeepDfromB != out->fKeepDfromB) return kFALSE;
+   if (fKeepDfromBOnly != out->fKeepDfromBOnly) return kFALSE;
+   if (fRejectIfNoQuark != out->fRejectIfNoQuark) return kFALSE;
+   return kTRUE;
 }
 //___________________________________________________________
 void AliRsnMiniOutput::SetDselection(UShort_t originDselection)
@@ -640,6 +719,16 @@ void AliRsnMiniOutput::ComputeValues(AliRsnMiniEvent *event, TClonesArray *value
 //
 // Using the arguments and the internal 'fPair' data member,
 // compute all values to be stored in the histogram
+//
+
+   ComputeValues(event, valueList, &fPair);
+}
+
+//__________________________________________________________________________________________________
+void AliRsnMiniOutput::ComputeValues(AliRsnMiniEvent *event, TClonesArray *valueList, AliRsnMiniPair *pair)
+{
+//
+// Compute all values to be stored in the histogram for the given pair
 //
 
    // check size of computed array
@@ -666,7 +755,7 @@ void AliRsnMiniOutput::ComputeValues(AliRsnMiniEvent *event, TClonesArray *value
          continue;
       }
       // if none of the above exit points is taken, compute value
-      fComputed[i] = val->Eval(&fPair, event);
+      fComputed[i] = val->Eval(pair, event);
    }
 }
 
@@ -679,20 +768,30 @@ void AliRsnMiniOutput::FillHistogram()
 // dimension of the initialized histogram itself.
 //
 
-   // retrieve object from list
-   if (!fList) {
-      AliError("List pointer is NULL");
-      return;
+   // retrieve object from list, only once
+   if (!fOutputObject) {
+      if (!fList) {
+         AliError("List pointer is NULL");
+         return;
+      }
+      fOutputObject = fList->At(fOutputID);
+      fOutputDim = -1;
+      if (fOutputObject) {
+         if (fOutputObject->InheritsFrom(TH1F::Class()))            fOutputDim = 1;
+         else if (fOutputObject->InheritsFrom(TH2F::Class()))       fOutputDim = 2;
+         else if (fOutputObject->InheritsFrom(TH3F::Class()))       fOutputDim = 3;
+         else if (fOutputObject->InheritsFrom(THnSparseF::Class())) fOutputDim = 0;
+      }
    }
-   TObject *obj = fList->At(fOutputID);
+   TObject *obj = fOutputObject;
 
-   if (obj->InheritsFrom(TH1F::Class())) {
+   if (fOutputDim == 1) {
       ((TH1F *)obj)->Fill(fComputed[0]);
-   } else if (obj->InheritsFrom(TH2F::Class())) {
+   } else if (fOutputDim == 2) {
       ((TH2F *)obj)->Fill(fComputed[0], fComputed[1]);
-   } else if (obj->InheritsFrom(TH3F::Class())) {
+   } else if (fOutputDim == 3) {
       ((TH3F *)obj)->Fill(fComputed[0], fComputed[1], fComputed[2]);
-   } else if (obj->InheritsFrom(THnSparseF::Class())) {
+   } else if (fOutputDim == 0) {
       THnSparseF *h = (THnSparseF *)obj;
       if (fCheckHistRange) {
          for (Int_t iAxis = 0; iAxis<h->GetNdimensions(); iAxis++) {
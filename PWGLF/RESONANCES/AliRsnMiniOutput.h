@@ -10,6 +10,8 @@
 // -- definition of output histogram
 //
 
+#include <vector>
+
 #include "AliRsnEvent.h"
 #include "AliRsnDaughter.h"
 #include "AliRsnMiniParticle.h"
@@ -77,6 +79,7 @@ public:
    Double_t        GetMotherMass()      const {return fMotherMass;}
    Bool_t          GetFillHistogramOnlyInRange() { return fCheckHistRange; }
    Short_t         GetMaxNSisters()           {return fMaxNSisters;}
+   AliRsnCutSet   *GetPairCuts()        const {return fPairCuts;}
 
    void            SetOutputType(EOutputType type)    {fOutputType = type;}
    void            SetComputation(EComputation src)   {fComputation = src;}
@@ -104,13 +107,18 @@ public:
    Bool_t          FillMother(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillMotherInAcceptance(const AliRsnMiniPair *pair, AliRsnMiniEvent *event, TClonesArray *valueList);
    Bool_t          FillEvent(AliRsnMiniEvent *event, TClonesArray *valueList);
-   Int_t           FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst = kTRUE);
+   Int_t           FillPair(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2, TClonesArray *valueList, Bool_t refFirst = kTRUE,
+                            const std::vector<AliRsnMiniOutput *> *sharedOutputs = 0);
+   Bool_t          HasSamePairLoop(const AliRsnMiniOutput *out) const;
+   void            SetOutputList(TList *list, Int_t id);
+   TObject        *GetOutputObject() const;
 
 private:
 
    void   CreateHistogram(const char *name);
    void   CreateHistogramSparse(const char *name);
    void   ComputeValues(AliRsnMiniEvent *event, TClonesArray *valueList);
+   void   ComputeValues(AliRsnMiniEvent *event, TClonesArray *valueList, AliRsnMiniPair *pair);
    void   FillHistogram();
 
    EOutputType      fOutputType;       //  type of output
@@ -127,6 +135,8 @@ private:
    TArrayD          fComputed;         //! temporary container for all computed values
    AliRsnMiniPair   fPair;             //! minipair for computations
    TList           *fList;             //! pointer to the TList containing the output
+   TObject         *fOutputObject;     //! output object in fList, found at the first filling
+   Int_t            fOutputDim;        //! dimension of fOutputObject (1-3 for TH1F-TH3F, 0 for THnSparseF, -1 if not found)
    TArrayI          fSel1;             //! list of selected particles for definition 1
    TArrayI          fSel2;             //! list of selected particles for definition 2
    Short_t          fMaxNSisters;      // maximum number of allowed mother's daughter
@@ -138,7 +148,7 @@ private:
    Bool_t 	    fRejectIfNoQuark;  // flag to remove events not generated with PYTHIA
    Bool_t           fCheckHistRange;   //  check if values is in histogram range
 
-   ClassDef(AliRsnMiniOutput, 5)  // AliRsnMiniOutput class
+   ClassDef(AliRsnMiniOutput, 6)  // AliRsnMiniOutput class
 };
 
 #endif
@@ -44,6 +44,7 @@
 #include "AliGenPythiaEventHeader.h"
 #include "AliGenCocktailEventHeader.h"
 #include "AliPID.h"
+#include "AliPIDResponseCache.h"
 #include "AliESDVertex.h"
 #include "AliESDEvent.h"
 #include "AliESDInputHandler.h"
@@ -1443,7 +1444,10 @@ void AliAnalysisTaskTOFSpectra::UserExec(Option_t *){
   AliAnalysisManager *AnManager = AliAnalysisManager::GetAnalysisManager();
   AliInputEventHandler* inputHandler = (AliInputEventHandler*) (AnManager->GetInputEventHandler());
   fPIDResponse = (AliPIDResponse*)inputHandler->GetPIDResponse();
-  if(fRecalibrateTOF) fPIDResponse->SetTOFResponse(fESD, AliPIDResponse::kBest_T0);
+  if(fRecalibrateTOF){
+    fPIDResponse->SetTOFResponse(fESD, AliPIDResponse::kBest_T0);
+    AliPIDResponseCache::Instance()->NewEvent(); // the TOF start time changed
+  }
   fTOFPIDResponse = fPIDResponse->GetTOFResponse();
   if(fRecalibrateTOF) fTOFPIDResponse.SetTimeResolution(fTimeResolution);
   
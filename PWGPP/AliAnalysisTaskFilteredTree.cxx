@@ -32,6 +32,18 @@
    3.) "Laser"      - dump laser tracks with space points if exests 
    4.) "CosmicTree" - cosmic track candidate (random or triggered) + esdTracks(up/down)+ optional points
    5.) "dEdx"       - tree with high dEdx tpc tracks
+
+   Output writing options (calibration skims):
+     SetDisabledBranches("friendTrack.,friendTrack0.,friendTrack1.") - friend track branches matching the patterns
+                                   are written empty from the first entry on (the schema is kept and all branches
+                                   have the entries of the tree), also settable via the environment variable
+                                   AliAnalysisTaskFilteredTree_fDisabledBranches before the first event
+     SetCompressionLevel(level)  - compression level of the output file
+     SetAutoFlush(n)             - auto flush (basket clustering) of the output trees
+     SetUseImplicitMT(kTRUE)     - baskets are compressed/flushed in ROOT implicit MT tasks (ROOT6 with IMT),
+                                   moving compression out of the event loop thread. Off by default: it enables
+                                   implicit MT for the whole process, i.e. also for the other tasks of the train
+   Output size per tree and the time spent in the Process* methods are printed in FinishTaskOutput.
 */
 
 #include "iostream"
@@ -50,6 +62,10 @@
 #include "TFile.h"
 #include "TMatrixD.h"
 #include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TRegexp.h"
+#include "TROOT.h"
+#include "RVersion.h"
 
 #include "AliHeader.h"  
 #include "AliGenEventHeader.h"  
@@ -134,6 +150,12 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fDisabledBranches("")
+  , fCompressionLevel(-1)
+  , fAutoFlush(0)
+  , fUseImplicitMT(kFALSE)
+  , fDisabledFriends(-1)
+  , fProcessTimer(0)
 {
   // Constructor
 
@@ -157,6 +179,7 @@ AliAnalysisTaskFilteredTree::~AliAnalysisTaskFilteredTree()
   delete fFilteredTreeAcceptanceCuts;
   delete fFilteredTreeRecAcceptanceCuts;
   delete fEsdTrackCuts;
+  delete fProcessTimer;
 }
 
 //____________________________________________________________________________
@@ -195,7 +218,8 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
 
   //
   //get the output file to make sure the trees will be associated to it
-  OpenFile(1);
+  TFile *outFile = OpenFile(1);
+  if (outFile && fCompressionLevel>=0) outFile->SetCompressionLevel(fCompressionLevel);
   fTreeSRedirector = new TTreeSRedirector();
 
   //
@@ -206,6 +230,22 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
   fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
   fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  TTree *outTrees[6]={fV0Tree,fHighPtTree,fdEdxTree,fLaserTree,fMCEffTree,fCosmicPairsTree};
+  for (Int_t itree=0; itree<6; itree++){
+    if (!outTrees[itree]) continue;
+    if (fAutoFlush!=0) outTrees[itree]->SetAutoFlush(fAutoFlush);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0) && defined(R__USE_IMT)
+    if (fUseImplicitMT) outTrees[itree]->SetImplicitMT(kTRUE);
+#endif
+  }
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0) && defined(R__USE_IMT)
+  if (fUseImplicitMT && !ROOT::IsImplicitMTEnabled()) ROOT::EnableImplicitMT();
+#else
+  if (fUseImplicitMT) AliWarning("Implicit MT not available in this ROOT version - baskets compressed in the event loop");
+#endif
+  fDisabledFriends=-1;
+  if (!fProcessTimer) fProcessTimer = new TStopwatch;
+  fProcessTimer->Reset();
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -358,9 +398,20 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     fFriendDownscaling=env.Atof();
     AliInfo(Form(" fFriendDownscaling=%f",fFriendDownscaling));
   }
+  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fDisabledBranches");
+  if (!env.IsNull() && env!=fDisabledBranches){
+    if (fDisabledFriends<0){
+      fDisabledBranches=env;
+      AliInfo(Form("fDisabledBranches=%s",fDisabledBranches.Data()));
+    }else{
+      AliWarning(Form("fDisabledBranches=%s ignored, the output trees are already being filled",env.Data()));
+    }
+  }
+  if (fDisabledFriends<0) ConfigureOutputTrees();
   //
   //
   //
+  if (fProcessTimer) fProcessTimer->Start(kFALSE);
   if(fProcessAll) { 
     ProcessAll(fESD,fMC,fESDfriend); // all track stages and MC
   }
@@ -374,9 +425,62 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
   if (fProcessCosmics) { ProcessCosmics(fESD,fESDfriend); }
   if(fMC) { ProcessMCEff(fESD,fMC,fESDfriend);}
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  if (fProcessTimer) fProcessTimer->Stop();
   printf("processed event %d\n", Int_t(Entry()));
 }
 
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::ConfigureOutputTrees()
+{
+  //
+  // Resolve the branch selection, done once before the first event is processed
+  // The selection can not be applied with TTree::SetBranchStatus: TTreeSRedirector creates the
+  // branches in the first Fill, and skipped branches would have less entries than the tree.
+  // The selected friend tracks are therefore streamed as NULL objects (as for the friend downscaling),
+  // the branches are kept, have an entry for every entry of the tree and hold no content.
+  //
+  const char *friendBranches[3]={"friendTrack.","friendTrack0.","friendTrack1."};
+  fDisabledFriends=0;
+  if (fDisabledBranches.IsNull()) return;
+  TObjArray *patterns = fDisabledBranches.Tokenize(", ");
+  for (Int_t ipattern=0; ipattern<patterns->GetEntriesFast(); ipattern++){
+    TString pattern = patterns->At(ipattern)->GetName();
+    TRegexp regexp(pattern,pattern.MaybeWildcard());
+    Bool_t found=kFALSE;
+    for (Int_t ibranch=0; ibranch<3; ibranch++){
+      TString branch=friendBranches[ibranch];
+      if (branch!=pattern && branch!=pattern+"." && !(pattern.MaybeWildcard() && branch.Index(regexp)==0)) continue;
+      fDisabledFriends|=(1<<ibranch);
+      found=kTRUE;
+      AliInfo(Form("branch %s written empty",friendBranches[ibranch]));
+    }
+    if (!found) AliWarning(Form("branch pattern %s ignored, only friend track branches can be disabled",pattern.Data()));
+  }
+  delete patterns;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::PrintWriteStatistics()
+{
+  //
+  // Print the output size of the output trees and the time spent in the Process* methods
+  //
+  TTree *outTrees[6]={fV0Tree,fHighPtTree,fdEdxTree,fLaserTree,fMCEffTree,fCosmicPairsTree};
+  Double_t processTime = (fProcessTimer) ? fProcessTimer->RealTime():0;
+  Double_t totBytes=0, zipBytes=0;
+  for (Int_t itree=0; itree<6; itree++){
+    if (!outTrees[itree]) continue;
+    totBytes+=outTrees[itree]->GetTotBytes();
+    zipBytes+=outTrees[itree]->GetZipBytes();
+    AliInfo(Form("Tree %-12s: entries=%lld\tsize=%.2f MB\tcompressed=%.2f MB",outTrees[itree]->GetName(),
+                 outTrees[itree]->GetEntries(),outTrees[itree]->GetTotBytes()/1e6,outTrees[itree]->GetZipBytes()/1e6));
+  }
+  // the basket compression and writing done in TTree::Fill is part of the Process* time,
+  // the last baskets are written when the trees are deleted
+  AliInfo(Form("Total: size=%.2f MB\tcompressed=%.2f MB\tProcess* time=%.2f s\t(%.2f MB/s of tree content)",
+               totBytes/1e6,zipBytes/1e6,processTime,(processTime>0)? totBytes/1e6/processTime:0.));
+}
+
 //_____________________________________________________________________________
 void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliESDfriend* esdFriend)
 {
@@ -504,6 +608,8 @@ void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliES
 	  }
 	}
       }
+      if (fDisabledFriends&kFriendTrack0) friendTrackStore0=0;
+      if (fDisabledFriends&kFriendTrack1) friendTrackStore1=0;
       if(!fFillTree) return;
       if(!fTreeSRedirector) return;
       (*fTreeSRedirector)<<"CosmicPairs"<<
@@ -764,6 +870,7 @@ void AliAnalysisTaskFilteredTree::ProcessLaser(AliESDEvent *const esdEvent, AliM
       Bool_t skipTrack=gRandom->Rndm()>1/(1+TMath::Abs(fFriendDownscaling));
       if (skipTrack) continue;
       if (esdFriend) {if (!esdFriend->TestSkipBit()) friendTrack = esdFriend->GetTrack(iTrack);} //this guy can be NULL      
+      if (fDisabledFriends&kFriendTrack) friendTrack=NULL;
       (*fTreeSRedirector)<<"Laser"<<
         "gid="<<gid<<                          // global identifier of event
         "fileName.="<<&fCurrentFileName<<              //
@@ -1378,6 +1485,7 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	    }
 	  }
 	}
+	if (fDisabledFriends&kFriendTrack) friendTrackStore=0;
 
 
 	//        if (!friendTrackStore && fFriendDownscaling<=1) {friendTrack=fDummyFriendTrack;}
@@ -1985,6 +2093,8 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
 	  }
 	}
       }
+      if (fDisabledFriends&kFriendTrack0) friendTrackStore0=0;
+      if (fDisabledFriends&kFriendTrack1) friendTrackStore1=0;
 
       //
       Bool_t isDownscaled = IsV0Downscaled(v0);
@@ -2177,6 +2287,7 @@ void AliAnalysisTaskFilteredTree::ProcessdEdx(AliESDEvent *const esdEvent, AliMC
         }
       }
 	
+      if (fDisabledFriends&kFriendTrack) friendTrack=NULL;
       downscaleCounter++;
       (*fTreeSRedirector)<<"dEdx"<<           // high dEdx tree
         "gid="<<gid<<                         // global id
@@ -2544,6 +2655,7 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
         AliAnalysisManager::kProofAnalysis)
       deleteTrees=kFALSE;
   }
+  if (fTreeSRedirector) PrintWriteStatistics();
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
 }
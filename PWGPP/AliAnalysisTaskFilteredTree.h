@@ -30,6 +30,7 @@ class TTree;
 class TTreeSRedirector;
 class TParticle;
 class TH3D;
+class TStopwatch;
 
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
@@ -117,7 +118,18 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Int_t   GetNearestTrackAtVertex(AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType);
   static void SetDefaultAliasesV0(TTree *treeV0);
   static void SetDefaultAliasesHighPt(TTree *treeV0);
+  //
+  // output tree writing options
+  void SetDisabledBranches(const char *branches) { fDisabledBranches = branches; }  // comma separated list of friend track branch patterns written empty (e.g "friendTrack.,friendTrack0.")
+  const char *GetDisabledBranches() const        { return fDisabledBranches.Data(); }
+  void SetCompressionLevel(Int_t level)          { fCompressionLevel = level; }
+  void SetAutoFlush(Long64_t autoFlush)          { fAutoFlush = autoFlush; }
+  void SetUseImplicitMT(Bool_t useIMT)           { fUseImplicitMT = useIMT; }  // opt-in (default off): calls ROOT::EnableImplicitMT(), which is process wide
  private:
+  void ConfigureOutputTrees();
+  void PrintWriteStatistics();
+
+  enum EFriendBranch { kFriendTrack=BIT(0), kFriendTrack0=BIT(1), kFriendTrack1=BIT(2) };
 
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
@@ -169,10 +181,16 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TH3D* fPtResCentPtTPCITS; //! sigma(pt)/pt vs Cent vs Pt for prim. TPC+ITS tracks
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
+  TString  fDisabledBranches;  // comma separated branch name patterns excluded from the output trees
+  Int_t    fCompressionLevel;  // compression level of the output file (-1 - keep default)
+  Long64_t fAutoFlush;         // auto flush setting of the output trees (0 - keep default)
+  Bool_t   fUseImplicitMT;     // flush/compress baskets of the output trees in ROOT implicit MT tasks
+  Int_t    fDisabledFriends;   //! bit mask of friend track branches written empty (EFriendBranch), -1 before the first event
+  TStopwatch* fProcessTimer;   //! time spent in the Process* methods (selection, filling and compression)
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
@@ -25,6 +25,7 @@
 #include "AliESDVertex.h"
 #include "AliEventplane.h"
 #include "AliAnalysisManager.h"
+#include "AliPIDResponseCache.h"
 #include "TRandom.h"
 
 
@@ -569,6 +570,7 @@ void AliAnalysisTaskK0sBayes::Analyze(AliAODEvent* aodEvent)
   PIDResponse->SetTOFResponse(aodEvent,AliPIDResponse::kTOF_T0);
 
   PIDResponse->GetTOFResponse().SetTOFtailAllPara(-23,1.1);
+  AliPIDResponseCache::Instance()->NewEvent(); // the TOF response changed
 
   fPIDCombined->SetDetectorMask(AliPIDResponse::kDetTPC|AliPIDResponse::kDetTOF);
 
@@ -25,6 +25,7 @@
 #include "AliESDVertex.h"
 #include "AliEventplane.h"
 #include "AliAnalysisManager.h"
+#include "AliPIDResponseCache.h"
 #include "TRandom.h"
 
 
@@ -560,6 +561,7 @@ void AliAnalysisTaskLambdaBayes::Analyze(AliAODEvent* aodEvent)
   AliPIDResponse *PIDResponse=inputHandler->GetPIDResponse();
   PIDResponse->SetTOFResponse(aodEvent,AliPIDResponse::kTOF_T0);
   PIDResponse->GetTOFResponse().SetTOFtailAllPara(-23,1.1);
+  AliPIDResponseCache::Instance()->NewEvent(); // the TOF response changed
 
 //   PIDResponse->GetTOFResponse().SetTrackParameter(0,0.);
 //   PIDResponse->GetTOFResponse().SetTrackParameter(1,0.);